@@ -0,0 +1,14 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// Destination change for one vehicle (GT -> PT). Only sent when the destination changes.
+struct FSWPAutopilotCommand
+{
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+	int32 Destination = INDEX_NONE;		// Road graph node; INDEX_NONE disengages the autopilot.
+	float CruiseSpeed = 0.0f;			// m/s
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPAutopilotCommand>, "FSWPAutopilotCommand must stay POD (memcpy'd).");
@@ -0,0 +1,86 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPSuspensionTuning.h"
+#include "SWPPowertrainPreset.h"
+
+/**
+ * One entry of the powertrain preset table shared by GT and PT (flyweight, see
+ * USWPPowertrainPreset). The torque curve is baked like the suspension curves and the aero
+ * coefficients are folded into force factors, so the PT only does arithmetic on it.
+ */
+struct FSWPPowertrainTuning
+{
+	static constexpr int32 MaxGears = 8;
+
+	float MaxTorque = 0.0f;
+	float IdleRPM = 0.0f;
+	float RedlineRPM = 0.0f;
+	float EngineBrakeTorque = 0.0f;
+	float TorqueTable[FSWPSuspensionTuning::NumCurveSamples] = {};		// Range: [0, RedlineRPM].
+	float TorqueInvStep = 0.0f;											// RPM -> torque table position.
+
+	int32 NumGears = 0;
+	float GearRatios[MaxGears] = {};
+	float ReverseRatio = 0.0f;
+	float FinalDriveRatio = 0.0f;
+	float Efficiency = 0.0f;
+	float UpshiftRPM = 0.0f;
+	float DownshiftRPM = 0.0f;
+
+	float MaxBrakeForce = 0.0f;
+
+	// 0.5 * rho * C * A: force (N) per (m/s)^2.
+	float DragFactor = 0.0f;
+	float DownforceFactor = 0.0f;
+
+	static FSWPPowertrainTuning Make(const USWPPowertrainPreset& Preset)
+	{
+		constexpr float HalfAirDensity = 0.5f * 1.225f;		// kg/m^3, sea level.
+		constexpr int32 NumSamples = FSWPSuspensionTuning::NumCurveSamples;
+
+		FSWPPowertrainTuning Tuning;
+		Tuning.MaxTorque = Preset.MaxTorque;
+		Tuning.RedlineRPM = FMath::Max(Preset.RedlineRPM, 1000.0f);
+		Tuning.IdleRPM = FMath::Clamp(Preset.IdleRPM, 0.0f, Tuning.RedlineRPM);
+		Tuning.EngineBrakeTorque = Preset.EngineBrakeTorque;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			const float RPM = Tuning.RedlineRPM * i / (NumSamples - 1);
+			Tuning.TorqueTable[i] = Preset.TorqueCurve ? Preset.TorqueCurve->GetFloatValue(RPM) : 1.0f;
+		}
+		Tuning.TorqueInvStep = (NumSamples - 1) / Tuning.RedlineRPM;
+
+		Tuning.NumGears = FMath::Min(Preset.GearRatios.Num(), MaxGears);
+		for (int32 i = 0; i < Tuning.NumGears; ++i)
+		{
+			Tuning.GearRatios[i] = Preset.GearRatios[i];
+		}
+		Tuning.ReverseRatio = Preset.ReverseRatio;
+		Tuning.FinalDriveRatio = Preset.FinalDriveRatio;
+		Tuning.Efficiency = Preset.Efficiency;
+		Tuning.UpshiftRPM = Preset.UpshiftRPM;
+		Tuning.DownshiftRPM = Preset.DownshiftRPM;
+
+		Tuning.MaxBrakeForce = Preset.MaxBrakeForce;
+
+		Tuning.DragFactor = HalfAirDensity * Preset.DragCoefficient * Preset.FrontalAreaM2;
+		Tuning.DownforceFactor = HalfAirDensity * Preset.DownforceCoefficient * Preset.FrontalAreaM2;
+		return Tuning;
+	}
+
+	// Plain floats/ints without padding, value-initialized: bytewise identity is value identity.
+	bool operator==(const FSWPPowertrainTuning& Other) const
+	{
+		return FMemory::Memcmp(this, &Other, sizeof(FSWPPowertrainTuning)) == 0;
+	}
+
+	friend uint32 GetTypeHash(const FSWPPowertrainTuning& Tuning)
+	{
+		return FCrc::MemCrc32(&Tuning, sizeof(FSWPPowertrainTuning));
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPPowertrainTuning>, "FSWPPowertrainTuning must stay POD (memcpy'd).");
+static_assert(sizeof(FSWPPowertrainTuning) % sizeof(float) == 0, "FSWPPowertrainTuning must stay padding-free (hashed bytewise).");
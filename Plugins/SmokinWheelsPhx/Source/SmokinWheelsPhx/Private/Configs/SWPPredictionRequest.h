@@ -0,0 +1,18 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "SWPVehicleControls.h"
+
+// Forward prediction of one vehicle (GT -> PT): NumSteps physics steps under fixed Controls, one pose every SampleEvery steps.
+struct FSWPPredictionRequest
+{
+	int32 RequestId = INDEX_NONE;
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+	FSWPVehicleControls Controls;
+	int32 NumSteps = 0;
+	int32 SampleEvery = 1;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPPredictionRequest>, "FSWPPredictionRequest must stay POD (memcpy'd).");
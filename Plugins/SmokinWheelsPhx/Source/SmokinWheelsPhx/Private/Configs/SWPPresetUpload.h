@@ -0,0 +1,11 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// One preset table entry sent to the PT: a new index, or a freed one reused for another tuning.
+template<typename TuningType>
+struct TSWPPresetUpload
+{
+	uint16 Index = 0;
+	TuningType Tuning;
+};
@@ -0,0 +1,105 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "SWPSensorDefinition.h"
+
+/**
+ * All sensors of a vehicle, as one entry of a table shared by GT and PT (flyweight: a fleet
+ * with the same sensor setup shares one index). Ray directions are derived on the PT from
+ * the mount axes and the yaw/pitch grid, so the rig stays small whatever the ray count.
+ */
+struct FSWPSensorRig
+{
+	static constexpr int32 MaxSensors = 8;
+	static constexpr int32 MaxRanges = 16384;		// Per vehicle, all sensors.
+	static constexpr uint16 NoHit = MAX_uint16;		// Range value of a ray that hit nothing.
+
+	struct FSensor
+	{
+		// Mount in chassis space (unit axes).
+		FVector3f Location = FVector3f::ZeroVector;
+		FVector3f Forward = FVector3f::ForwardVector;
+		FVector3f Right = FVector3f::RightVector;
+		FVector3f Up = FVector3f::UpVector;
+
+		float Range = 0.0f;			// cm
+		float Interval = 0.0f;		// s between scans (0 = every step).
+		float YawMin = 0.0f;		// rad
+		float YawStep = 0.0f;
+		float PitchMin = 0.0f;
+		float PitchStep = 0.0f;
+		int32 NumRays = 0;			// Per layer.
+		int32 NumLayers = 0;
+		int32 FirstRange = 0;		// Offset of this sensor in the vehicle's range buffer.
+
+		FORCEINLINE int32 NumRanges() const { return NumRays * NumLayers; }
+
+		// Chassis-space direction of ray RayIndex (layer-major).
+		FORCEINLINE FVector3f GetDirection(const int32 RayIndex) const
+		{
+			const int32 Layer = RayIndex / NumRays;
+			const int32 Ray = RayIndex - Layer * NumRays;
+
+			float SinYaw, CosYaw, SinPitch, CosPitch;
+			FMath::SinCos(&SinYaw, &CosYaw, YawMin + Ray * YawStep);
+			FMath::SinCos(&SinPitch, &CosPitch, PitchMin + Layer * PitchStep);
+			return Forward * (CosPitch * CosYaw) + Right * (CosPitch * SinYaw) + Up * SinPitch;
+		}
+	};
+
+	int32 NumSensors = 0;
+	int32 NumRanges = 0;
+	FSensor Sensors[MaxSensors] = {};
+
+	// Sensors past MaxSensors/MaxRanges are dropped (GT reads ranges with the same layout).
+	static FSWPSensorRig Make(const TArray<FSWPSensorDefinition>& Definitions)
+	{
+		FSWPSensorRig Rig;
+		for (const FSWPSensorDefinition& Definition : Definitions)
+		{
+			const int32 NumRanges = Definition.GetNumRanges();
+			if (Rig.NumSensors == MaxSensors || Rig.NumRanges + NumRanges > MaxRanges) break;
+
+			FSensor& Sensor = Rig.Sensors[Rig.NumSensors++];
+			const FQuat Rotation = Definition.AttachLocal.GetRotation().GetNormalized();
+			Sensor.Location = FVector3f(Definition.AttachLocal.GetLocation());
+			Sensor.Forward = FVector3f(Rotation.GetForwardVector());
+			Sensor.Right = FVector3f(Rotation.GetRightVector());
+			Sensor.Up = FVector3f(Rotation.GetUpVector());
+
+			Sensor.Range = FMath::Clamp(Definition.RangeCm, 1.0f, static_cast<float>(NoHit - 1));
+			Sensor.Interval = Definition.RateHz > 0.0f ? 1.0f / Definition.RateHz : 0.0f;
+			Sensor.NumRays = FMath::Clamp(Definition.NumRays, 1, FSWPSensorDefinition::MaxRaysPerLayer);
+			Sensor.NumLayers = FMath::Clamp(Definition.NumLayers, 1, FSWPSensorDefinition::MaxLayers);
+
+			// A full turn spaces rays by FOV / N (the last ray would repeat the first), a partial fan by FOV / (N - 1).
+			const float Fov = FMath::DegreesToRadians(FMath::Clamp(Definition.FieldOfView, 0.0f, 360.0f));
+			const int32 YawGaps = Fov >= UE_TWO_PI - UE_KINDA_SMALL_NUMBER ? Sensor.NumRays : Sensor.NumRays - 1;
+			Sensor.YawMin = -0.5f * Fov;
+			Sensor.YawStep = YawGaps > 0 ? Fov / YawGaps : 0.0f;
+
+			const float VerticalFov = FMath::DegreesToRadians(FMath::Clamp(Definition.VerticalFieldOfView, 0.0f, 180.0f));
+			Sensor.PitchMin = -0.5f * VerticalFov;
+			Sensor.PitchStep = Sensor.NumLayers > 1 ? VerticalFov / (Sensor.NumLayers - 1) : 0.0f;
+
+			Sensor.FirstRange = Rig.NumRanges;
+			Rig.NumRanges += NumRanges;
+		}
+		return Rig;
+	}
+
+	// Plain floats/ints without padding, value-initialized: bytewise identity is value identity.
+	bool operator==(const FSWPSensorRig& Other) const
+	{
+		return FMemory::Memcmp(this, &Other, sizeof(FSWPSensorRig)) == 0;
+	}
+
+	friend uint32 GetTypeHash(const FSWPSensorRig& Rig)
+	{
+		return FCrc::MemCrc32(&Rig, sizeof(FSWPSensorRig));
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPSensorRig>, "FSWPSensorRig must stay POD (memcpy'd).");
+static_assert(sizeof(FSWPSensorRig::FSensor) % sizeof(float) == 0, "FSWPSensorRig must stay padding-free (hashed bytewise).");
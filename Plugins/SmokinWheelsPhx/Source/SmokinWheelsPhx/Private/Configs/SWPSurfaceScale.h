@@ -0,0 +1,13 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// PT-side row of the surface table (indexed by EPhysicalSurface, SurfaceType_Max entries).
+struct FSWPSurfaceScale
+{
+	float Stiffness = 1.0f;
+	float Damping = 1.0f;
+	float Friction = 1.0f;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPSurfaceScale>, "FSWPSurfaceScale must stay POD (memcpy'd).");
@@ -2,15 +2,13 @@
 
 #pragma once
 
+#include "SWPSuspensionTuning.h"
+
 struct FSWPSuspensionConfig
 {
 	FTransform AttachLocal = FTransform();
+	float MaxSteerAngle = 0.0f;		// Radians at full steering input (0: not steered).
 
-	float TravelCm = 0.0f;
-	float SpringStiffness = 0.0f;
-	float ShockBump = 0.0f;
-	float ShockRebound = 0.0f;
-	float MaxForce = 0.0f;
-	
-	float WheelRadiusCm = 0.0f;
+	// Shared preset entry in the PT table (never null while stepping).
+	const FSWPSuspensionTuning* Tuning = nullptr;
 };
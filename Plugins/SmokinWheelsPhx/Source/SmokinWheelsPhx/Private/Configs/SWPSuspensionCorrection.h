@@ -0,0 +1,14 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// Authoritative compression ratios for one vehicle (GT -> PT, e.g. from fleet replication on a client).
+struct FSWPSuspensionCorrection
+{
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+	int32 FirstCompression = 0;		// Range in the input's compression array, one per wheel.
+	int32 NumWheels = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPSuspensionCorrection>, "FSWPSuspensionCorrection must stay POD (memcpy'd).");
@@ -0,0 +1,122 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Curves/CurveFloat.h"
+#include "SWPWheelDefinition.h"
+
+/**
+ * One entry of the preset table shared by GT and PT (flyweight).
+ * Authored values plus the constants the solver would otherwise derive per wheel per step.
+ * Spring/damper curves are baked on GT into uniformly sampled tables (linear when no curve is
+ * set), so the PT evaluates them with one clamped lerp and no UObject access.
+ */
+struct FSWPSuspensionTuning
+{
+	static constexpr int32 NumCurveSamples = 16;
+
+	float TravelCm = 0.0f;
+	float SpringStiffness = 0.0f;
+	float ShockBump = 0.0f;
+	float ShockRebound = 0.0f;
+	float MaxForce = 0.0f;
+	float WheelRadiusCm = 0.0f;
+	float DamperCurveMaxSpeed = 0.0f;
+
+	float TireFriction = 0.0f;
+	float TireCorneringStiffness = 0.0f;
+	float TireRollingResistance = 0.0f;
+
+	// Baked curves: sample i sits at X = i / (NumCurveSamples - 1) * range.
+	float SpringTable[NumCurveSamples] = {};		// Range: compression ratio [0,1].
+	float BumpTable[NumCurveSamples] = {};			// Range: [0, DamperCurveMaxSpeed].
+	float ReboundTable[NumCurveSamples] = {};
+
+	// Derived once at registration.
+	float TraceLength = 0.0f;		// TravelCm + WheelRadiusCm
+	float InvTraceLength = 0.0f;	// 1 / TraceLength (0 for a degenerate preset)
+	float DamperInvStep = 0.0f;		// Speed -> damper table position.
+
+	static constexpr float SpringInvStep = NumCurveSamples - 1;
+
+	/**
+	 * Branch-free table lookup (min/max + lerp). Past the last sample the last segment is
+	 * extrapolated, so a linear table stays exactly linear for any input.
+	 */
+	static FORCEINLINE float SampleTable(const float* Table, const float X, const float InvStep)
+	{
+		const float Position = FMath::Max(X * InvStep, 0.0f);
+		const int32 Index = FMath::Min(static_cast<int32>(Position), NumCurveSamples - 2);
+		return FMath::Lerp(Table[Index], Table[Index + 1], Position - Index);
+	}
+
+	// Effective tuning of a wheel (its preset asset when set, otherwise its own values).
+	static FSWPSuspensionTuning Make(const FSWPWheelDefinition& Wheel)
+	{
+		const FSWPWheelDefinition Resolved = Wheel.Resolve();
+
+		FSWPSuspensionTuning Tuning;
+		Tuning.TravelCm = Resolved.TravelCm;
+		Tuning.SpringStiffness = Resolved.SpringStiffness;
+		Tuning.ShockBump = Resolved.ShockBump;
+		Tuning.ShockRebound = Resolved.ShockRebound;
+		Tuning.MaxForce = Resolved.MaxForce;
+		Tuning.WheelRadiusCm = Resolved.WheelRadiusCm;
+		Tuning.DamperCurveMaxSpeed = FMath::Max(Resolved.DamperCurveMaxSpeed, 0.1f);
+		Tuning.TireFriction = Resolved.TireFriction;
+		Tuning.TireCorneringStiffness = Resolved.TireCorneringStiffness;
+		Tuning.TireRollingResistance = Resolved.TireRollingResistance;
+
+		BakeCurve(Resolved.SpringCurve, 1.0f, Tuning.SpringTable);
+		BakeCurve(Resolved.BumpCurve, Tuning.DamperCurveMaxSpeed, Tuning.BumpTable);
+		BakeCurve(Resolved.ReboundCurve, Tuning.DamperCurveMaxSpeed, Tuning.ReboundTable);
+		Tuning.DamperInvStep = (NumCurveSamples - 1) / Tuning.DamperCurveMaxSpeed;
+
+		Tuning.TraceLength = Tuning.TravelCm + Tuning.WheelRadiusCm;
+		Tuning.InvTraceLength = Tuning.TraceLength > UE_KINDA_SMALL_NUMBER ? 1.0f / Tuning.TraceLength : 0.0f;
+		return Tuning;
+	}
+
+	// Identity is the authored values and the baked tables (derived ones follow from them).
+	bool operator==(const FSWPSuspensionTuning& Other) const
+	{
+		return TravelCm == Other.TravelCm && SpringStiffness == Other.SpringStiffness
+			&& ShockBump == Other.ShockBump && ShockRebound == Other.ShockRebound
+			&& MaxForce == Other.MaxForce && WheelRadiusCm == Other.WheelRadiusCm
+			&& DamperCurveMaxSpeed == Other.DamperCurveMaxSpeed
+			&& TireFriction == Other.TireFriction && TireCorneringStiffness == Other.TireCorneringStiffness
+			&& TireRollingResistance == Other.TireRollingResistance
+			&& FMemory::Memcmp(SpringTable, Other.SpringTable, sizeof(SpringTable)) == 0
+			&& FMemory::Memcmp(BumpTable, Other.BumpTable, sizeof(BumpTable)) == 0
+			&& FMemory::Memcmp(ReboundTable, Other.ReboundTable, sizeof(ReboundTable)) == 0;
+	}
+
+	friend uint32 GetTypeHash(const FSWPSuspensionTuning& Tuning)
+	{
+		uint32 Hash = GetTypeHash(Tuning.TravelCm);
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.SpringStiffness));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.ShockBump));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.ShockRebound));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.MaxForce));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.WheelRadiusCm));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.TireFriction));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.TireCorneringStiffness));
+		Hash = HashCombineFast(Hash, GetTypeHash(Tuning.TireRollingResistance));
+		Hash = FCrc::MemCrc32(Tuning.SpringTable, sizeof(Tuning.SpringTable), Hash);
+		Hash = FCrc::MemCrc32(Tuning.BumpTable, sizeof(Tuning.BumpTable), Hash);
+		return FCrc::MemCrc32(Tuning.ReboundTable, sizeof(Tuning.ReboundTable), Hash);
+	}
+
+private:
+	// GT only: samples the curve over [0, Range]; no curve bakes the identity (linear model).
+	static void BakeCurve(const UCurveFloat* Curve, const float Range, float (&OutTable)[NumCurveSamples])
+	{
+		for (int32 i = 0; i < NumCurveSamples; ++i)
+		{
+			const float X = Range * i / (NumCurveSamples - 1);
+			OutTable[i] = Curve ? Curve->GetFloatValue(X) : X;
+		}
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPSuspensionTuning>, "FSWPSuspensionTuning must stay POD (memcpy'd).");
@@ -0,0 +1,13 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// Driver inputs of one vehicle as seen by the PT step.
+struct FSWPVehicleControls
+{
+	float Throttle = 0.0f;		// [-1, 1]. Negative requests reverse when (almost) stopped, brakes otherwise.
+	float Steering = 0.0f;		// [-1, 1], positive steers right (scaled by each wheel's MaxSteerAngle).
+	float Brake = 0.0f;			// [0, 1]
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPVehicleControls>, "FSWPVehicleControls must stay POD (memcpy'd).");
@@ -0,0 +1,108 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "SWPContactMode.h"
+#include "SWPSuspensionConfig.h"
+#include "SWPWheelDefinition.h"
+
+/**
+ * GT → PT wire format.
+ *
+ * Plain, trivially copyable records (no FGuid, no UObject pointers, no doubles): the input
+ * packet is two flat arrays (vehicles + wheels) filled with one memcpy each. Vehicles are
+ * addressed by PT slot index + generation; the GT maps slots back to FGuids.
+ */
+
+// PT slot handle. Generation changes every time the slot is reused (0 = never valid).
+struct FSWPVehicleSlot
+{
+	int32 Index = INDEX_NONE;
+	uint32 Generation = 0;
+};
+
+struct FSWPVehiclePacket
+{
+	// Wheel counts up to this value are stored inline on PT (no heap allocation per vehicle per step).
+	static constexpr int32 NumInlineWheels = 8;
+	static constexpr uint16 NoPowertrain = MAX_uint16;
+	static constexpr uint16 NoSensors = MAX_uint16;
+
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+	int32 PhysicsIdx = INDEX_NONE;		// Chaos::FUniqueIdx::Idx of the chassis particle.
+	uint32 IgnoreActorId = 0;			// AActor::GetUniqueID() ignored by wheel traces (0 = none).
+	int32 FirstWheel = 0;				// Range in the packet's wheel array.
+	int32 NumWheels = 0;
+	ESWPContactMode ContactMode = ESWPContactMode::Ray;
+	uint16 PowertrainIndex = NoPowertrain;	// See FSWPPowertrainRegistry (NoPowertrain: coasting, no aero).
+	uint16 SensorRigIndex = NoSensors;		// See FSWPSensorRigRegistry.
+};
+
+// One wheel, 24 bytes. Local offsets in float; tuning is an index into the PT preset table.
+struct FSWPWheelPacket
+{
+	enum EFlags : uint8
+	{
+		Driven = 1 << 0,
+	};
+
+	FVector3f AttachLocation = FVector3f::ZeroVector;
+	int16 AttachRotation[4] = { 0, 0, 0, MAX_int16 };	// Unit quaternion (x, y, z, w) in [-1, 1].
+
+	uint16 PresetIndex = 0;			// See FSWPPresetRegistry (uploaded before first use).
+	uint8 Flags = 0;
+	int8 MaxSteerAngle = 0;			// Whole degrees in [-90, 90] (FSWPWheelDefinition::MaxSteerAngle is authored in whole degrees).
+
+	static FSWPWheelPacket Pack(const FSWPWheelDefinition& Wheel, const uint16 PresetIndex)
+	{
+		// Out-of-range wheel data would be saturated by the quantization below: report it instead of hiding it.
+		ensureMsgf(FMath::Abs(Wheel.MaxSteerAngle) <= 90.0f, TEXT("SWP wheel '%s': MaxSteerAngle %f is outside [-90, 90] and is clamped."),
+				   *Wheel.Name.ToString(), Wheel.MaxSteerAngle);
+		ensureMsgf(FMath::IsNearlyEqual(Wheel.MaxSteerAngle, FMath::RoundToFloat(Wheel.MaxSteerAngle), 0.01f),
+				   TEXT("SWP wheel '%s': MaxSteerAngle %f is not a whole number of degrees and is rounded."), *Wheel.Name.ToString(), Wheel.MaxSteerAngle);
+		ensureMsgf(Wheel.AttachLocal.GetRotation().IsNormalized(), TEXT("SWP wheel '%s': attach rotation is not normalized."), *Wheel.Name.ToString());
+
+		FSWPWheelPacket Packet;
+		Packet.AttachLocation = FVector3f(Wheel.AttachLocal.GetLocation());
+
+		const FQuat Rotation = Wheel.AttachLocal.GetRotation().GetNormalized();
+		Packet.AttachRotation[0] = QuantizeUnit(Rotation.X);
+		Packet.AttachRotation[1] = QuantizeUnit(Rotation.Y);
+		Packet.AttachRotation[2] = QuantizeUnit(Rotation.Z);
+		Packet.AttachRotation[3] = QuantizeUnit(Rotation.W);
+
+		Packet.PresetIndex = PresetIndex;
+		Packet.Flags = Wheel.bDriven ? Driven : 0;
+		Packet.MaxSteerAngle = static_cast<int8>(FMath::Clamp(FMath::RoundToInt32(Wheel.MaxSteerAngle), -90, 90));
+		return Packet;
+	}
+
+	FORCEINLINE bool IsDriven() const { return (Flags & Driven) != 0; }
+
+	// PT: expand into the solver-facing config (stack local, per step). Tuning is referenced, not copied.
+	FORCEINLINE FSWPSuspensionConfig Unpack(const FSWPSuspensionTuning* Presets) const
+	{
+		constexpr float InvUnit = 1.0f / MAX_int16;
+
+		FSWPSuspensionConfig Config;
+		const FQuat Rotation(AttachRotation[0] * InvUnit, AttachRotation[1] * InvUnit,
+							 AttachRotation[2] * InvUnit, AttachRotation[3] * InvUnit);
+		Config.AttachLocal = FTransform(Rotation.GetNormalized(), FVector(AttachLocation));
+		Config.MaxSteerAngle = FMath::DegreesToRadians(static_cast<float>(MaxSteerAngle));
+		Config.Tuning = &Presets[PresetIndex];
+		return Config;
+	}
+
+private:
+	static FORCEINLINE int16 QuantizeUnit(const double Value)
+	{
+		ensureMsgf(FMath::Abs(Value) <= 1.0 + UE_KINDA_SMALL_NUMBER, TEXT("SWP wheel packet: unit value %f out of range."), Value);
+		return static_cast<int16>(FMath::RoundToInt32(FMath::Clamp(Value, -1.0, 1.0) * MAX_int16));
+	}
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPVehicleSlot>, "FSWPVehicleSlot must stay POD (memcpy'd).");
+static_assert(std::is_trivially_copyable_v<FSWPVehiclePacket>, "FSWPVehiclePacket must stay POD (memcpy'd).");
+static_assert(std::is_trivially_copyable_v<FSWPWheelPacket>, "FSWPWheelPacket must stay POD (memcpy'd).");
+static_assert(sizeof(FSWPWheelPacket) == 24, "FSWPWheelPacket is expected to be 24 bytes.");
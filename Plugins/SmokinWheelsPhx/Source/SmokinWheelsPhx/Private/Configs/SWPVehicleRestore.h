@@ -0,0 +1,32 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "SWPVehicleControls.h"
+
+// State a vehicle carries from one step to the next, chassis included: captured into fleet snapshots
+// (PT -> GT) and loaded back onto a slot (GT -> PT). Compressions are a range of a separate float array.
+struct FSWPVehicleRestore
+{
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+
+	double Location[3] = {};
+	float Rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };		// Quaternion (x, y, z, w).
+	float LinearVelocity[3] = {};						// cm/s
+	float AngularVelocity[3] = {};						// rad/s
+
+	FSWPVehicleControls Controls;
+	int32 Gear = 1;
+
+	// Autopilot (the route is re-planned from the destination, the controller memory is kept).
+	int32 Destination = INDEX_NONE;
+	float CruiseSpeed = 0.0f;
+	float SpeedIntegral = 0.0f;
+	float PrevSpeedError = 0.0f;
+
+	int32 FirstCompression = 0;
+	int32 NumWheels = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPVehicleRestore>, "FSWPVehicleRestore must stay POD (memcpy'd).");
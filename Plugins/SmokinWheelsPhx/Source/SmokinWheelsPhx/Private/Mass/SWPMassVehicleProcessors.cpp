@@ -0,0 +1,147 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "Mass/SWPMassVehicleProcessors.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "SWPAsyncPhysicsManager.h"
+#include "SWPPhysicsUtility.h"
+#include "SWPStat.h"
+#include "Mass/SWPMassFragments.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+// Show with 'stat SmokinWheelsPhx' in the UE console
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:MassVehicleSync"), STAT_SmokinWheelsPhx_MassVehicleSync, STATGROUP_SmokinWheelsPhx);
+
+namespace SWPMass
+{
+	static FSWPAsyncPhysicsManager* GetPhysicsManager(const UWorld* World)
+	{
+		return World ? FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(World->GetPhysicsScene()) : nullptr;
+	}
+}
+
+//----------------------------------------------------------------------//
+// USWPMassVehicleInitializer
+//----------------------------------------------------------------------//
+USWPMassVehicleInitializer::USWPMassVehicleInitializer()
+	: EntityQuery(*this)
+{
+	ObservedType = FSWPMassVehicleFragment::StaticStruct();
+	Operation = EMassObservedOperation::Add;
+	bRequiresGameThreadExecution = true;		// Physics scene + manager are GT-only.
+}
+
+void USWPMassVehicleInitializer::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FSWPMassVehicleFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddConstSharedRequirement<FSWPMassVehicleParamsFragment>(EMassFragmentPresence::All);
+}
+
+void USWPMassVehicleInitializer::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UWorld* World = EntityManager.GetWorld();
+	FSWPAsyncPhysicsManager* PhysManager = SWPMass::GetPhysicsManager(World);
+	if (!PhysManager) return;
+
+	FPhysScene* PhysScene = World->GetPhysicsScene();
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [PhysManager, PhysScene](FMassExecutionContext& Ctx)
+	{
+		const FSWPMassVehicleParamsFragment& Params = Ctx.GetConstSharedFragment<FSWPMassVehicleParamsFragment>();
+		const TArrayView<FSWPMassVehicleFragment> Vehicles = Ctx.GetMutableFragmentView<FSWPMassVehicleFragment>();
+		const TConstArrayView<FTransformFragment> Transforms = Ctx.GetFragmentView<FTransformFragment>();
+
+		for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+		{
+			FSWPMassVehicleFragment& Vehicle = Vehicles[i];
+
+			Vehicle.PhysicsHandle = FSWPPhysicsUtility::CreateChassisParticle(PhysScene, Transforms[i].GetTransform(),
+				Params.ChassisHalfExtents, Params.VehicleMass);
+			if (!Vehicle.PhysicsHandle) continue;
+
+			Vehicle.Guid = PhysManager->AddExternalVehicle(Vehicle.PhysicsHandle->GetGameThreadAPI().UniqueIdx(), Params.Wheels, Params.ContactMode,
+														   Params.Powertrain);
+		}
+	});
+}
+
+//----------------------------------------------------------------------//
+// USWPMassVehicleDeinitializer
+//----------------------------------------------------------------------//
+USWPMassVehicleDeinitializer::USWPMassVehicleDeinitializer()
+	: EntityQuery(*this)
+{
+	ObservedType = FSWPMassVehicleFragment::StaticStruct();
+	Operation = EMassObservedOperation::Remove;
+	bRequiresGameThreadExecution = true;
+}
+
+void USWPMassVehicleDeinitializer::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FSWPMassVehicleFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USWPMassVehicleDeinitializer::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UWorld* World = EntityManager.GetWorld();
+	FSWPAsyncPhysicsManager* PhysManager = SWPMass::GetPhysicsManager(World);
+	FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [PhysManager, PhysScene](FMassExecutionContext& Ctx)
+	{
+		const TArrayView<FSWPMassVehicleFragment> Vehicles = Ctx.GetMutableFragmentView<FSWPMassVehicleFragment>();
+
+		for (FSWPMassVehicleFragment& Vehicle : Vehicles)
+		{
+			if (PhysManager && Vehicle.Guid.IsValid())
+			{
+				PhysManager->RemoveExternalVehicle(Vehicle.Guid);
+			}
+			Vehicle.Guid.Invalidate();
+
+			FSWPPhysicsUtility::ReleaseChassisParticle(PhysScene, Vehicle.PhysicsHandle);
+		}
+	});
+}
+
+//----------------------------------------------------------------------//
+// USWPMassVehicleSyncProcessor
+//----------------------------------------------------------------------//
+USWPMassVehicleSyncProcessor::USWPMassVehicleSyncProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::UpdateWorldFromMass;
+	bRequiresGameThreadExecution = true;		// Reads the manager's latest output (GT-owned).
+}
+
+void USWPMassVehicleSyncProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FSWPMassVehicleFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+}
+
+void USWPMassVehicleSyncProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_MassVehicleSync);
+
+	const FSWPAsyncPhysicsManager* PhysManager = SWPMass::GetPhysicsManager(EntityManager.GetWorld());
+	if (!PhysManager) return;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [PhysManager](FMassExecutionContext& Ctx)
+	{
+		const TConstArrayView<FSWPMassVehicleFragment> Vehicles = Ctx.GetFragmentView<FSWPMassVehicleFragment>();
+		const TArrayView<FTransformFragment> Transforms = Ctx.GetMutableFragmentView<FTransformFragment>();
+
+		for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+		{
+			// Entities not yet simulated (admitted next step) simply keep their spawn transform.
+			if (const FSWPVehicleOut* VehicleOut = PhysManager->FindLatestVehicleOut(Vehicles[i].Guid))
+			{
+				Transforms[i].SetTransform(VehicleOut->ChassisTransform);
+			}
+		}
+	});
+}
@@ -0,0 +1,61 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "Mass/SWPMassVehicleSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "SWPAsyncPhysicsManager.h"
+#include "SWPPhysicsUtility.h"
+#include "SWPVehicle.h"
+#include "Mass/SWPMassFragments.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+ASWPVehicle* USWPMassVehicleSubsystem::PromoteToActor(const FMassEntityHandle Entity, TSubclassOf<ASWPVehicle> VehicleClass)
+{
+	UWorld* World = GetWorld();
+	if (!World || !IsValid(VehicleClass)) return nullptr;
+
+	UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+	if (!EntitySubsystem) return nullptr;
+
+	FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+	if (!EntityManager.IsEntityValid(Entity)) return nullptr;
+
+	FSWPMassVehicleFragment* Vehicle = EntityManager.GetFragmentDataPtr<FSWPMassVehicleFragment>(Entity);
+	const FTransformFragment* Transform = EntityManager.GetFragmentDataPtr<FTransformFragment>(Entity);
+	if (!Vehicle || !Transform) return nullptr;
+
+	// Carry over momentum so the hand-off is seamless.
+	FVector LinearVelocity = FVector::ZeroVector;
+	FVector AngularVelocity = FVector::ZeroVector;
+	if (Vehicle->PhysicsHandle)
+	{
+		const Chaos::FRigidBodyHandle_External& Body = Vehicle->PhysicsHandle->GetGameThreadAPI();
+		LinearVelocity = Body.V();
+		AngularVelocity = Body.W();
+	}
+
+	// Release the PT vehicle and its particle now, so the actor does not spawn into our own chassis.
+	if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(World->GetPhysicsScene()))
+	{
+		PhysManager->RemoveExternalVehicle(Vehicle->Guid);
+	}
+	Vehicle->Guid.Invalidate();
+	FSWPPhysicsUtility::ReleaseChassisParticle(World->GetPhysicsScene(), Vehicle->PhysicsHandle);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ASWPVehicle* NewVehicle = World->SpawnActor<ASWPVehicle>(VehicleClass, Transform->GetTransform(), SpawnParameters);
+	if (!NewVehicle) return nullptr;
+
+	if (UPrimitiveComponent* Body = Cast<UPrimitiveComponent>(NewVehicle->GetRootComponent()))
+	{
+		Body->SetPhysicsLinearVelocity(LinearVelocity);
+		Body->SetPhysicsAngularVelocityInRadians(AngularVelocity);
+	}
+
+	// Deferred: the deinitializer finds nothing left to release.
+	EntityManager.Defer().DestroyEntity(Entity);
+
+	return NewVehicle;
+}
@@ -0,0 +1,18 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "Mass/SWPMassVehicleTrait.h"
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+
+void USWPMassVehicleTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+	BuildContext.AddFragment<FSWPMassVehicleFragment>();
+	BuildContext.AddFragment<FTransformFragment>();
+
+	// Deduplicated by content: all entities with identical tuning share one instance.
+	const FConstSharedStruct ParamsFragment = EntityManager.GetOrCreateConstSharedFragment(Params);
+	BuildContext.AddConstSharedFragment(ParamsFragment);
+}
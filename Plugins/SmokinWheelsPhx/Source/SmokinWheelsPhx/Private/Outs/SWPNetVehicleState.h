@@ -0,0 +1,156 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPVehiclePacket.h"
+#include "States/SWPSuspensionState.h"
+
+/**
+ * FSWPNetVehicleState
+ *
+ * Replicated vehicle state, quantized on the PT (fleet replication, see ASWPFleetReplicator):
+ *  - chassis position in 1/8 cm, rotation as "smallest three" (largest component dropped),
+ *  - linear velocity in cm/s, angular velocity in mrad/s,
+ *  - one byte of compression ratio per wheel.
+ * Integer fields only, so the PT compares it against the previous step for the per-field dirty
+ * bits and the wire delta-codes it against acknowledged baselines without float drift.
+ */
+struct FSWPNetVehicleState
+{
+	// Per-field dirty bits (PT output) and field mask (wire).
+	enum EField : uint8
+	{
+		Pose = 1 << 0,
+		Velocity = 1 << 1,
+		Wheels = 1 << 2,
+		AllFields = Pose | Velocity | Wheels,
+	};
+	static constexpr int32 NumFields = 3;
+
+	static constexpr double PositionScale = 8.0;
+	static constexpr double RotationScale = MAX_int16 * 1.41421356237;		// Smallest three are within ±1/sqrt(2).
+	static constexpr double LinearVelocityScale = 1.0;
+	static constexpr double AngularVelocityScale = 1000.0;
+	static constexpr float CompressionScale = MAX_uint8;
+
+	bool bValid = false;
+	uint8 LargestComponent = 3;		// Quaternion component (X, Y, Z, W) rebuilt from the other three.
+	int32 Position[3] = {};
+	int16 Rotation[3] = {};
+	int16 LinearVelocity[3] = {};
+	int16 AngularVelocity[3] = {};
+	TArray<uint8, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Compressions;
+
+	template<typename SuspensionAllocator>
+	static FSWPNetVehicleState Make(const FTransform& ChassisTransform, const FVector& InLinearVelocity, const FVector& InAngularVelocity,
+									const TArray<FSWPSuspensionState, SuspensionAllocator>& Suspensions)
+	{
+		FSWPNetVehicleState State;
+		State.bValid = true;
+
+		const FVector Location = ChassisTransform.GetLocation();
+		for (int32 a = 0; a < 3; ++a)
+		{
+			State.Position[a] = QuantizeInt32(Location[a] * PositionScale);
+			State.LinearVelocity[a] = QuantizeInt16(InLinearVelocity[a] * LinearVelocityScale);
+			State.AngularVelocity[a] = QuantizeInt16(InAngularVelocity[a] * AngularVelocityScale);
+		}
+
+		// q and -q are the same rotation: flip so the dropped component is positive.
+		const FQuat Rotation = ChassisTransform.GetRotation().GetNormalized();
+		const double Components[4] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+		for (int32 c = 0; c < 4; ++c)
+		{
+			if (FMath::Abs(Components[c]) > FMath::Abs(Components[State.LargestComponent]))
+			{
+				State.LargestComponent = static_cast<uint8>(c);
+			}
+		}
+		const double Sign = Components[State.LargestComponent] < 0.0 ? -1.0 : 1.0;
+		for (int32 c = 0, k = 0; c < 4; ++c)
+		{
+			if (c != State.LargestComponent)
+			{
+				State.Rotation[k++] = QuantizeInt16(Components[c] * Sign * RotationScale);
+			}
+		}
+
+		State.Compressions.SetNumUninitialized(Suspensions.Num());
+		for (int32 w = 0; w < Suspensions.Num(); ++w)
+		{
+			State.Compressions[w] = static_cast<uint8>(FMath::RoundToInt32(FMath::Clamp(Suspensions[w].PreviousCompressionRatio, 0.0f, 1.0f) * CompressionScale));
+		}
+		return State;
+	}
+
+	// Fields that differ from Other (every field when Other was never quantized).
+	uint8 Compare(const FSWPNetVehicleState& Other) const
+	{
+		if (!Other.bValid) return AllFields;
+
+		uint8 Fields = 0;
+		if (LargestComponent != Other.LargestComponent || FMemory::Memcmp(Position, Other.Position, sizeof(Position)) != 0
+			|| FMemory::Memcmp(Rotation, Other.Rotation, sizeof(Rotation)) != 0)
+		{
+			Fields |= Pose;
+		}
+		if (FMemory::Memcmp(LinearVelocity, Other.LinearVelocity, sizeof(LinearVelocity)) != 0
+			|| FMemory::Memcmp(AngularVelocity, Other.AngularVelocity, sizeof(AngularVelocity)) != 0)
+		{
+			Fields |= Velocity;
+		}
+		if (Compressions != Other.Compressions)
+		{
+			Fields |= Wheels;
+		}
+		return Fields;
+	}
+
+	FORCEINLINE FVector GetLocation() const
+	{
+		return FVector(Position[0], Position[1], Position[2]) / PositionScale;
+	}
+
+	FTransform GetTransform() const
+	{
+		double Components[4];
+		double SumSquares = 0.0;
+		for (int32 c = 0, k = 0; c < 4; ++c)
+		{
+			if (c == LargestComponent) continue;
+
+			Components[c] = Rotation[k++] / RotationScale;
+			SumSquares += Components[c] * Components[c];
+		}
+		Components[LargestComponent] = FMath::Sqrt(FMath::Max(1.0 - SumSquares, 0.0));
+
+		const FQuat Quat = FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+		return FTransform(Quat, GetLocation());
+	}
+
+	FORCEINLINE FVector GetLinearVelocity() const
+	{
+		return FVector(LinearVelocity[0], LinearVelocity[1], LinearVelocity[2]) / LinearVelocityScale;
+	}
+
+	FORCEINLINE FVector GetAngularVelocity() const
+	{
+		return FVector(AngularVelocity[0], AngularVelocity[1], AngularVelocity[2]) / AngularVelocityScale;
+	}
+
+	FORCEINLINE float GetCompression(const int32 Wheel) const
+	{
+		return Compressions[Wheel] / CompressionScale;
+	}
+
+private:
+	static FORCEINLINE int32 QuantizeInt32(const double Value)
+	{
+		return static_cast<int32>(FMath::Clamp(FMath::RoundToDouble(Value), static_cast<double>(MIN_int32), static_cast<double>(MAX_int32)));
+	}
+
+	static FORCEINLINE int16 QuantizeInt16(const double Value)
+	{
+		return static_cast<int16>(FMath::Clamp(FMath::RoundToDouble(Value), static_cast<double>(MIN_int16), static_cast<double>(MAX_int16)));
+	}
+};
@@ -0,0 +1,11 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// Result of one prediction request: its poses in the output's shared pose buffer (none when the vehicle was not simulated).
+struct FSWPPredictionOut
+{
+	int32 RequestId = INDEX_NONE;
+	int32 FirstPose = 0;
+	int32 NumPoses = 0;
+};
@@ -0,0 +1,16 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPVehiclePacket.h"
+
+// One sensor scanned this step: its ranges at [FirstRange, FirstRange + NumRanges) of the vehicle's rig
+// (NumRigRanges in total), values in the output's shared range buffer from FirstValue.
+struct FSWPSensorRangesOut
+{
+	FSWPVehicleSlot Slot;
+	int32 NumRigRanges = 0;
+	int32 FirstRange = 0;
+	int32 NumRanges = 0;
+	int32 FirstValue = 0;
+};
@@ -2,11 +2,36 @@
 
 #pragma once
 
+#include "Configs/SWPVehicleControls.h"
+#include "Configs/SWPVehiclePacket.h"
 #include "Debug/SWPDebugDrawCommand.h"
+#include "Outs/SWPNetVehicleState.h"
 
 struct FSWPVehicleOut
 {
-	FGuid Guid;
+	// PT slot of the vehicle (the GT maps it back to its FGuid, checking the generation).
+	FSWPVehicleSlot Slot;
+
+	// Chassis pose sampled by the PT at the start of the step (consumed by actor-less vehicles).
+	FTransform ChassisTransform = FTransform::Identity;
+	// World-space wheel hub poses (one per wheel, suspension compression applied). Used by visuals.
+	TArray<FTransform, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> WheelTransforms;
+
+	// Powertrain state (0 without a powertrain). Used by HUD/audio.
+	float EngineRPM = 0.0f;
+	int32 Gear = 0;
+
+	// Nearest vehicles within swp.NeighborRadius, nearest first (empty unless swp.PublishNeighbors > 0).
+	static constexpr int32 MaxNeighbors = 8;
+	TArray<FSWPVehicleSlot, TInlineAllocator<MaxNeighbors>> Neighbors;
+
+	// Quantized replication state and the fields that changed since the previous step (fleet replicator or hibernation only).
+	FSWPNetVehicleState NetState;
+	uint8 NetDirty = 0;
+	// Inputs carried to the next step (fleet replicator or hibernation only): controls and autopilot target (INDEX_NONE: off).
+	FSWPVehicleControls Controls;
+	int32 AutopilotDestination = INDEX_NONE;
+	float AutopilotCruiseSpeed = 0.0f;		// m/s
 
 	static constexpr int32 MaxDebugPerVehicle = 64;
 	TArray<FSWPDebugDrawCommand, TInlineAllocator<MaxDebugPerVehicle>> DebugDrawCommands;
@@ -0,0 +1,70 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include <atomic>
+#include "Configs/SWPVehicleControls.h"
+
+// One driver input change for one vehicle (GT -> PT).
+struct FSWPControlSample
+{
+	int32 Slot = INDEX_NONE;
+	uint32 Generation = 0;
+	int32 Timestamp = 0;		// GT input frame it belongs to: applies from the first step consuming that input.
+	uint32 PushedAtStep = 0;	// PT step count seen by the GT when pushed (latency instrumentation).
+	FSWPVehicleControls Controls;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPControlSample>, "FSWPControlSample must stay POD (memcpy'd).");
+
+/**
+ * FSWPControlChannel
+ *
+ * Lock-free single-producer (GT) / single-consumer (PT) ring of control samples, separate
+ * from the per-step input snapshot: a vehicle costs bandwidth only when its inputs change,
+ * and the PT sees a sample as soon as it is pushed instead of with the next built packet.
+ * Samples are FIFO and their timestamps never decrease.
+ */
+class FSWPControlChannel
+{
+public:
+	static constexpr uint32 Capacity = 4096;		// Power of two.
+
+	FSWPControlChannel()
+	{
+		Samples.SetNumUninitialized(Capacity);
+	}
+
+	// GT only. False when full (the caller keeps the sample and retries).
+	bool Push(const FSWPControlSample& Sample)
+	{
+		const uint32 Head = WriteIndex.load(std::memory_order_relaxed);
+		if (Head - ReadIndex.load(std::memory_order_acquire) == Capacity) return false;
+
+		Samples[Head & (Capacity - 1)] = Sample;
+		WriteIndex.store(Head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// PT only: oldest unconsumed sample, or nullptr.
+	const FSWPControlSample* Peek() const
+	{
+		const uint32 Tail = ReadIndex.load(std::memory_order_relaxed);
+		if (Tail == WriteIndex.load(std::memory_order_acquire)) return nullptr;
+
+		return &Samples[Tail & (Capacity - 1)];
+	}
+
+	// PT only: releases the sample returned by Peek().
+	void Pop()
+	{
+		ReadIndex.store(ReadIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+private:
+	TArray<FSWPControlSample> Samples;
+
+	// Each index is written by one side only: keep them on separate cache lines.
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WriteIndex { 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadIndex { 0 };
+};
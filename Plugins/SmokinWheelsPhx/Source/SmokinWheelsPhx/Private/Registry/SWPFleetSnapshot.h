@@ -0,0 +1,243 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Chaos/ParticleHandle.h"
+#include "Configs/SWPPowertrainTuning.h"
+#include "Configs/SWPSensorRig.h"
+#include "Configs/SWPSuspensionTuning.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Configs/SWPVehicleRestore.h"
+#include "States/SWPVehicleState.h"
+
+// One vehicle of a fleet snapshot: its wire-format config and the state it carries over.
+struct FSWPSnapshotVehicle
+{
+	// FirstWheel: range in the snapshot's wheel/compression sections. Preset indices: the snapshot's tables.
+	// PhysicsIdx and IgnoreActorId belong to the capturing session (restored vehicles keep their own).
+	FSWPVehiclePacket Packet;
+	// Slot/Generation as captured; FirstCompression == Packet.FirstWheel.
+	FSWPVehicleRestore State;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPSnapshotVehicle>, "FSWPSnapshotVehicle must stay POD (memcpy'd).");
+
+/**
+ * FSWPFleetSnapshot
+ *
+ * Flat, versioned image of a whole fleet: a header, then one aligned section per record array,
+ * every record written as it is laid out in memory (POD only, same byte order). Sections:
+ *  - vehicles (packet + chassis pose/velocities, compressions, gear, controls, autopilot),
+ *  - wheel packets and compression ratios, indexed by each vehicle's FirstWheel,
+ *  - the suspension presets, powertrain presets and sensor rigs the packets index into.
+ * A loaded or memory-mapped file is used in place: Init() validates the header and every index
+ * once, the getters are views into the blob. The PT captures the vehicles (Capture(), parallel,
+ * into ranges laid out by the step's wheel prefix sum), the GT adds its preset tables (Write()).
+ *
+ * Header record sizes guard against layout changes that forgot the version bump, and the byte
+ * order marker against loading a blob written by a host of the other endianness. Records are
+ * copied with whatever padding bytes their source had: compare snapshots by record, not by bytes.
+ */
+struct FSWPFleetSnapshot
+{
+	// Vehicles per parallel task of the capture pass.
+	static constexpr int32 BatchSize = 256;
+
+	static constexpr uint32 Magic = 0x53505753;		// "SWPS"
+	static constexpr uint32 Version = 2;
+	static constexpr uint32 ByteOrderMark = 0x01020304;	// Reads 0x04030201 on a host of the other byte order.
+	static constexpr uint32 Alignment = 16;
+
+	enum ESection : uint8
+	{
+		Vehicles,
+		Wheels,
+		Compressions,
+		Presets,
+		PowertrainPresets,
+		SensorRigs,
+		NumSections
+	};
+
+	struct FSection
+	{
+		uint32 Offset = 0;		// Bytes from the start of the blob (multiple of Alignment).
+		uint32 Num = 0;
+	};
+
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 ByteOrder = 0;
+		uint32 Version = 0;
+		uint32 Size = 0;			// Whole blob, bytes.
+		uint32 Step = 0;			// PT step the vehicles were captured at.
+		uint32 RecordSizes[NumSections] = {};
+		FSection Sections[NumSections];
+	};
+
+	static constexpr uint32 RecordSizes[NumSections] =
+	{
+		sizeof(FSWPSnapshotVehicle), sizeof(FSWPWheelPacket), sizeof(float),
+		sizeof(FSWPSuspensionTuning), sizeof(FSWPPowertrainTuning), sizeof(FSWPSensorRig)
+	};
+
+	// PT, per vehicle (parallel): state as of the start of the step. FirstWheel is the vehicle's slice of OutWheels/OutCompressions.
+	static void Capture(const FSWPVehiclePacket& Packet, const FSWPWheelPacket* WheelPackets, const Chaos::FPBDRigidParticleHandle* Chassis,
+						const FSWPVehicleState& VehicleSimState, const int32 FirstWheel,
+						FSWPSnapshotVehicle& OutVehicle, FSWPWheelPacket* OutWheels, float* OutCompressions)
+	{
+		// Zeroed first, then filled field by field: the record's own padding bytes are zero.
+		FMemory::Memzero(OutVehicle);
+		OutVehicle.Packet = Packet;
+		OutVehicle.Packet.FirstWheel = FirstWheel;
+
+		FSWPVehicleRestore& State = OutVehicle.State;
+		State.Slot = Packet.Slot;
+		State.Generation = Packet.Generation;
+
+		const Chaos::FVec3 Location = Chassis->GetX();
+		const Chaos::FRotation3 Rotation = Chassis->GetR();
+		const Chaos::FVec3 LinearVelocity = Chassis->GetV();
+		const Chaos::FVec3 AngularVelocity = Chassis->GetW();
+		for (int32 a = 0; a < 3; ++a)
+		{
+			State.Location[a] = Location[a];
+			State.LinearVelocity[a] = static_cast<float>(LinearVelocity[a]);
+			State.AngularVelocity[a] = static_cast<float>(AngularVelocity[a]);
+		}
+		State.Rotation[0] = static_cast<float>(Rotation.X);
+		State.Rotation[1] = static_cast<float>(Rotation.Y);
+		State.Rotation[2] = static_cast<float>(Rotation.Z);
+		State.Rotation[3] = static_cast<float>(Rotation.W);
+
+		State.Controls = VehicleSimState.Controls;
+		State.Gear = VehicleSimState.Gear;
+		State.Destination = VehicleSimState.Autopilot.Destination;
+		State.CruiseSpeed = VehicleSimState.Autopilot.CruiseSpeed;
+		State.SpeedIntegral = VehicleSimState.Autopilot.SpeedIntegral;
+		State.PrevSpeedError = VehicleSimState.Autopilot.PrevSpeedError;
+		State.FirstCompression = FirstWheel;
+		State.NumWheels = Packet.NumWheels;
+
+		FMemory::Memcpy(OutWheels + FirstWheel, WheelPackets + Packet.FirstWheel, Packet.NumWheels * sizeof(FSWPWheelPacket));
+
+		// A vehicle admitted this step has no suspension state yet: uncompressed.
+		for (int32 w = 0; w < Packet.NumWheels; ++w)
+		{
+			OutCompressions[FirstWheel + w] = VehicleSimState.Suspensions.IsValidIndex(w) ? VehicleSimState.Suspensions[w].PreviousCompressionRatio : 0.0f;
+		}
+	}
+
+	// GT: the whole blob (OutData keeps its capacity; the gaps between sections are zeroed).
+	static void Write(const uint32 Step, const TConstArrayView<FSWPSnapshotVehicle> InVehicles, const TConstArrayView<FSWPWheelPacket> InWheels,
+					  const TConstArrayView<float> InCompressions, const TConstArrayView<FSWPSuspensionTuning> InPresets,
+					  const TConstArrayView<FSWPPowertrainTuning> InPowertrainPresets, const TConstArrayView<FSWPSensorRig> InSensorRigs,
+					  TArray<uint8>& OutData)
+	{
+		const void* SectionData[NumSections] =
+		{
+			InVehicles.GetData(), InWheels.GetData(), InCompressions.GetData(),
+			InPresets.GetData(), InPowertrainPresets.GetData(), InSensorRigs.GetData()
+		};
+		const int32 SectionNums[NumSections] =
+		{
+			InVehicles.Num(), InWheels.Num(), InCompressions.Num(),
+			InPresets.Num(), InPowertrainPresets.Num(), InSensorRigs.Num()
+		};
+
+		FHeader Header;
+		Header.Magic = Magic;
+		Header.ByteOrder = ByteOrderMark;
+		Header.Version = Version;
+		Header.Step = Step;
+
+		uint32 Offset = Align(static_cast<uint32>(sizeof(FHeader)), Alignment);
+		for (int32 s = 0; s < NumSections; ++s)
+		{
+			Header.RecordSizes[s] = RecordSizes[s];
+			Header.Sections[s].Offset = Offset;
+			Header.Sections[s].Num = SectionNums[s];
+			Offset = Align(Offset + SectionNums[s] * RecordSizes[s], Alignment);
+		}
+		Header.Size = Offset;
+
+		OutData.Reset();
+		OutData.SetNumZeroed(Header.Size, EAllowShrinking::No);
+		FMemory::Memcpy(OutData.GetData(), &Header, sizeof(FHeader));
+		for (int32 s = 0; s < NumSections; ++s)
+		{
+			if (SectionNums[s] == 0) continue;
+
+			FMemory::Memcpy(OutData.GetData() + Header.Sections[s].Offset, SectionData[s], SectionNums[s] * RecordSizes[s]);
+		}
+	}
+
+	// Validates InData (header, section bounds, every range and index) and reads it in place. InData must outlive the getters.
+	bool Init(const TConstArrayView<uint8> InData)
+	{
+		Data = nullptr;
+		if (InData.Num() < static_cast<int32>(sizeof(FHeader)) || !IsAligned(InData.GetData(), Alignment)) return false;
+
+		const FHeader& InHeader = *reinterpret_cast<const FHeader*>(InData.GetData());
+		if (InHeader.Magic != Magic || InHeader.ByteOrder != ByteOrderMark) return false;
+		if (InHeader.Version != Version || InHeader.Size > static_cast<uint32>(InData.Num())) return false;
+
+		for (int32 s = 0; s < NumSections; ++s)
+		{
+			const FSection& Section = InHeader.Sections[s];
+			if (InHeader.RecordSizes[s] != RecordSizes[s] || Section.Offset % Alignment != 0) return false;
+			if (static_cast<uint64>(Section.Offset) + static_cast<uint64>(Section.Num) * RecordSizes[s] > InHeader.Size) return false;
+		}
+
+		const FSection* Sections = InHeader.Sections;
+		if (Sections[Wheels].Num != Sections[Compressions].Num) return false;
+
+		const FSWPSnapshotVehicle* InVehicles = reinterpret_cast<const FSWPSnapshotVehicle*>(InData.GetData() + Sections[Vehicles].Offset);
+		const FSWPWheelPacket* InWheels = reinterpret_cast<const FSWPWheelPacket*>(InData.GetData() + Sections[Wheels].Offset);
+		for (uint32 v = 0; v < Sections[Vehicles].Num; ++v)
+		{
+			const FSWPVehiclePacket& Packet = InVehicles[v].Packet;
+			if (Packet.FirstWheel < 0 || Packet.NumWheels < 0 || static_cast<int64>(Packet.FirstWheel) + Packet.NumWheels > Sections[Wheels].Num) return false;
+			if (InVehicles[v].State.FirstCompression != Packet.FirstWheel || InVehicles[v].State.NumWheels != Packet.NumWheels) return false;
+			if (Packet.PowertrainIndex != FSWPVehiclePacket::NoPowertrain && Packet.PowertrainIndex >= Sections[PowertrainPresets].Num) return false;
+			if (Packet.SensorRigIndex != FSWPVehiclePacket::NoSensors && Packet.SensorRigIndex >= Sections[SensorRigs].Num) return false;
+		}
+		for (uint32 w = 0; w < Sections[Wheels].Num; ++w)
+		{
+			if (InWheels[w].PresetIndex >= Sections[Presets].Num) return false;
+		}
+
+		Data = InData.GetData();
+		return true;
+	}
+
+	FORCEINLINE bool IsValid() const { return Data != nullptr; }
+	FORCEINLINE uint32 GetStep() const { return GetHeader().Step; }
+
+	FORCEINLINE TConstArrayView<FSWPSnapshotVehicle> GetVehicles() const { return GetSection<FSWPSnapshotVehicle>(Vehicles); }
+	FORCEINLINE TConstArrayView<FSWPWheelPacket> GetWheels() const { return GetSection<FSWPWheelPacket>(Wheels); }
+	FORCEINLINE TConstArrayView<float> GetCompressions() const { return GetSection<float>(Compressions); }
+	FORCEINLINE TConstArrayView<FSWPSuspensionTuning> GetPresets() const { return GetSection<FSWPSuspensionTuning>(Presets); }
+	FORCEINLINE TConstArrayView<FSWPPowertrainTuning> GetPowertrainPresets() const { return GetSection<FSWPPowertrainTuning>(PowertrainPresets); }
+	FORCEINLINE TConstArrayView<FSWPSensorRig> GetSensorRigs() const { return GetSection<FSWPSensorRig>(SensorRigs); }
+
+private:
+	FORCEINLINE const FHeader& GetHeader() const
+	{
+		return *reinterpret_cast<const FHeader*>(Data);
+	}
+
+	template<typename RecordType>
+	FORCEINLINE TConstArrayView<RecordType> GetSection(const ESection Section) const
+	{
+		const FSection& Entry = GetHeader().Sections[Section];
+		return TConstArrayView<RecordType>(reinterpret_cast<const RecordType*>(Data + Entry.Offset), Entry.Num);
+	}
+
+	const uint8* Data = nullptr;
+};
+
+static_assert(std::is_trivially_copyable_v<FSWPFleetSnapshot::FHeader>, "FSWPFleetSnapshot::FHeader must stay POD (memcpy'd).");
+static_assert(alignof(FSWPSnapshotVehicle) <= FSWPFleetSnapshot::Alignment && alignof(FSWPSensorRig) <= FSWPFleetSnapshot::Alignment,
+			  "Snapshot records must fit the section alignment.");
@@ -0,0 +1,147 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPPowertrainTuning.h"
+#include "Configs/SWPPresetUpload.h"
+#include "Configs/SWPSensorRig.h"
+#include "Configs/SWPSuspensionTuning.h"
+
+/**
+ * TSWPPresetRegistry (GT side)
+ *
+ * Interns tunings by value: every wheel with the same effective tuning (same preset asset, or
+ * identical inline values) shares one index. Entries are immutable while referenced, so editing
+ * a wheel never touches a shared entry: it interns its new values instead (copy-on-write).
+ *
+ * Entries are reference counted (one reference per packet in the mirror or in a queued edit).
+ * An unreferenced entry is retired, then its index is reused once no published packet can still
+ * point at it (ReuseDelay uploads later). New and reused entries are uploaded to the PT by index.
+ */
+template<typename TuningType, int32 InMaxPresets = MAX_uint16 + 1>
+struct TSWPPresetRegistry
+{
+	// Wire format stores the index in 16 bits.
+	static constexpr int32 MaxPresets = InMaxPresets;
+	// Uploads between the last release of an entry and the reuse of its index: the input published
+	// when the release is applied still carries packets built before it.
+	static constexpr uint32 ReuseDelay = 2;
+
+	// Index of the tuning with one more reference, INDEX_NONE when the table is full (the caller keeps its previous tuning).
+	int32 Intern(const TuningType& Tuning)
+	{
+		if (const uint16* Found = TuningToIndex.Find(Tuning))
+		{
+			++RefCounts[*Found];
+			return *Found;
+		}
+
+		if (!FreeIndices.IsEmpty())
+		{
+			const uint16 Index = FreeIndices.Pop(EAllowShrinking::No);
+			Presets[Index] = Tuning;
+			RefCounts[Index] = 1;
+			TuningToIndex.Add(Tuning, Index);
+			if (Index < NumUploaded)
+			{
+				DirtyIndices.Add(Index);
+			}
+			return Index;
+		}
+
+		if (!ensureMsgf(Presets.Num() < MaxPresets, TEXT("SWP preset table is full (%d entries in use)."), MaxPresets))
+		{
+			return INDEX_NONE;
+		}
+
+		const uint16 Index = static_cast<uint16>(Presets.Add(Tuning));
+		RefCounts.Add(1);
+		RetiredAt.Add(0);
+		bRetired.Add(false);
+		TuningToIndex.Add(Tuning, Index);
+		return Index;
+	}
+
+	FORCEINLINE void AddRef(const uint16 Index) { ++RefCounts[Index]; }
+
+	void Release(const uint16 Index)
+	{
+		check(RefCounts[Index] > 0);
+		if (--RefCounts[Index] > 0) return;
+
+		// Stays internable (and revivable) until its index is handed out again.
+		RetiredAt[Index] = NumCollects;
+		if (!bRetired[Index])
+		{
+			bRetired[Index] = true;
+			RetiredIndices.Add(Index);
+		}
+	}
+
+	// Appends the entries the PT has not seen yet (call once per published input).
+	void CollectUploads(TArray<TSWPPresetUpload<TuningType>>& OutUploads)
+	{
+		for (const uint16 Index : DirtyIndices)
+		{
+			OutUploads.Add({ Index, Presets[Index] });
+		}
+		DirtyIndices.Reset();
+
+		for (int32 Index = NumUploaded; Index < Presets.Num(); ++Index)
+		{
+			OutUploads.Add({ static_cast<uint16>(Index), Presets[Index] });
+		}
+		NumUploaded = Presets.Num();
+
+		++NumCollects;
+		FreeRetired();
+	}
+
+	// A new PT callback starts with an empty table: send everything again.
+	void ResetUploads()
+	{
+		NumUploaded = 0;
+		DirtyIndices.Reset();
+	}
+
+	FORCEINLINE int32 Num() const { return Presets.Num(); }
+	FORCEINLINE TConstArrayView<TuningType> GetPresets() const { return Presets; }
+
+private:
+	void FreeRetired()
+	{
+		for (int32 i = RetiredIndices.Num() - 1; i >= 0; --i)
+		{
+			const uint16 Index = RetiredIndices[i];
+			if (RefCounts[Index] == 0 && NumCollects - RetiredAt[Index] < ReuseDelay) continue;
+
+			// Revived entries just leave the list.
+			if (RefCounts[Index] == 0)
+			{
+				TuningToIndex.Remove(Presets[Index]);
+				FreeIndices.Add(Index);
+			}
+			bRetired[Index] = false;
+			RetiredIndices.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+
+	TArray<TuningType> Presets;
+	TArray<int32> RefCounts;
+	TArray<uint32> RetiredAt;			// Upload count at the last release.
+	TBitArray<> bRetired;
+	TMap<TuningType, uint16> TuningToIndex;
+	TArray<uint16> RetiredIndices;
+	TArray<uint16> FreeIndices;
+	TArray<uint16> DirtyIndices;		// Reused indices already uploaded once (re-sent with their new tuning).
+	int32 NumUploaded = 0;
+	uint32 NumCollects = 0;
+};
+
+using FSWPPresetRegistry = TSWPPresetRegistry<FSWPSuspensionTuning>;
+
+// Last index is reserved for "no powertrain" (FSWPVehiclePacket::NoPowertrain).
+using FSWPPowertrainRegistry = TSWPPresetRegistry<FSWPPowertrainTuning, MAX_uint16>;
+
+// Same for sensor rigs (FSWPVehiclePacket::NoSensors).
+using FSWPSensorRigRegistry = TSWPPresetRegistry<FSWPSensorRig, MAX_uint16>;
@@ -0,0 +1,244 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Algo/Reverse.h"
+#include "SWPRoadGraph.h"
+
+// A* working set, reused across searches (one per concurrent planner). Node entries are valid only
+// when stamped with the current search, so nothing is cleared per search.
+struct FSWPRouteScratch
+{
+	struct FOpenNode
+	{
+		float Estimate;		// Cost + heuristic.
+		float Cost;
+		int32 Node;
+	};
+
+	TArray<float> Costs;
+	TArray<int32> Parents;
+	TArray<uint32> Stamps;
+	TArray<FOpenNode> Open;
+	uint32 Stamp = 0;
+
+	void Begin(const int32 NumNodes)
+	{
+		if (Stamps.Num() != NumNodes || ++Stamp == 0)
+		{
+			Costs.SetNumUninitialized(NumNodes);
+			Parents.SetNumUninitialized(NumNodes);
+			Stamps.Init(0, NumNodes);
+			Stamp = 1;
+		}
+		Open.Reset();
+	}
+
+	FORCEINLINE float GetCost(const int32 Node) const { return Stamps[Node] == Stamp ? Costs[Node] : MAX_flt; }
+	FORCEINLINE int32 GetParent(const int32 Node) const { return Stamps[Node] == Stamp ? Parents[Node] : INDEX_NONE; }
+
+	FORCEINLINE void Set(const int32 Node, const float Cost, const int32 Parent)
+	{
+		Stamps[Node] = Stamp;
+		Costs[Node] = Cost;
+		Parents[Node] = Parent;
+	}
+};
+
+/**
+ * FSWPRoadGraphData (built on GT, read-only on PT)
+ *
+ * USWPRoadGraph flattened for the autopilot: node locations and speed limits as plain arrays,
+ * lanes in CSR form (node i links to Links[LinkOffsets[i] .. LinkOffsets[i + 1])), and a 2D grid
+ * over the nodes (also CSR) for nearest-node queries. Immutable once uploaded, so every autopilot
+ * worker reads it without synchronization; a new graph is a new object.
+ */
+struct FSWPRoadGraphData
+{
+	TArray<FVector3f> Locations;		// cm
+	TArray<float> SpeedLimits;			// m/s, 0 = none.
+	TArray<int32> LinkOffsets;			// Num() + 1 entries.
+	TArray<int32> Links;
+
+	// Node grid: cell (x, y) holds GridNodes[GridOffsets[c] .. GridOffsets[c + 1]), c = y * GridSize.X + x.
+	FVector2f GridOrigin = FVector2f::ZeroVector;
+	float CellSize = 1.0f;
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	TArray<int32> GridOffsets;
+	TArray<int32> GridNodes;
+
+	// GT only: invalid and self links are dropped.
+	static FSWPRoadGraphData Make(const USWPRoadGraph& Graph)
+	{
+		FSWPRoadGraphData Data;
+		const int32 NumNodes = Graph.Nodes.Num();
+		Data.Locations.Reserve(NumNodes);
+		Data.SpeedLimits.Reserve(NumNodes);
+		Data.LinkOffsets.Reserve(NumNodes + 1);
+
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			const FSWPRoadNode& Node = Graph.Nodes[i];
+			Data.Locations.Add(FVector3f(Node.Location));
+			Data.SpeedLimits.Add(FMath::Max(Node.SpeedLimitKmh, 0.0f) / 3.6f);
+			Data.LinkOffsets.Add(Data.Links.Num());
+			for (const int32 Link : Node.Links)
+			{
+				if (Link != i && Graph.Nodes.IsValidIndex(Link))
+				{
+					Data.Links.Add(Link);
+				}
+			}
+		}
+		Data.LinkOffsets.Add(Data.Links.Num());
+		Data.BuildGrid();
+		return Data;
+	}
+
+	FORCEINLINE int32 Num() const { return Locations.Num(); }
+
+	// Grid rings around the location until no unvisited cell can hold a closer node (clamped onto the grid,
+	// which only brings nodes closer, so the ring bound still holds).
+	int32 FindNearestNode(const FVector3f& Location) const
+	{
+		if (GridOffsets.IsEmpty()) return INDEX_NONE;
+
+		const FIntPoint Center = GetCell(FVector2f(Location.X, Location.Y));
+		const int32 MaxRing = FMath::Max(GridSize.X, GridSize.Y);
+
+		int32 Nearest = INDEX_NONE;
+		float NearestDistSq = MAX_flt;
+		for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+		{
+			for (int32 y = Center.Y - Ring; y <= Center.Y + Ring; ++y)
+			{
+				if (y < 0 || y >= GridSize.Y) continue;
+
+				// Inner rows only have the two border cells of the ring.
+				const bool bBorderRow = y == Center.Y - Ring || y == Center.Y + Ring;
+				const int32 StepX = bBorderRow ? 1 : FMath::Max(2 * Ring, 1);
+				for (int32 x = Center.X - Ring; x <= Center.X + Ring; x += StepX)
+				{
+					if (x < 0 || x >= GridSize.X) continue;
+
+					const int32 Cell = y * GridSize.X + x;
+					for (int32 n = GridOffsets[Cell]; n < GridOffsets[Cell + 1]; ++n)
+					{
+						const int32 Node = GridNodes[n];
+						const float DistSq = FVector3f::DistSquared(Locations[Node], Location);
+						if (DistSq < NearestDistSq || (DistSq == NearestDistSq && Node < Nearest))
+						{
+							NearestDistSq = DistSq;
+							Nearest = Node;
+						}
+					}
+				}
+			}
+
+			// Cells past this ring are at least Ring cells away.
+			if (Nearest != INDEX_NONE && NearestDistSq < FMath::Square(Ring * CellSize)) break;
+		}
+		return Nearest;
+	}
+
+	/**
+	 * A* over the lanes (euclidean cost and heuristic). OutRoute receives Start .. Goal, empty
+	 * when Goal is unreachable. Scratch belongs to the caller, so workers can plan concurrently.
+	 */
+	template<typename AllocatorType>
+	bool FindRoute(const int32 Start, const int32 Goal, FSWPRouteScratch& Scratch, TArray<int32, AllocatorType>& OutRoute) const
+	{
+		using FOpenNode = FSWPRouteScratch::FOpenNode;
+
+		OutRoute.Reset();
+		if (!Locations.IsValidIndex(Start) || !Locations.IsValidIndex(Goal)) return false;
+
+		auto Less = [](const FOpenNode& A, const FOpenNode& B) { return A.Estimate < B.Estimate; };
+
+		Scratch.Begin(Locations.Num());
+		TArray<FOpenNode>& Open = Scratch.Open;
+
+		const FVector3f& GoalLocation = Locations[Goal];
+		Scratch.Set(Start, 0.0f, INDEX_NONE);
+		Open.HeapPush({ FVector3f::Dist(Locations[Start], GoalLocation), 0.0f, Start }, Less);
+
+		while (Open.Num() > 0)
+		{
+			FOpenNode Top;
+			Open.HeapPop(Top, Less, EAllowShrinking::No);
+			if (Top.Node == Goal) break;
+			if (Top.Cost > Scratch.GetCost(Top.Node)) continue;		// Superseded by a cheaper path.
+
+			for (int32 l = LinkOffsets[Top.Node]; l < LinkOffsets[Top.Node + 1]; ++l)
+			{
+				const int32 Next = Links[l];
+				const float Cost = Top.Cost + FVector3f::Dist(Locations[Top.Node], Locations[Next]);
+				if (Cost < Scratch.GetCost(Next))
+				{
+					Scratch.Set(Next, Cost, Top.Node);
+					Open.HeapPush({ Cost + FVector3f::Dist(Locations[Next], GoalLocation), Cost, Next }, Less);
+				}
+			}
+		}
+
+		if (Start != Goal && Scratch.GetParent(Goal) == INDEX_NONE) return false;
+
+		for (int32 Node = Goal; Node != INDEX_NONE; Node = Scratch.GetParent(Node))
+		{
+			OutRoute.Add(Node);
+		}
+		Algo::Reverse(OutRoute);
+		return true;
+	}
+
+private:
+	// About one node per cell on average, at most MaxGridCells cells.
+	static constexpr int32 MaxGridCells = 1 << 20;
+
+	FORCEINLINE FIntPoint GetCell(const FVector2f& Location) const
+	{
+		const FVector2f Local = (Location - GridOrigin) / CellSize;
+		return FIntPoint(FMath::Clamp(FMath::FloorToInt32(Local.X), 0, GridSize.X - 1),
+						 FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, GridSize.Y - 1));
+	}
+
+	void BuildGrid()
+	{
+		if (Locations.IsEmpty()) return;
+
+		FBox2f Bounds(ForceInit);
+		for (const FVector3f& Location : Locations)
+		{
+			Bounds += FVector2f(Location.X, Location.Y);
+		}
+
+		const FVector2f Extent = Bounds.GetSize();
+		const int32 NumCells = FMath::Clamp(Locations.Num(), 1, MaxGridCells);
+		CellSize = FMath::Max(FMath::Sqrt(FMath::Max(Extent.X * Extent.Y, 1.0f) / NumCells), FMath::Max(Extent.X, Extent.Y) / NumCells);
+		CellSize = FMath::Max(CellSize, 1.0f);
+		GridOrigin = Bounds.Min;
+		GridSize = FIntPoint(FMath::FloorToInt32(Extent.X / CellSize) + 1, FMath::FloorToInt32(Extent.Y / CellSize) + 1);
+
+		// Counting sort of the nodes by cell.
+		TArray<int32> NodeCells;
+		NodeCells.SetNumUninitialized(Locations.Num());
+		GridOffsets.Init(0, GridSize.X * GridSize.Y + 1);
+		for (int32 i = 0; i < Locations.Num(); ++i)
+		{
+			const FIntPoint Cell = GetCell(FVector2f(Locations[i].X, Locations[i].Y));
+			NodeCells[i] = Cell.Y * GridSize.X + Cell.X;
+			++GridOffsets[NodeCells[i] + 1];
+		}
+		for (int32 c = 1; c < GridOffsets.Num(); ++c)
+		{
+			GridOffsets[c] += GridOffsets[c - 1];
+		}
+
+		TArray<int32> Fill(GridOffsets.GetData(), GridOffsets.Num() - 1);
+		GridNodes.SetNumUninitialized(Locations.Num());
+		for (int32 i = 0; i < Locations.Num(); ++i)
+		{
+			GridNodes[Fill[NodeCells[i]]++] = i;
+		}
+	}
+};
@@ -0,0 +1,93 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPVehiclePacket.h"
+
+/**
+ * FSWPSlotAllocator (GT side)
+ *
+ * Hands out the PT slot indices used on the wire instead of FGuids. Freed slots are recycled
+ * with a bumped generation, so PT data and late outputs from a previous owner are rejected.
+ */
+struct FSWPSlotAllocator
+{
+	FSWPVehicleSlot Allocate(const FGuid& Guid)
+	{
+		FSWPVehicleSlot Slot;
+		if (FreeSlots.Num() > 0)
+		{
+			Slot.Index = FreeSlots.Pop(EAllowShrinking::No);
+		}
+		else
+		{
+			Slot.Index = Guids.AddDefaulted();
+			Generations.Add(0);
+		}
+
+		Slot.Generation = ++Generations[Slot.Index];
+		Guids[Slot.Index] = Guid;
+		GuidToSlot.Add(Guid, Slot.Index);
+		return Slot;
+	}
+
+	// Returns the freed slot index (INDEX_NONE if the GUID had none).
+	int32 Free(const FGuid& Guid)
+	{
+		int32 SlotIndex = INDEX_NONE;
+		if (!GuidToSlot.RemoveAndCopyValue(Guid, SlotIndex)) return INDEX_NONE;
+
+		Guids[SlotIndex].Invalidate();
+		FreeSlots.Add(SlotIndex);
+		return SlotIndex;
+	}
+
+	// Same slot and generation under a new GUID (pooled vehicle starting a new life). False if OldGuid has no slot.
+	bool Rekey(const FGuid& OldGuid, const FGuid& NewGuid)
+	{
+		int32 SlotIndex = INDEX_NONE;
+		if (!GuidToSlot.RemoveAndCopyValue(OldGuid, SlotIndex)) return false;
+
+		Guids[SlotIndex] = NewGuid;
+		GuidToSlot.Add(NewGuid, SlotIndex);
+		return true;
+	}
+
+	FORCEINLINE int32 Find(const FGuid& Guid) const
+	{
+		const int32* SlotIndex = GuidToSlot.Find(Guid);
+		return SlotIndex ? *SlotIndex : INDEX_NONE;
+	}
+
+	FORCEINLINE FSWPVehicleSlot GetSlot(const int32 SlotIndex) const
+	{
+		return { SlotIndex, Generations[SlotIndex] };
+	}
+
+	// GUID currently owning (SlotIndex, Generation), or nullptr if the slot moved on.
+	FORCEINLINE const FGuid* ResolveGuid(const int32 SlotIndex, const uint32 Generation) const
+	{
+		return Guids.IsValidIndex(SlotIndex) && Generations[SlotIndex] == Generation && Guids[SlotIndex].IsValid()
+			? &Guids[SlotIndex] : nullptr;
+	}
+
+	void Reset()
+	{
+		// Generations are kept so stale PT outputs can never match a fresh owner.
+		for (int32 i = 0; i < Guids.Num(); ++i)
+		{
+			if (Guids[i].IsValid())
+			{
+				Guids[i].Invalidate();
+				FreeSlots.Add(i);
+			}
+		}
+		GuidToSlot.Reset();
+	}
+
+private:
+	TArray<FGuid> Guids;
+	TArray<uint32> Generations;
+	TArray<int32> FreeSlots;
+	TMap<FGuid, int32> GuidToSlot;
+};
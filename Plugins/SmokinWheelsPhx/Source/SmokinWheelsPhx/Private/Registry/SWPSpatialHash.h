@@ -0,0 +1,159 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+/**
+ * FSWPSpatialHash (PT side)
+ *
+ * Uniform XY grid over the chassis positions of the step, rebuilt every step in place:
+ *  - SetPosition() per vehicle (any thread, each call writes only its own entry),
+ *  - Sort(): counting sort of the vehicles by hash bucket (O(N), stable, so query results are
+ *    deterministic), positions copied in bucket order for cache-friendly queries,
+ *  - radius / k-nearest queries (read-only, safe from every worker of later stages).
+ * Cells hash into a power-of-two bucket table; colliding cells share a bucket and are told
+ * apart by the cell coordinates stored with each entry. Items are indices of the step's
+ * sorted vehicles.
+ */
+struct FSWPSpatialHash
+{
+	// Vehicles per parallel task of the position pass.
+	static constexpr int32 BatchSize = 256;
+
+	struct FNeighbor
+	{
+		int32 Index;
+		float DistSq;
+	};
+
+	// Sizes the per-vehicle arrays (call before SetPosition).
+	void Reset(const int32 NumItems, const float InCellSize)
+	{
+		CellSize = FMath::Max(InCellSize, 100.0f);
+		InvCellSize = 1.0f / CellSize;
+		NumBuckets = static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(NumItems * 2, 64)));
+
+		Positions.SetNumUninitialized(NumItems, EAllowShrinking::No);
+		Cells.SetNumUninitialized(NumItems, EAllowShrinking::No);
+		Buckets.SetNumUninitialized(NumItems, EAllowShrinking::No);
+	}
+
+	FORCEINLINE void SetPosition(const int32 Item, const FVector3f& Position)
+	{
+		const FIntPoint Cell = ToCell(Position.X, Position.Y);
+		Positions[Item] = Position;
+		Cells[Item] = Cell;
+		Buckets[Item] = HashCell(Cell);
+	}
+
+	// Serial: bucket counts, prefix sum to bucket ends, then a reverse scatter that leaves BucketStarts at the bucket begins.
+	void Sort()
+	{
+		const int32 NumItems = Positions.Num();
+		BucketStarts.SetNumUninitialized(NumBuckets + 1, EAllowShrinking::No);
+		FMemory::Memzero(BucketStarts.GetData(), BucketStarts.Num() * sizeof(int32));
+		SortedItems.SetNumUninitialized(NumItems, EAllowShrinking::No);
+		SortedPositions.SetNumUninitialized(NumItems, EAllowShrinking::No);
+		SortedCells.SetNumUninitialized(NumItems, EAllowShrinking::No);
+
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			++BucketStarts[Buckets[i]];
+		}
+		for (int32 b = 1; b <= NumBuckets; ++b)
+		{
+			BucketStarts[b] += BucketStarts[b - 1];
+		}
+		for (int32 i = NumItems - 1; i >= 0; --i)
+		{
+			const int32 Sorted = --BucketStarts[Buckets[i]];
+			SortedItems[Sorted] = i;
+			SortedPositions[Sorted] = Positions[i];
+			SortedCells[Sorted] = Cells[i];
+		}
+	}
+
+	FORCEINLINE int32 Num() const { return Positions.Num(); }
+	FORCEINLINE const FVector3f& GetPosition(const int32 Item) const { return Positions[Item]; }
+
+	// Func(Item, DistSq) for every item within Radius (3D distance) of Center.
+	template<typename FuncType>
+	void ForEachInRadius(const FVector3f& Center, const float Radius, const FuncType& Func) const
+	{
+		if (SortedItems.IsEmpty()) return;
+
+		const float RadiusSq = Radius * Radius;
+		const FIntPoint Min = ToCell(Center.X - Radius, Center.Y - Radius);
+		const FIntPoint Max = ToCell(Center.X + Radius, Center.Y + Radius);
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				const FIntPoint Cell(X, Y);
+				const int32 Bucket = HashCell(Cell);
+				for (int32 k = BucketStarts[Bucket]; k < BucketStarts[Bucket + 1]; ++k)
+				{
+					if (SortedCells[k] != Cell) continue;
+
+					const float DistSq = FVector3f::DistSquared(SortedPositions[k], Center);
+					if (DistSq <= RadiusSq)
+					{
+						Func(SortedItems[k], DistSq);
+					}
+				}
+			}
+		}
+	}
+
+	// Up to MaxCount items within Radius of Center, nearest first (ExcludeItem skipped, e.g. the querying vehicle).
+	template<typename AllocatorType>
+	void FindNearest(const FVector3f& Center, const float Radius, const int32 MaxCount, const int32 ExcludeItem,
+					 TArray<FNeighbor, AllocatorType>& OutNeighbors) const
+	{
+		OutNeighbors.Reset();
+		if (MaxCount <= 0) return;
+
+		ForEachInRadius(Center, Radius, [&OutNeighbors, MaxCount, ExcludeItem](const int32 Item, const float DistSq)
+		{
+			if (Item == ExcludeItem) return;
+			if (OutNeighbors.Num() == MaxCount && DistSq >= OutNeighbors.Last().DistSq) return;
+
+			int32 Insert = OutNeighbors.Num();
+			while (Insert > 0 && OutNeighbors[Insert - 1].DistSq > DistSq)
+			{
+				--Insert;
+			}
+			if (OutNeighbors.Num() == MaxCount)
+			{
+				OutNeighbors.Pop(EAllowShrinking::No);
+			}
+			OutNeighbors.Insert(FNeighbor{ Item, DistSq }, Insert);
+		});
+	}
+
+private:
+	FORCEINLINE FIntPoint ToCell(const float X, const float Y) const
+	{
+		return FIntPoint(FMath::FloorToInt32(X * InvCellSize), FMath::FloorToInt32(Y * InvCellSize));
+	}
+
+	FORCEINLINE int32 HashCell(const FIntPoint& Cell) const
+	{
+		const uint32 Hash = (static_cast<uint32>(Cell.X) * 73856093u) ^ (static_cast<uint32>(Cell.Y) * 19349663u);
+		return static_cast<int32>(Hash & static_cast<uint32>(NumBuckets - 1));
+	}
+
+	float CellSize = 2000.0f;
+	float InvCellSize = 1.0f / 2000.0f;
+	int32 NumBuckets = 64;
+
+	// Per item (sorted vehicle index).
+	TArray<FVector3f> Positions;
+	TArray<FIntPoint> Cells;
+	TArray<int32> Buckets;
+
+	// Bucket order: items of bucket b are [BucketStarts[b], BucketStarts[b + 1]).
+	TArray<int32> BucketStarts;
+	TArray<int32> SortedItems;
+	TArray<FVector3f> SortedPositions;
+	TArray<FIntPoint> SortedCells;
+};
@@ -0,0 +1,151 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "States/SWPVehicleState.h"
+
+/**
+ * FSWPStateHistory (PT-owned)
+ *
+ * Fixed-capacity history of the PT-only vehicle state, keyed by Chaos physics step, so a rewind
+ * can roll it back with the rigid bodies. One ring of NumFrames records per slot, all in two
+ * contiguous arenas (slot-major: growing the fleet appends, nothing moves). Records hold what a
+ * step carries over to the next one: compression ratio per wheel, gear, controls, sensor timers,
+ * and the autopilot destination, cruise speed and controller memory. The route itself is not
+ * stored: a restored autopilot re-plans from where the rolled-back chassis is.
+ *
+ * Arenas only grow with the slot count or the largest wheel count, never per step. Save() and
+ * Restore() touch only their slot's records, so they are safe from the parallel stages.
+ */
+struct FSWPStateHistory
+{
+	// Vehicles per parallel task of the save pass.
+	static constexpr int32 BatchSize = 256;
+
+	struct FRecord
+	{
+		int32 Step = INDEX_NONE;		// Physics step this record was saved after (INDEX_NONE: empty).
+		uint32 Generation = 0;
+		int32 NumWheels = 0;
+		int32 Gear = 1;
+		FSWPVehicleControls Controls;
+		int32 Destination = INDEX_NONE;
+		float CruiseSpeed = 0.0f;
+		int32 RouteIndex = 0;
+		float SpeedIntegral = 0.0f;
+		float PrevSpeedError = 0.0f;
+		int32 NumSensors = 0;
+		float SensorTimers[FSWPSensorRig::MaxSensors] = {};
+	};
+
+	// Drops every record (NumFrames 0 disables the history).
+	void Reset(const int32 InNumFrames)
+	{
+		NumFrames = FMath::Max(InNumFrames, 0);
+		NumSlots = 0;
+		WheelStride = 0;
+		Records.Reset();
+		Compressions.Reset();
+	}
+
+	// Serial, before the parallel Save(). A wider wheel stride changes the layout: the history restarts.
+	void Reserve(const int32 InNumSlots, const int32 MaxWheels)
+	{
+		if (NumFrames == 0) return;
+
+		if (MaxWheels > WheelStride)
+		{
+			const int32 Frames = NumFrames;
+			Reset(Frames);
+			WheelStride = FMath::Max(MaxWheels, FSWPVehiclePacket::NumInlineWheels);
+		}
+		if (InNumSlots > NumSlots)
+		{
+			NumSlots = InNumSlots;
+			Records.SetNum(NumSlots * NumFrames);
+			Compressions.SetNumZeroed(NumSlots * NumFrames * WheelStride);
+		}
+	}
+
+	FORCEINLINE bool IsEnabled() const { return NumFrames > 0; }
+	FORCEINLINE int32 GetNumFrames() const { return NumFrames; }
+
+	void Save(const int32 Step, const int32 Slot, const uint32 Generation, const FSWPVehicleState& VehicleSimState)
+	{
+		const int32 NumWheels = VehicleSimState.Suspensions.Num();
+		if (Slot >= NumSlots || NumWheels > WheelStride) return;
+
+		const int32 Index = GetIndex(Step, Slot);
+		FRecord& Record = Records[Index];
+		Record.Step = Step;
+		Record.Generation = Generation;
+		Record.NumWheels = NumWheels;
+		Record.Gear = VehicleSimState.Gear;
+		Record.Controls = VehicleSimState.Controls;
+		Record.Destination = VehicleSimState.Autopilot.Destination;
+		Record.CruiseSpeed = VehicleSimState.Autopilot.CruiseSpeed;
+		Record.RouteIndex = VehicleSimState.Autopilot.RouteIndex;
+		Record.SpeedIntegral = VehicleSimState.Autopilot.SpeedIntegral;
+		Record.PrevSpeedError = VehicleSimState.Autopilot.PrevSpeedError;
+		Record.NumSensors = FMath::Min(VehicleSimState.SensorTimers.Num(), FSWPSensorRig::MaxSensors);
+		FMemory::Memcpy(Record.SensorTimers, VehicleSimState.SensorTimers.GetData(), Record.NumSensors * sizeof(float));
+
+		float* Compression = Compressions.GetData() + Index * WheelStride;
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			Compression[w] = VehicleSimState.Suspensions[w].PreviousCompressionRatio;
+		}
+	}
+
+	// Record saved after Step for this slot and generation, or null (overwritten, or slot reused since).
+	FORCEINLINE const FRecord* Find(const int32 Step, const int32 Slot, const uint32 Generation) const
+	{
+		if (Step < 0 || Slot >= NumSlots) return nullptr;
+
+		const FRecord& Record = Records[GetIndex(Step, Slot)];
+		return Record.Step == Step && Record.Generation == Generation ? &Record : nullptr;
+	}
+
+	// State as it was after Step. False (state untouched) without a matching record.
+	bool Restore(const int32 Step, const int32 Slot, const uint32 Generation, FSWPVehicleState& VehicleSimState) const
+	{
+		const FRecord* Record = Find(Step, Slot, Generation);
+		if (!Record) return false;
+
+		VehicleSimState.Gear = Record->Gear;
+		VehicleSimState.Controls = Record->Controls;
+		VehicleSimState.SensorTimers.SetNumUninitialized(Record->NumSensors);
+		FMemory::Memcpy(VehicleSimState.SensorTimers.GetData(), Record->SensorTimers, Record->NumSensors * sizeof(float));
+
+		// The current route may belong to another destination (or graph): keep following it, clamped, until re-planned.
+		FSWPAutopilotState& Autopilot = VehicleSimState.Autopilot;
+		Autopilot.Engage(Record->Destination, Record->CruiseSpeed);
+		Autopilot.RouteIndex = FMath::Clamp(Record->RouteIndex, 0, FMath::Max(Autopilot.Route.Num() - 1, 0));
+		Autopilot.SpeedIntegral = Record->SpeedIntegral;
+		Autopilot.PrevSpeedError = Record->PrevSpeedError;
+
+		if (VehicleSimState.Suspensions.Num() != Record->NumWheels)
+		{
+			VehicleSimState.Suspensions.SetNum(Record->NumWheels);
+		}
+		const float* Compression = Compressions.GetData() + static_cast<int32>(Record - Records.GetData()) * WheelStride;
+		for (int32 w = 0; w < Record->NumWheels; ++w)
+		{
+			VehicleSimState.Suspensions[w].PreviousCompressionRatio = Compression[w];
+		}
+		return true;
+	}
+
+private:
+	FORCEINLINE int32 GetIndex(const int32 Step, const int32 Slot) const
+	{
+		return Slot * NumFrames + Step % NumFrames;
+	}
+
+	int32 NumFrames = 0;
+	int32 NumSlots = 0;
+	int32 WheelStride = 0;
+
+	TArray<FRecord> Records;		// [Slot * NumFrames + Step % NumFrames]
+	TArray<float> Compressions;		// WheelStride entries per record, same order.
+};
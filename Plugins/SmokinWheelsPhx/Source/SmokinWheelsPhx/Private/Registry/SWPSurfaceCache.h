@@ -0,0 +1,119 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Chaos/ChaosEngineInterface.h"
+#include "Components/PrimitiveComponent.h"
+
+/**
+ * FSWPSurfaceCache (PT-owned)
+ *
+ * Surface ID per hit primitive, so wheel traces can run without bReturnPhysicalMaterial. A
+ * component with a single physical material is one entry whatever face the wheels hit; only
+ * complex collision that mixes physical materials (e.g. a multi-material mesh) is cached per
+ * face, under a component marker entry. Read-only during the parallel vehicle step: misses are
+ * resolved by the wheel that hit them and merged serially after the step.
+ *
+ * Keys hold weak pointers and are only hashed/compared (never dereferenced). A destroyed and
+ * recycled component gets a new serial number, so stale entries simply stop matching; they
+ * leave through eviction, a few entries at a time, when the cache is full.
+ */
+struct FSWPSurfaceCache
+{
+	struct FKey
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		int32 FaceIndex = INDEX_NONE;		// INDEX_NONE: whole component.
+
+		bool operator==(const FKey& Other) const
+		{
+			return FaceIndex == Other.FaceIndex && Component.HasSameIndexAndSerialNumber(Other.Component);
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombineFast(GetTypeHash(Key.Component), GetTypeHash(Key.FaceIndex));
+		}
+	};
+
+	// One resolved miss: the surface of the whole component, or of one face when bPerFace.
+	struct FEntry
+	{
+		FKey Key;
+		uint8 SurfaceId = SurfaceType_Default;
+		bool bPerFace = false;
+	};
+
+	FORCEINLINE const uint8* Find(const TWeakObjectPtr<UPrimitiveComponent>& Component, const int32 FaceIndex) const
+	{
+		const int32* ComponentIndex = KeyToIndex.Find(FKey{ Component, INDEX_NONE });
+		if (!ComponentIndex) return nullptr;
+		if (!Entries[*ComponentIndex].bPerFace) return &Entries[*ComponentIndex].SurfaceId;
+
+		const int32* FaceEntryIndex = FaceIndex != INDEX_NONE ? KeyToIndex.Find(FKey{ Component, FaceIndex }) : nullptr;
+		return FaceEntryIndex ? &Entries[*FaceEntryIndex].SurfaceId : nullptr;
+	}
+
+	// Serial merge of the step's misses. Over MaxEntries, just enough entries are evicted to make room.
+	void Merge(const TArrayView<const FEntry> NewEntries, const int32 MaxEntries)
+	{
+		if (NewEntries.Num() == 0) return;
+
+		// A per-face entry may bring its component marker along.
+		const int32 NumOver = Entries.Num() + NewEntries.Num() * 2 - MaxEntries;
+		if (MaxEntries > 0 && NumOver > 0)
+		{
+			Evict(NumOver);
+		}
+
+		for (const FEntry& Entry : NewEntries)
+		{
+			if (Entry.bPerFace)
+			{
+				Add({ FKey{ Entry.Key.Component, INDEX_NONE }, SurfaceType_Default, true });
+				Add({ Entry.Key, Entry.SurfaceId, false });
+			}
+			else
+			{
+				Add(Entry);
+			}
+		}
+	}
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+private:
+	void Add(const FEntry& Entry)
+	{
+		if (const int32* Index = KeyToIndex.Find(Entry.Key))
+		{
+			Entries[*Index] = Entry;
+			return;
+		}
+		KeyToIndex.Add(Entry.Key, Entries.Add(Entry));
+	}
+
+	// Removes Count entries at a rotating cursor. The last entry moves into each hole and the cursor
+	// steps past it, so the newest entries are the last to go.
+	void Evict(int32 Count)
+	{
+		for (; Count > 0 && Entries.Num() > 0; --Count)
+		{
+			const int32 Index = EvictCursor < Entries.Num() ? EvictCursor : 0;
+			KeyToIndex.Remove(Entries[Index].Key);
+
+			const int32 LastIndex = Entries.Num() - 1;
+			if (Index != LastIndex)
+			{
+				Entries[Index] = Entries[LastIndex];
+				KeyToIndex[Entries[Index].Key] = Index;
+			}
+			Entries.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+			EvictCursor = Index + 1;
+		}
+	}
+
+	TArray<FEntry> Entries;
+	TMap<FKey, int32> KeyToIndex;
+	int32 EvictCursor = 0;
+};
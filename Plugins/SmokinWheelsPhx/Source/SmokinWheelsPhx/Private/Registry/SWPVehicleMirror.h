@@ -0,0 +1,209 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPVehiclePacket.h"
+
+enum class ESWPVehicleMirrorOp : uint8
+{
+	Upsert,			// Add or replace the whole packet (registration, wheel edits, body recreation).
+	SetActive,		// Toggle simulation only (pooling); packet untouched.
+	Remove,
+};
+
+// One queued GT change, applied to the mirror at pre-tick (never while a build task reads it).
+struct FSWPVehicleMirrorEdit
+{
+	ESWPVehicleMirrorOp Op = ESWPVehicleMirrorOp::Upsert;
+	int32 Slot = INDEX_NONE;
+	bool bActive = true;
+	FSWPVehiclePacket Vehicle;
+	TArray<FSWPWheelPacket, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Wheels;
+};
+
+/**
+ * FSWPVehicleMirror (GT-owned, read by the input build task)
+ *
+ * Every registered vehicle, already in wire format:
+ *  - Vehicles: dense, active entries first ([0, NumActive)), parked ones after.
+ *  - Wheels: one contiguous range per vehicle. Ranges freed by removals/resizes stay as dead
+ *    space until it outweighs live data, then the array is compacted.
+ * Building a packet is one memcpy per array. Changes arrive as FSWPVehicleMirrorEdit and are
+ * applied by the manager between two build tasks.
+ */
+struct FSWPVehicleMirror
+{
+	void Apply(const FSWPVehicleMirrorEdit& Edit)
+	{
+		const int32 Index = SlotToIndex.IsValidIndex(Edit.Slot) ? SlotToIndex[Edit.Slot] : INDEX_NONE;
+
+		switch (Edit.Op)
+		{
+		case ESWPVehicleMirrorOp::Upsert:
+			Upsert(Index, Edit);
+			break;
+
+		case ESWPVehicleMirrorOp::SetActive:
+			if (Index != INDEX_NONE)
+			{
+				SetActive(Index, Edit.bActive);
+			}
+			break;
+
+		case ESWPVehicleMirrorOp::Remove:
+			if (Index != INDEX_NONE)
+			{
+				Remove(Index);
+			}
+			break;
+		}
+
+		// Dead ranges only grow on removals/resizes: compact when they dominate.
+		if (NumDeadWheels > 64 && NumDeadWheels * 2 > Wheels.Num())
+		{
+			CompactWheels();
+		}
+	}
+
+	// Copies the active vehicles and the wheel array (capacity is kept between builds).
+	void Build(TArray<FSWPVehiclePacket>& OutVehicles, TArray<FSWPWheelPacket>& OutWheels) const
+	{
+		OutVehicles.SetNumUninitialized(NumActive, EAllowShrinking::No);
+		FMemory::Memcpy(OutVehicles.GetData(), Vehicles.GetData(), NumActive * sizeof(FSWPVehiclePacket));
+
+		OutWheels.SetNumUninitialized(Wheels.Num(), EAllowShrinking::No);
+		FMemory::Memcpy(OutWheels.GetData(), Wheels.GetData(), Wheels.Num() * sizeof(FSWPWheelPacket));
+	}
+
+	void Reset()
+	{
+		Vehicles.Reset();
+		Wheels.Reset();
+		SlotToIndex.Reset();
+		NumActive = 0;
+		NumDeadWheels = 0;
+	}
+
+	FORCEINLINE const FSWPVehiclePacket* Find(const int32 Slot) const
+	{
+		const int32 Index = SlotToIndex.IsValidIndex(Slot) ? SlotToIndex[Slot] : INDEX_NONE;
+		return Index != INDEX_NONE ? &Vehicles[Index] : nullptr;
+	}
+
+	FORCEINLINE TConstArrayView<FSWPWheelPacket> GetWheels(const FSWPVehiclePacket& Vehicle) const
+	{
+		return TConstArrayView<FSWPWheelPacket>(Wheels.GetData() + Vehicle.FirstWheel, Vehicle.NumWheels);
+	}
+
+	FORCEINLINE int32 Num() const { return Vehicles.Num(); }
+	FORCEINLINE int32 NumActiveVehicles() const { return NumActive; }
+
+private:
+	void Upsert(int32 Index, const FSWPVehicleMirrorEdit& Edit)
+	{
+		FSWPVehiclePacket Vehicle = Edit.Vehicle;
+		Vehicle.NumWheels = Edit.Wheels.Num();
+
+		if (Index == INDEX_NONE)
+		{
+			if (Edit.Slot == INDEX_NONE) return;
+			for (int32 i = SlotToIndex.Num(); i <= Edit.Slot; ++i)
+			{
+				SlotToIndex.Add(INDEX_NONE);
+			}
+
+			Vehicle.FirstWheel = Wheels.Num();
+			Wheels.Append(Edit.Wheels);
+
+			Index = Vehicles.Add(Vehicle);
+			SlotToIndex[Edit.Slot] = Index;
+			SetActive(Index, Edit.bActive);
+			return;
+		}
+
+		const FSWPVehiclePacket& Previous = Vehicles[Index];
+		if (Previous.NumWheels == Vehicle.NumWheels)
+		{
+			// Same layout: overwrite the range in place.
+			Vehicle.FirstWheel = Previous.FirstWheel;
+			FMemory::Memcpy(Wheels.GetData() + Vehicle.FirstWheel, Edit.Wheels.GetData(), Vehicle.NumWheels * sizeof(FSWPWheelPacket));
+		}
+		else
+		{
+			NumDeadWheels += Previous.NumWheels;
+			Vehicle.FirstWheel = Wheels.Num();
+			Wheels.Append(Edit.Wheels);
+		}
+
+		Vehicles[Index] = Vehicle;
+		SetActive(Index, Edit.bActive);
+	}
+
+	void SetActive(const int32 Index, const bool bActive)
+	{
+		const bool bIsActive = Index < NumActive;
+		if (bActive && !bIsActive)
+		{
+			SwapEntries(Index, NumActive);
+			++NumActive;
+		}
+		else if (!bActive && bIsActive)
+		{
+			--NumActive;
+			SwapEntries(Index, NumActive);
+		}
+	}
+
+	void Remove(int32 Index)
+	{
+		const int32 Slot = Vehicles[Index].Slot;
+		NumDeadWheels += Vehicles[Index].NumWheels;
+
+		// Keep the active/parked partition: move out of the active range first, then swap with the last.
+		if (Index < NumActive)
+		{
+			--NumActive;
+			SwapEntries(Index, NumActive);
+			Index = NumActive;
+		}
+
+		const int32 LastIndex = Vehicles.Num() - 1;
+		if (Index != LastIndex)
+		{
+			Vehicles[Index] = Vehicles[LastIndex];
+			SlotToIndex[Vehicles[Index].Slot] = Index;
+		}
+		Vehicles.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+		SlotToIndex[Slot] = INDEX_NONE;
+	}
+
+	void SwapEntries(const int32 A, const int32 B)
+	{
+		if (A == B) return;
+
+		Vehicles.Swap(A, B);
+		SlotToIndex[Vehicles[A].Slot] = A;
+		SlotToIndex[Vehicles[B].Slot] = B;
+	}
+
+	void CompactWheels()
+	{
+		TArray<FSWPWheelPacket> Compacted;
+		Compacted.Reserve(Wheels.Num() - NumDeadWheels);
+		for (FSWPVehiclePacket& Vehicle : Vehicles)
+		{
+			const int32 FirstWheel = Compacted.Num();
+			Compacted.Append(Wheels.GetData() + Vehicle.FirstWheel, Vehicle.NumWheels);
+			Vehicle.FirstWheel = FirstWheel;
+		}
+
+		Wheels = MoveTemp(Compacted);
+		NumDeadWheels = 0;
+	}
+
+	TArray<FSWPVehiclePacket> Vehicles;
+	TArray<FSWPWheelPacket> Wheels;
+	TArray<int32> SlotToIndex;			// Indexed by PT slot; INDEX_NONE when absent.
+	int32 NumActive = 0;
+	int32 NumDeadWheels = 0;
+};
@@ -0,0 +1,65 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Containers/SparseArray.h"
+
+class ASWPVehicle;
+
+/**
+ * FSWPVehicleRegistry (GT side)
+ *
+ * Actor-vehicle registry with O(1) add/remove and dense iteration.
+ *  - Each vehicle gets a stable slot index (kept on the vehicle) for its whole registration.
+ *  - Slots map into a dense array that is swap-removed, so ScenePreTick walks a contiguous
+ *    range with no holes and no per-remove shifting.
+ */
+struct FSWPVehicleRegistry
+{
+	// Returns the stable slot index to store on the vehicle.
+	int32 Add(const TWeakObjectPtr<ASWPVehicle>& Vehicle)
+	{
+		const int32 DenseIndex = Dense.Add(Vehicle);
+		const int32 SlotIndex = SlotToDense.Add(DenseIndex);
+		DenseToSlot.Add(SlotIndex);
+		return SlotIndex;
+	}
+
+	// Frees the slot; the last dense entry fills the hole. Returns false for an unknown slot.
+	bool Remove(const int32 SlotIndex)
+	{
+		if (!SlotToDense.IsValidIndex(SlotIndex)) return false;
+
+		const int32 DenseIndex = SlotToDense[SlotIndex];
+		const int32 LastDenseIndex = Dense.Num() - 1;
+		if (DenseIndex != LastDenseIndex)
+		{
+			const int32 MovedSlotIndex = DenseToSlot[LastDenseIndex];
+			Dense[DenseIndex] = Dense[LastDenseIndex];
+			DenseToSlot[DenseIndex] = MovedSlotIndex;
+			SlotToDense[MovedSlotIndex] = DenseIndex;
+		}
+
+		Dense.RemoveAt(LastDenseIndex, 1, EAllowShrinking::No);
+		DenseToSlot.RemoveAt(LastDenseIndex, 1, EAllowShrinking::No);
+		SlotToDense.RemoveAt(SlotIndex);
+		return true;
+	}
+
+	void Reset()
+	{
+		Dense.Reset();
+		DenseToSlot.Reset();
+		SlotToDense.Reset();
+	}
+
+	FORCEINLINE int32 Num() const { return Dense.Num(); }
+
+	// Dense view (order changes on remove; never hold indices into it across frames).
+	FORCEINLINE const TArray<TWeakObjectPtr<ASWPVehicle>>& GetVehicles() const { return Dense; }
+
+private:
+	TArray<TWeakObjectPtr<ASWPVehicle>> Dense;
+	TArray<int32> DenseToSlot;
+	TSparseArray<int32> SlotToDense;		// Free slots are recycled by TSparseArray's free list.
+};
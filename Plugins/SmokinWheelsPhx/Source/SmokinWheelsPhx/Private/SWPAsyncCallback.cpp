@@ -2,15 +2,64 @@
 
 #include "SWPAsyncCallback.h"
 #include "PBDRigidsSolver.h"
-#include "SWPPhysicsUtility.h"
 #include "SWPStat.h"
-#include "Solvers/SWPSuspensionSolver.h"
+#include "Debug/SWPDebugDrawCVars.h"
+#include "Solvers/SWPAutopilotSolver.h"
+#include "Solvers/SWPDeterminism.h"
+#include "Solvers/SWPPowertrainSolver.h"
+#include "Solvers/SWPPredictionSolver.h"
+#include "Solvers/SWPSensorSolver.h"
+#include "Solvers/SWPTireSolver.h"
+#include "Solvers/SWPVehicleSolver.h"
 
 // Show with 'stat SmokinWheelsPhx' in the UE console
 DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:OnPreSimulate_Internal"), STAT_SmokinWheelsPhx_OnPreSimulate_Internal, STATGROUP_SmokinWheelsPhx);
 DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:ChaosSingleThread"), STAT_SmokinWheelsPhx_ChaosSingleThread, STATGROUP_SmokinWheelsPhx);
 DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:ChaosParallelFor"), STAT_SmokinWheelsPhx_ChaosParallelFor, STATGROUP_SmokinWheelsPhx);
 
+// Per contact mode: time spent stepping vehicles (summed over workers) and scene queries issued.
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:VehicleStep Ray"), STAT_SmokinWheelsPhx_VehicleStepRay, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:VehicleStep RayFan"), STAT_SmokinWheelsPhx_VehicleStepRayFan, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:VehicleStep Sweep"), STAT_SmokinWheelsPhx_VehicleStepSweep, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Queries Ray"), STAT_SmokinWheelsPhx_QueriesRay, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Queries RayFan"), STAT_SmokinWheelsPhx_QueriesRayFan, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Queries Sweep"), STAT_SmokinWheelsPhx_QueriesSweep, STATGROUP_SmokinWheelsPhx);
+
+// Driver inputs: samples applied per step and worst input-to-force latency (in PT steps) among them.
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Control samples"), STAT_SmokinWheelsPhx_ControlSamples, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SmokinWheelsPhx:Control latency (steps)"), STAT_SmokinWheelsPhx_ControlLatency, STATGROUP_SmokinWheelsPhx);
+
+// Autopilot: vehicles driven by the PT autopilot this step, and the stage time.
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Autopilot vehicles"), STAT_SmokinWheelsPhx_AutopilotVehicles, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:AutopilotStage"), STAT_SmokinWheelsPhx_AutopilotStage, STATGROUP_SmokinWheelsPhx);
+
+// Sensors: rays traced this step (all due scans) and the stage time.
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Sensor rays"), STAT_SmokinWheelsPhx_SensorRays, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:SensorStage"), STAT_SmokinWheelsPhx_SensorStage, STATGROUP_SmokinWheelsPhx);
+
+// Rewind history save pass.
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:HistorySave"), STAT_SmokinWheelsPhx_HistorySave, STATGROUP_SmokinWheelsPhx);
+
+// Fleet snapshots: capture pass, and loading of restored states (vehicles loaded this step).
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:SnapshotCapture"), STAT_SmokinWheelsPhx_SnapshotCapture, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:SnapshotRestore"), STAT_SmokinWheelsPhx_SnapshotRestore, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Restored vehicles"), STAT_SmokinWheelsPhx_RestoredVehicles, STATGROUP_SmokinWheelsPhx);
+
+// Lockstep checksum of the vehicle states (swp.Deterministic).
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:StateChecksum"), STAT_SmokinWheelsPhx_StateChecksum, STATGROUP_SmokinWheelsPhx);
+
+// Forward predictions run this step and the stage time.
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Predictions"), STAT_SmokinWheelsPhx_Predictions, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:PredictionStage"), STAT_SmokinWheelsPhx_PredictionStage, STATGROUP_SmokinWheelsPhx);
+
+// Spatial hash rebuild (positions + counting sort) and neighbour publishing.
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:SpatialHashBuild"), STAT_SmokinWheelsPhx_SpatialHashBuild, STATGROUP_SmokinWheelsPhx);
+
+// Batched stages (fleet-wide powertrain and tire solves, then per-vehicle force application).
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:PowertrainStage"), STAT_SmokinWheelsPhx_PowertrainStage, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:TireStage"), STAT_SmokinWheelsPhx_TireStage, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:ApplyStage"), STAT_SmokinWheelsPhx_ApplyStage, STATGROUP_SmokinWheelsPhx);
+
 // Runtime toggle: force the per-vehicle step to run single-threaded.
 static bool GSWP_ForceSingleThread = false;
 FAutoConsoleVariableRef CVarSWP_ForceSingleThread(
@@ -20,6 +69,537 @@ FAutoConsoleVariableRef CVarSWP_ForceSingleThread(
 	ECVF_Cheat
 );
 
+// Admission budget: bulk spawns enter the simulation a few vehicles per step (handle lookup + first solve).
+static int32 GSWP_MaxAdmissionsPerStep = 32;
+FAutoConsoleVariableRef CVarSWP_MaxAdmissionsPerStep(
+	TEXT("swp.MaxAdmissionsPerStep"),
+	GSWP_MaxAdmissionsPerStep,
+	TEXT("Max number of newly added vehicles admitted into the PT step per physics step (0 = unlimited)."),
+	ECVF_Default
+);
+
+// Keep simulated chassis awake from the PT (replaces a per-actor GT tick calling WakeRigidBody).
+static bool GSWP_KeepAwakeOnPT = true;
+FAutoConsoleVariableRef CVarSWP_KeepAwakeOnPT(
+	TEXT("swp.KeepAwakeOnPT"),
+	GSWP_KeepAwakeOnPT,
+	TEXT("If true, sleeping vehicle chassis are woken up on the physics thread every step (1/0)."),
+	ECVF_Default
+);
+
+// Surface-aware contacts: resolve the hit's surface type through the PT surface cache.
+static bool GSWP_SurfaceAware = true;
+FAutoConsoleVariableRef CVarSWP_SurfaceAware(
+	TEXT("swp.SurfaceAware"),
+	GSWP_SurfaceAware,
+	TEXT("If true, wheel contacts resolve their surface type and apply the surface table multipliers (1/0)."),
+	ECVF_Default
+);
+
+// Bound on the hit -> surface cache (per component, per face on mixed-material collision). Evicts to fit.
+static int32 GSWP_SurfaceCacheMaxEntries = 16384;
+FAutoConsoleVariableRef CVarSWP_SurfaceCacheMaxEntries(
+	TEXT("swp.SurfaceCacheMaxEntries"),
+	GSWP_SurfaceCacheMaxEntries,
+	TEXT("Max number of cached component/face surface IDs; past it a few entries are evicted per merge (0 = unlimited)."),
+	ECVF_Default
+);
+
+// Tire model: longitudinal/lateral tire forces from a batched stage after the suspension step.
+static bool GSWP_TireModel = true;
+FAutoConsoleVariableRef CVarSWP_TireModel(
+	TEXT("swp.TireModel"),
+	GSWP_TireModel,
+	TEXT("If true, wheels in contact produce tire (grip/rolling resistance) forces from a batched PT stage (1/0)."),
+	ECVF_Default
+);
+
+// Powertrain/aero: engine, gearbox, differential, brakes and drag from a batched stage.
+static bool GSWP_Powertrain = true;
+FAutoConsoleVariableRef CVarSWP_Powertrain(
+	TEXT("swp.Powertrain"),
+	GSWP_Powertrain,
+	TEXT("If true, vehicles with a powertrain preset get drive/brake and aero forces from a batched PT stage (1/0)."),
+	ECVF_Default
+);
+
+// Autopilot: AI vehicles steer/accelerate from the road graph in a batched stage before the vehicle step.
+static bool GSWP_Autopilot = true;
+FAutoConsoleVariableRef CVarSWP_Autopilot(
+	TEXT("swp.Autopilot"),
+	GSWP_Autopilot,
+	TEXT("If true, vehicles with an autopilot destination are driven by the PT autopilot stage (1/0)."),
+	ECVF_Default
+);
+
+// Route planning budget: a new road graph (or a wave of destinations) replans the fleet over several steps.
+static int32 GSWP_MaxReplansPerStep = 16;
+FAutoConsoleVariableRef CVarSWP_MaxReplansPerStep(
+	TEXT("swp.MaxReplansPerStep"),
+	GSWP_MaxReplansPerStep,
+	TEXT("Max number of autopilot routes planned per physics step; the rest waits for the next steps (0 = unlimited)."),
+	ECVF_Default
+);
+
+// Raycast sensors declared on the vehicles (range finders, lidar fans), traced in a batched PT stage.
+static bool GSWP_Sensors = true;
+FAutoConsoleVariableRef CVarSWP_Sensors(
+	TEXT("swp.Sensors"),
+	GSWP_Sensors,
+	TEXT("If true, vehicle sensors are traced on the PT at their own rate and reported in the output (1/0)."),
+	ECVF_Default
+);
+
+// Lockstep/replay mode: snapped ground queries and a fixed-point suspension force path, plus a checksum of every vehicle state per step.
+static bool GSWP_Deterministic = false;
+FAutoConsoleVariableRef CVarSWP_Deterministic(
+	TEXT("swp.Deterministic"),
+	GSWP_Deterministic,
+	TEXT("If true, ground queries are snapped to a fixed-point grid, suspension forces are computed in fixed point and a per-step state checksum is reported for desync detection (1/0)."),
+	ECVF_Default
+);
+
+// "What-if" forward predictions (trajectory previews for AI/UI) on scratch copies of the vehicle state.
+static bool GSWP_Prediction = true;
+FAutoConsoleVariableRef CVarSWP_Prediction(
+	TEXT("swp.Prediction"),
+	GSWP_Prediction,
+	TEXT("If true, forward prediction requests are rolled out in a batched PT stage (1/0)."),
+	ECVF_Default
+);
+
+static int32 GSWP_MaxPredictionsPerStep = 16;
+FAutoConsoleVariableRef CVarSWP_MaxPredictionsPerStep(
+	TEXT("swp.MaxPredictionsPerStep"),
+	GSWP_MaxPredictionsPerStep,
+	TEXT("Max number of forward predictions run per physics step; the rest waits for the next steps (0 = unlimited)."),
+	ECVF_Default
+);
+
+static int32 GSWP_MaxPredictionSteps = 600;
+FAutoConsoleVariableRef CVarSWP_MaxPredictionSteps(
+	TEXT("swp.MaxPredictionSteps"),
+	GSWP_MaxPredictionSteps,
+	TEXT("Upper bound on the physics steps rolled out by one forward prediction."),
+	ECVF_Default
+);
+
+// Spatial hash of chassis positions, rebuilt every step (neighbour queries for autopilot/gameplay).
+static bool GSWP_SpatialHash = true;
+FAutoConsoleVariableRef CVarSWP_SpatialHash(
+	TEXT("swp.SpatialHash"),
+	GSWP_SpatialHash,
+	TEXT("If true, the PT rebuilds a uniform-grid hash of vehicle positions every step for neighbour queries (1/0)."),
+	ECVF_Default
+);
+
+static float GSWP_SpatialHashCellSize = 2000.0f;
+FAutoConsoleVariableRef CVarSWP_SpatialHashCellSize(
+	TEXT("swp.SpatialHashCellSize"),
+	GSWP_SpatialHashCellSize,
+	TEXT("Cell size (cm) of the PT vehicle spatial hash (about the usual query radius)."),
+	ECVF_Default
+);
+
+// Neighbour lists in FSWPVehicleOut (GT gameplay reads them instead of running its own overlaps).
+static int32 GSWP_PublishNeighbors = 0;
+FAutoConsoleVariableRef CVarSWP_PublishNeighbors(
+	TEXT("swp.PublishNeighbors"),
+	GSWP_PublishNeighbors,
+	TEXT("Nearest vehicles published per vehicle in the PT output (0 = off, max 8). Requires swp.SpatialHash."),
+	ECVF_Default
+);
+
+static float GSWP_NeighborRadius = 5000.0f;
+FAutoConsoleVariableRef CVarSWP_NeighborRadius(
+	TEXT("swp.NeighborRadius"),
+	GSWP_NeighborRadius,
+	TEXT("Search radius (cm) of the published neighbour lists."),
+	ECVF_Default
+);
+
+// Runs Func(0 .. Num-1) on the Chaos worker pool, or inline with swp.ForceSingleThread.
+template<typename FuncType>
+static void SWP_RunStage(const int32 Num, const FuncType& Func)
+{
+	if (GSWP_ForceSingleThread)
+	{
+		for (int32 k = 0; k < Num; ++k)
+		{
+			Func(k);
+		}
+		return;
+	}
+
+	Chaos::PhysicsParallelFor(Num, Func, false);
+}
+
+// Preset tables grow with new indices; reused indices are overwritten in place.
+template<typename TuningType>
+static void SWP_ApplyPresetUploads(TArray<TuningType>& Table, const TArray<TSWPPresetUpload<TuningType>>& Uploads)
+{
+	for (const TSWPPresetUpload<TuningType>& Upload : Uploads)
+	{
+		if (Upload.Index >= Table.Num())
+		{
+			Table.SetNum(Upload.Index + 1, EAllowShrinking::No);
+		}
+		Table[Upload.Index] = Upload.Tuning;
+	}
+}
+
+// Applies the GT input of a (non-resimulated) step to the PT state.
+void FSWPAsyncCallback::ConsumeInput_Internal(const FSWPAsyncCallbackInput& AsyncInput, const uint32 Step)
+{
+	// New presets arrive no later than the first packet referencing them.
+	SWP_ApplyPresetUploads(Presets, AsyncInput.PresetsToUpload);
+	SWP_ApplyPresetUploads(PowertrainPresets, AsyncInput.PowertrainPresetsToUpload);
+	SWP_ApplyPresetUploads(SensorRigs, AsyncInput.SensorRigsToUpload);
+
+	if (AsyncInput.SurfaceScales.Num() == SurfaceType_Max)
+	{
+		SurfaceScales = AsyncInput.SurfaceScales;
+	}
+	else if (SurfaceScales.Num() != SurfaceType_Max)
+	{
+		SurfaceScales.Init(FSWPSurfaceScale(), SurfaceType_Max);
+	}
+
+	// 2) Apply removes/adds for per-vehicle PT state (slots queued on GT, generation-checked).
+	// Removes first: a slot freed and reused within the same frame is re-added right after.
+	for (const FSWPVehicleSlot& SlotToRemove : AsyncInput.VehiclesToRemove)
+	{
+		if (PhysicsDataVehicles.IsValidIndex(SlotToRemove.Index) && PhysicsDataVehicles[SlotToRemove.Index].bAdmitted)
+		{
+			if (PhysicsDataVehicles[SlotToRemove.Index].Generation == SlotToRemove.Generation)
+			{
+				PhysicsDataVehicles[SlotToRemove.Index] = FSWPVehiclePhysicsData();
+			}
+		}
+		else
+		{
+			// Removed before it was ever admitted.
+			PendingAdmissions.RemoveAll([&SlotToRemove](const FSWPVehicleSlot& Slot)
+			{
+				return Slot.Index == SlotToRemove.Index && Slot.Generation == SlotToRemove.Generation;
+			});
+			PendingControls.Remove(SlotToRemove.Index);
+		}
+	}
+	PendingAdmissions.Append(AsyncInput.VehiclesToAdd);
+
+	// Restored vehicles skip the budget: a loaded snapshot enters the simulation in one step.
+	if (AsyncInput.VehicleRestores.Num() > 0)
+	{
+		TBitArray<> RestoredSlots(false, PhysicsDataVehicles.Num());
+		for (const FSWPVehicleRestore& Restore : AsyncInput.VehicleRestores)
+		{
+			if (Restore.Slot >= RestoredSlots.Num())
+			{
+				RestoredSlots.Add(false, Restore.Slot + 1 - RestoredSlots.Num());
+			}
+			RestoredSlots[Restore.Slot] = true;
+		}
+
+		int32 NumKept = 0;
+		for (int32 i = 0; i < PendingAdmissions.Num(); ++i)
+		{
+			const FSWPVehicleSlot Slot = PendingAdmissions[i];
+			if (RestoredSlots.IsValidIndex(Slot.Index) && RestoredSlots[Slot.Index])
+			{
+				Admit_Internal(Slot);
+				continue;
+			}
+			PendingAdmissions[NumKept++] = Slot;
+		}
+		PendingAdmissions.SetNum(NumKept, EAllowShrinking::No);
+	}
+
+	// Admit (FIFO) up to the per-step budget; the rest keeps waiting and is not simulated yet.
+	const int32 NumPending = PendingAdmissions.Num();
+	const int32 NumToAdmit = GSWP_MaxAdmissionsPerStep > 0 ? FMath::Min(NumPending, GSWP_MaxAdmissionsPerStep) : NumPending;
+	for (int32 i = 0; i < NumToAdmit; ++i)
+	{
+		Admit_Internal(PendingAdmissions[i]);
+	}
+	PendingAdmissions.RemoveAt(0, NumToAdmit, EAllowShrinking::No);
+
+	for (const FSWPVehicleSlot& SlotToReset : AsyncInput.VehiclesToReset)
+	{
+		// Keep the entry (and its wheel storage), only clear the simulated values. A vehicle not admitted yet has none.
+		if (PhysicsDataVehicles.IsValidIndex(SlotToReset.Index) && PhysicsDataVehicles[SlotToReset.Index].bAdmitted
+			&& PhysicsDataVehicles[SlotToReset.Index].Generation == SlotToReset.Generation)
+		{
+			FSWPVehicleState& SimState = PhysicsDataVehicles[SlotToReset.Index].SimState;
+			for (FSWPSuspensionState& SuspensionState : SimState.Suspensions)
+			{
+				SuspensionState = FSWPSuspensionState();
+			}
+			SimState.Controls = FSWPVehicleControls();
+			SimState.Gear = 1;
+			SimState.Autopilot = FSWPAutopilotState();
+			SimState.SensorRanges.Reset();
+			SimState.SensorTimers.Reset();
+			SimState.NetState = FSWPNetVehicleState();
+		}
+	}
+
+	// Replicated compression ratios (client side of fleet replication): the suspension continues from the server's.
+	for (const FSWPSuspensionCorrection& Correction : AsyncInput.SuspensionCorrections)
+	{
+		if (!PhysicsDataVehicles.IsValidIndex(Correction.Slot)) continue;
+
+		FSWPVehiclePhysicsData& PhysicsData = PhysicsDataVehicles[Correction.Slot];
+		if (!PhysicsData.bAdmitted || PhysicsData.Generation != Correction.Generation) continue;
+
+		const float* Compressions = AsyncInput.CorrectedCompressions.GetData() + Correction.FirstCompression;
+		const int32 NumWheels = FMath::Min(Correction.NumWheels, PhysicsData.SimState.Suspensions.Num());
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			PhysicsData.SimState.Suspensions[w].PreviousCompressionRatio = Compressions[w];
+		}
+	}
+
+	// Snapshot states are loaded once their vehicle's body is bound (the packet may still be on its way).
+	{
+		const int32 CompressionBase = PendingRestoredCompressions.Num();
+		PendingRestoredCompressions.Append(AsyncInput.RestoredCompressions);
+		for (FSWPVehicleRestore Restore : AsyncInput.VehicleRestores)
+		{
+			Restore.FirstCompression += CompressionBase;
+			PendingRestores.Add(Restore);
+		}
+	}
+
+	// Driver inputs: consume every sample up to this input's frame, so the newest one per vehicle
+	// wins. Samples stamped for a later frame stay queued until the step consuming that frame.
+	// A vehicle still waiting for admission keeps its newest sample for Admit_Internal.
+	{
+		int32 NumSamples = 0;
+		uint32 MaxLatency = 0;
+		while (const FSWPControlSample* Sample = ControlChannel.Peek())
+		{
+			if (Sample->Timestamp > AsyncInput.Timestamp) break;
+
+			if (PhysicsDataVehicles.IsValidIndex(Sample->Slot))
+			{
+				FSWPVehiclePhysicsData& PhysicsData = PhysicsDataVehicles[Sample->Slot];
+				if (PhysicsData.bAdmitted && PhysicsData.Generation == Sample->Generation)
+				{
+					PhysicsData.SimState.Controls = Sample->Controls;
+					MaxLatency = FMath::Max(MaxLatency, Step - Sample->PushedAtStep);
+					++NumSamples;
+				}
+				else if (!PhysicsData.bAdmitted)
+				{
+					PendingControls.Add(Sample->Slot, *Sample);
+				}
+			}
+			else
+			{
+				PendingControls.Add(Sample->Slot, *Sample);
+			}
+			ControlChannel.Pop();
+		}
+
+		if (NumSamples > 0)
+		{
+			INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_ControlSamples, NumSamples);
+			SET_DWORD_STAT(STAT_SmokinWheelsPhx_ControlLatency, MaxLatency);
+		}
+	}
+
+	// Autopilot: a new road graph invalidates every planned route (node indices refer to the old one);
+	// the replans are spread over the next steps. Destination changes for vehicles still waiting for
+	// admission are kept (AI usually gets a destination right after spawning).
+	if (AsyncInput.RoadGraph)
+	{
+		RoadGraph = AsyncInput.RoadGraph;
+		for (FSWPVehiclePhysicsData& VehiclePhysicsData : PhysicsDataVehicles)
+		{
+			FSWPAutopilotState& Autopilot = VehiclePhysicsData.SimState.Autopilot;
+			Autopilot.bReplan = Autopilot.IsEngaged();
+			Autopilot.Route.Reset();
+			Autopilot.DistanceToGo.Reset();
+			Autopilot.RouteIndex = 0;
+		}
+	}
+
+	PendingAutopilotCommands.Append(AsyncInput.AutopilotCommands);
+	{
+		int32 NumKept = 0;
+		for (int32 i = 0; i < PendingAutopilotCommands.Num(); ++i)
+		{
+			const FSWPAutopilotCommand Command = PendingAutopilotCommands[i];
+			if (PhysicsDataVehicles.IsValidIndex(Command.Slot))
+			{
+				FSWPVehiclePhysicsData& VehiclePhysicsData = PhysicsDataVehicles[Command.Slot];
+				if (VehiclePhysicsData.bAdmitted && VehiclePhysicsData.Generation == Command.Generation)
+				{
+					VehiclePhysicsData.SimState.Autopilot.Engage(Command.Destination, Command.CruiseSpeed);
+					if (!VehiclePhysicsData.SimState.Autopilot.IsEngaged())
+					{
+						VehiclePhysicsData.SimState.Controls = FSWPVehicleControls();
+					}
+					continue;
+				}
+			}
+
+			const bool bAwaitingAdmission = PendingAdmissions.ContainsByPredicate([&Command](const FSWPVehicleSlot& Slot)
+			{
+				return Slot.Index == Command.Slot && Slot.Generation == Command.Generation;
+			});
+			if (bAwaitingAdmission)
+			{
+				PendingAutopilotCommands[NumKept++] = Command;
+			}
+		}
+		PendingAutopilotCommands.SetNum(NumKept, EAllowShrinking::No);
+	}
+
+	PendingPredictions.Append(AsyncInput.PredictionRequests);
+
+	if (AsyncInput.RewindHistoryFrames != History.GetNumFrames())
+	{
+		History.Reset(AsyncInput.RewindHistoryFrames);
+	}
+}
+
+void FSWPAsyncCallback::Admit_Internal(const FSWPVehicleSlot& Slot)
+{
+	if (Slot.Index >= PhysicsDataVehicles.Num())
+	{
+		PhysicsDataVehicles.SetNum(Slot.Index + 1);
+	}
+
+	FSWPVehiclePhysicsData& PhysicsData = PhysicsDataVehicles[Slot.Index];
+	PhysicsData = FSWPVehiclePhysicsData();
+	PhysicsData.Generation = Slot.Generation;
+	PhysicsData.bAdmitted = true;
+
+	// Driver inputs sent while it was waiting (stale ones from a previous occupant of the slot are dropped).
+	FSWPControlSample PendingControl;
+	if (PendingControls.RemoveAndCopyValue(Slot.Index, PendingControl) && PendingControl.Generation == Slot.Generation)
+	{
+		PhysicsData.SimState.Controls = PendingControl.Controls;
+	}
+}
+
+// Serial (touches the evolution): overwrites chassis and PT state of every restored vehicle whose body is bound.
+// Vehicles still unbound keep waiting; removed ones are dropped.
+void FSWPAsyncCallback::LoadRestores_Internal()
+{
+	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_SnapshotRestore);
+
+	Chaos::FPhysicsSolver* ChaosSolver = static_cast<Chaos::FPhysicsSolver*>(GetSolver());
+	if (!ChaosSolver) return;
+
+	float* Compressions = PendingRestoredCompressions.GetData();
+	int32 NumKept = 0;
+	int32 NumKeptCompressions = 0;
+	int32 NumLoaded = 0;
+	for (int32 i = 0; i < PendingRestores.Num(); ++i)
+	{
+		FSWPVehicleRestore Restore = PendingRestores[i];
+		if (!PhysicsDataVehicles.IsValidIndex(Restore.Slot)) continue;
+
+		FSWPVehiclePhysicsData& VehiclePhysicsData = PhysicsDataVehicles[Restore.Slot];
+		if (!VehiclePhysicsData.bAdmitted || VehiclePhysicsData.Generation != Restore.Generation) continue;
+
+		Chaos::FPBDRigidParticleHandle* Chassis = VehiclePhysicsData.PhysicsHandle;
+		if (!Chassis)
+		{
+			// Kept ranges only move down: compact in place.
+			FMemory::Memmove(Compressions + NumKeptCompressions, Compressions + Restore.FirstCompression, Restore.NumWheels * sizeof(float));
+			Restore.FirstCompression = NumKeptCompressions;
+			NumKeptCompressions += Restore.NumWheels;
+			PendingRestores[NumKept++] = Restore;
+			continue;
+		}
+
+		// A different wheel count than the packet's is resized by the step (extra wheels dropped, missing ones uncompressed).
+		FSWPVehicleState& SimState = VehiclePhysicsData.SimState;
+		SimState.Suspensions.Reset();
+		SimState.Suspensions.SetNum(Restore.NumWheels);
+		for (int32 w = 0; w < Restore.NumWheels; ++w)
+		{
+			SimState.Suspensions[w].PreviousCompressionRatio = Compressions[Restore.FirstCompression + w];
+		}
+		SimState.Controls = Restore.Controls;
+		SimState.Gear = Restore.Gear;
+		SimState.Autopilot = FSWPAutopilotState();
+		SimState.Autopilot.Engage(Restore.Destination, Restore.CruiseSpeed);
+		SimState.Autopilot.SpeedIntegral = Restore.SpeedIntegral;
+		SimState.Autopilot.PrevSpeedError = Restore.PrevSpeedError;
+		SimState.SensorRanges.Reset();
+		SimState.SensorTimers.Reset();
+		SimState.NetState = FSWPNetVehicleState();
+
+		const Chaos::FVec3 Location(Restore.Location[0], Restore.Location[1], Restore.Location[2]);
+		const Chaos::FRotation3 Rotation(FQuat(Restore.Rotation[0], Restore.Rotation[1], Restore.Rotation[2], Restore.Rotation[3]).GetNormalized());
+		ChaosSolver->GetEvolution()->SetParticleTransform(Chassis, Location, Rotation, true);
+		if (Chassis->ObjectState() == Chaos::EObjectStateType::Sleeping)
+		{
+			ChaosSolver->GetEvolution()->SetParticleObjectState(Chassis, Chaos::EObjectStateType::Dynamic);
+		}
+		Chassis->SetV(Chaos::FVec3(Restore.LinearVelocity[0], Restore.LinearVelocity[1], Restore.LinearVelocity[2]));
+		Chassis->SetW(Chaos::FVec3(Restore.AngularVelocity[0], Restore.AngularVelocity[1], Restore.AngularVelocity[2]));
+		++NumLoaded;
+	}
+	PendingRestores.SetNum(NumKept, EAllowShrinking::No);
+	PendingRestoredCompressions.SetNum(NumKeptCompressions, EAllowShrinking::No);
+
+	INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_RestoredVehicles, NumLoaded);
+}
+
+// Resimulated step: the first one rolls every vehicle back to its state after the previous step, each
+// one replays the controls recorded for it (driver samples were consumed by the original step).
+void FSWPAsyncCallback::RestoreHistory_Internal()
+{
+	for (int32 Slot = 0; Slot < PhysicsDataVehicles.Num(); ++Slot)
+	{
+		FSWPVehiclePhysicsData& VehiclePhysicsData = PhysicsDataVehicles[Slot];
+		if (!VehiclePhysicsData.bAdmitted) continue;
+
+		if (bRestorePending)
+		{
+			History.Restore(PhysicsStep - 1, Slot, VehiclePhysicsData.Generation, VehiclePhysicsData.SimState);
+		}
+		if (const FSWPStateHistory::FRecord* Record = History.Find(PhysicsStep, Slot, VehiclePhysicsData.Generation))
+		{
+			VehiclePhysicsData.SimState.Controls = Record->Controls;
+		}
+	}
+	bRestorePending = false;
+}
+
+// Step that simulates no vehicle: requests still waiting on the PT are answered with empty results (predictions
+// without poses, a snapshot without vehicles), so their GT pollers are never left waiting on an empty fleet.
+// A snapshot is only empty when the fleet is: with vehicles still unadmitted/unbound it waits (bFleetSettled).
+void FSWPAsyncCallback::PublishEmptyStep_Internal(const FSWPAsyncCallbackInput& AsyncInput, uint32 Step, bool bFleetSettled)
+{
+	const bool bSnapshot = AsyncInput.bCaptureSnapshot && !bResimStep && bFleetSettled;
+	if (PendingPredictions.IsEmpty() && !bSnapshot) return;
+
+	FSWPAsyncCallbackOutput& AsyncOutput = GetProducerOutputData_Internal();
+	AsyncOutput.Reset();
+	AsyncOutput.Timestamp = AsyncInput.Timestamp;
+	AsyncOutput.Step = Step;
+	if (const Chaos::FPhysicsSolverBase* Solver = GetSolver())
+	{
+		AsyncOutput.PhysicsStep = Solver->GetCurrentFrame();
+	}
+	AsyncOutput.bSnapshot = bSnapshot;
+
+	AsyncOutput.Predictions.Reserve(PendingPredictions.Num());
+	for (const FSWPPredictionRequest& Request : PendingPredictions)
+	{
+		FSWPPredictionOut& PredictionOut = AsyncOutput.Predictions.AddDefaulted_GetRef();
+		PredictionOut.RequestId = Request.RequestId;
+	}
+	PendingPredictions.Reset();
+}
+
 void FSWPAsyncCallback::OnPreSimulate_Internal()
 {
 	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_OnPreSimulate_Internal);
@@ -35,21 +615,25 @@ void FSWPAsyncCallback::OnPreSimulate_Internal()
 	if (!World) return;
 
 	float SimTime = GetDeltaTime_Internal();
+	const uint32 Step = NumSteps.fetch_add(1, std::memory_order_relaxed) + 1;
 
-	// 2) Apply adds/removes for per-vehicle PT state.
-	// These FGuids were queued on GT.
-	for (int32 i = 0; i < AsyncInput->VehiclesToAdd.Num(); ++i)
+	// One-shot input (uploads, adds/removes, driver inputs, commands) was consumed by the original step:
+	// a resimulated step only restores its recorded state, the rest of the step runs as usual.
+	if (bResimStep)
 	{
-		PhysicsDataVehicles.FindOrAdd(AsyncInput->VehiclesToAdd[i]);
+		RestoreHistory_Internal();
 	}
-	for (int32 i = 0; i < AsyncInput->VehiclesToRemove.Num(); ++i)
+	else
 	{
-		PhysicsDataVehicles.Remove(AsyncInput->VehiclesToRemove[i]);	
+		ConsumeInput_Internal(*AsyncInput, Step);
 	}
 
-	const int32 NumVehicles = AsyncInput->VehicleConfigs.Num();
-	if (NumVehicles == 0) return;
-	ensureMsgf(NumVehicles == PhysicsDataVehicles.Num(), TEXT("Physics data mismatch !!"));
+	const int32 NumVehicles = AsyncInput->Vehicles.Num();
+	if (NumVehicles == 0)
+	{
+		PublishEmptyStep_Internal(*AsyncInput, Step, true);
+		return;
+	}
 
 	// 3) Solver access & handle discovery.
 	Chaos::FPhysicsSolverBase* ChaosBaseSolver = GetSolver();
@@ -58,125 +642,324 @@ void FSWPAsyncCallback::OnPreSimulate_Internal()
 	Chaos::FPhysicsSolver* ChaosSolver = static_cast<Chaos::FPhysicsSolver*>(ChaosBaseSolver);
 	if (!ChaosSolver) return;
 
-	// Current snapshot of particle handles. We scan it below to resolve rigid handles by FUniqueIdx.
-	const auto& Handles = ChaosSolver->GetParticles().GetParticleHandles();
-	const int32 NumHandles = static_cast<int32>(Handles.Size());
-	
-	// Build a compact array of PT per-vehicle pointers aligned with VehicleConfigs order.
-	PhysicsSortedDataVehicles.SetNumUninitialized(NumVehicles);
+	// Resolve the rigid handles of vehicles that have none (just admitted, or body recreated/migrated) by
+	// FUniqueIdx: all of them in one pass over the particles, so a bulk admission costs one scan, not one per vehicle.
+	UnboundVehicles.Reset();
 	for (int32 i = 0; i < NumVehicles; ++i)
 	{
-		const FSWPVehicleConfig& Config = AsyncInput->VehicleConfigs[i];
+		const FSWPVehiclePacket& Packet = AsyncInput->Vehicles[i];
+		if (!PhysicsDataVehicles.IsValidIndex(Packet.Slot)) continue;
 
-		FSWPVehiclePhysicsData* PhysicsData = PhysicsDataVehicles.Find(Config.Guid);
-		ensureMsgf(PhysicsData != nullptr, TEXT("Physics data not found !!"));
-		if (!PhysicsData) continue;
+		FSWPVehiclePhysicsData& PhysicsData = PhysicsDataVehicles[Packet.Slot];
+		if (!PhysicsData.bAdmitted || PhysicsData.Generation != Packet.Generation) continue;
 
-		PhysicsData->PhysicsIdx = Config.PhysicsIdx;
+		PhysicsData.PhysicsIdx = Chaos::FUniqueIdx(Packet.PhysicsIdx);
 
 		// Invalidate cached handle if the UniqueIdx changed (body was recreated/migrated).
-		if (PhysicsData->PhysicsHandle && PhysicsData->PhysicsHandle->UniqueIdx() != PhysicsData->PhysicsIdx)
+		if (PhysicsData.PhysicsHandle && PhysicsData.PhysicsHandle->UniqueIdx() != PhysicsData.PhysicsIdx)
 		{
-			PhysicsData->PhysicsHandle = nullptr;
+			PhysicsData.PhysicsHandle = nullptr;
 		}
-
-		// Resolve rigid handle if missing (PT-safe).
-		if (!PhysicsData->PhysicsHandle && PhysicsData->PhysicsIdx.IsValid())
+		if (!PhysicsData.PhysicsHandle && PhysicsData.PhysicsIdx.IsValid())
 		{
-			for (int32 k = 0; k < NumHandles; ++k)
-			{
-				Chaos::FGeometryParticleHandle* P = Handles.Handle(k).Get();
-				if (!P) continue;
+			UnboundVehicles.Add(PhysicsData.PhysicsIdx.Idx, &PhysicsData);
+		}
+	}
+	if (UnboundVehicles.Num() > 0)
+	{
+		const auto& Handles = ChaosSolver->GetParticles().GetParticleHandles();
+		const int32 NumHandles = static_cast<int32>(Handles.Size());
+		for (int32 k = 0; k < NumHandles && UnboundVehicles.Num() > 0; ++k)
+		{
+			Chaos::FGeometryParticleHandle* P = Handles.Handle(k).Get();
+			if (!P) continue;
 
-				if (P->UniqueIdx() == PhysicsData->PhysicsIdx)
-				{
-					PhysicsData->PhysicsHandle = P->CastToRigidParticle();
-					break;
-				}
+			FSWPVehiclePhysicsData* PhysicsData = nullptr;
+			if (UnboundVehicles.RemoveAndCopyValue(P->UniqueIdx().Idx, PhysicsData))
+			{
+				PhysicsData->PhysicsHandle = P->CastToRigidParticle();
 			}
 		}
-		
-		PhysicsSortedDataVehicles[i] = PhysicsData;
+	}
+
+	// Snapshot states overwrite their vehicle before anything reads the chassis this step.
+	if (!bResimStep && PendingRestores.Num() > 0)
+	{
+		LoadRestores_Internal();
+	}
+	
+	// Build compact arrays of admitted vehicles (PT data + packet) in packet order.
+	// Vehicles still waiting for admission (or without a resolved handle) are skipped this step.
+	// Each gets a contiguous wheel range in the tire batch (prefix sum of the wheel counts).
+	PhysicsSortedDataVehicles.Reset(NumVehicles);
+	PhysicsSortedPackets.Reset(NumVehicles);
+	PhysicsSortedWheelBases.Reset(NumVehicles);
+	PhysicsSortedAutopilots.Reset();
+	int32 NumActiveWheels = 0;
+	int32 NumUnsettled = 0;
+	for (int32 i = 0; i < NumVehicles; ++i)
+	{
+		const FSWPVehiclePacket& Packet = AsyncInput->Vehicles[i];
+		FSWPVehiclePhysicsData* PhysicsData = PhysicsDataVehicles.IsValidIndex(Packet.Slot) ? &PhysicsDataVehicles[Packet.Slot] : nullptr;
+		if (!PhysicsData || !PhysicsData->bAdmitted || PhysicsData->Generation != Packet.Generation || !PhysicsData->PhysicsHandle)
+		{
+			++NumUnsettled;
+			continue;
+		}
+
+		// Wake here (serial): object state changes touch the island graph, not safe in the parallel step.
+		if (GSWP_KeepAwakeOnPT && PhysicsData->PhysicsHandle->ObjectState() == Chaos::EObjectStateType::Sleeping)
+		{
+			ChaosSolver->GetEvolution()->SetParticleObjectState(PhysicsData->PhysicsHandle, Chaos::EObjectStateType::Dynamic);
+		}
+
+		// Packets may lag one step behind GT (pipelined build): never push a body that is no longer simulated.
+		if (PhysicsData->PhysicsHandle->ObjectState() != Chaos::EObjectStateType::Dynamic) continue;
+
+		PhysicsSortedDataVehicles.Add(PhysicsData);
+		PhysicsSortedPackets.Add(&Packet);
+		PhysicsSortedWheelBases.Add(NumActiveWheels);
+		NumActiveWheels += Packet.NumWheels;
+
+		if (PhysicsData->SimState.Autopilot.IsEngaged())
+		{
+			PhysicsSortedAutopilots.Add(PhysicsSortedDataVehicles.Num() - 1);
+		}
+	}
+
+	const int32 NumActiveVehicles = PhysicsSortedDataVehicles.Num();
+	if (NumActiveVehicles == 0)
+	{
+		PublishEmptyStep_Internal(*AsyncInput, Step, NumUnsettled == 0);
+		return;
 	}
 
 	// Raw pointers for tight inner loop access (no bounds checks in the lambda).
 	FSWPVehiclePhysicsData** PhysicsData = PhysicsSortedDataVehicles.GetData();
-	const FSWPVehicleConfig* Configs = AsyncInput->VehicleConfigs.GetData();
+	const FSWPVehiclePacket* const* Packets = PhysicsSortedPackets.GetData();
+	const int32* WheelBases = PhysicsSortedWheelBases.GetData();
+	const FSWPWheelPacket* WheelPackets = AsyncInput->Wheels.GetData();
+
+	const bool bTireModel = GSWP_TireModel;
+	if (bTireModel)
+	{
+		Tires.SetNum(NumActiveWheels);
+	}
+
+	const bool bPowertrain = GSWP_Powertrain;
+	if (bPowertrain)
+	{
+		Powertrain.SetNum(NumActiveVehicles);
+	}
+
+	// Spatial hash: positions in parallel chunks, then the serial O(N) counting sort into buckets.
+	const bool bSpatialHash = GSWP_SpatialHash;
+	if (bSpatialHash)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_SpatialHashBuild);
+		SpatialHash.Reset(NumActiveVehicles, GSWP_SpatialHashCellSize);
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveVehicles, FSWPSpatialHash::BatchSize), [this, PhysicsData, NumActiveVehicles](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPSpatialHash::BatchSize;
+			const int32 End = FMath::Min(Begin + FSWPSpatialHash::BatchSize, NumActiveVehicles);
+			for (int32 i = Begin; i < End; ++i)
+			{
+				SpatialHash.SetPosition(i, FVector3f(PhysicsData[i]->PhysicsHandle->GetX()));
+			}
+		});
+		SpatialHash.Sort();
+	}
+
+	FSWPStepContext Context;
+	Context.World = World;
+	Context.DeltaTime = SimTime;
+	Context.Presets = Presets.GetData();
+	Context.SurfaceScales = SurfaceScales.GetData();
+	Context.SurfaceCache = &SurfaceCache;
+	Context.bResolveSurfaces = GSWP_SurfaceAware;
+	Context.bDeterministic = GSWP_Deterministic;
+	Context.Tires = bTireModel ? &Tires : nullptr;
+	Context.Powertrain = bPowertrain ? &Powertrain : nullptr;
+	Context.PowertrainPresets = PowertrainPresets.GetData();
+	Context.Neighbors = bSpatialHash ? &SpatialHash : nullptr;
+#if !UE_BUILD_SHIPPING
+	const FSWPDebugDrawSettings& DebugDrawSettings = SWP_GetDebugDrawSettings();
+	Context.DebugMask = DebugDrawSettings.bEnable ? DebugDrawSettings.Mask : 0;
+#endif
 
 	// 4) Prepare output packet for GT.
 	FSWPAsyncCallbackOutput& AsyncOutput = GetProducerOutputData_Internal();
 	AsyncOutput.Reset();
 	AsyncOutput.Timestamp = AsyncInput->Timestamp;			// optional versioning (helps skip stale)
-	AsyncOutput.VehicleOuts.SetNum(NumVehicles);
+	AsyncOutput.Step = Step;
+	AsyncOutput.PhysicsStep = ChaosSolver->GetCurrentFrame();
+	AsyncOutput.VehicleOuts.SetNum(NumActiveVehicles);
 	FSWPVehicleOut* Outs = AsyncOutput.VehicleOuts.GetData();
 
+	// Fleet snapshot: every vehicle as of the start of the step (before the autopilot and the vehicle step
+	// touch it), in parallel chunks writing into the ranges laid out by the wheel prefix sum. Deferred while
+	// any packet is still waiting for admission or its body: the GT resends the request with every input.
+	if (AsyncInput->bCaptureSnapshot && !bResimStep && NumUnsettled == 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_SnapshotCapture);
+
+		AsyncOutput.bSnapshot = true;
+		AsyncOutput.SnapshotVehicles.SetNumUninitialized(NumActiveVehicles);
+		AsyncOutput.SnapshotWheels.SetNumUninitialized(NumActiveWheels);
+		AsyncOutput.SnapshotCompressions.SetNumUninitialized(NumActiveWheels);
+		FSWPSnapshotVehicle* SnapshotVehicles = AsyncOutput.SnapshotVehicles.GetData();
+		FSWPWheelPacket* SnapshotWheels = AsyncOutput.SnapshotWheels.GetData();
+		float* SnapshotCompressions = AsyncOutput.SnapshotCompressions.GetData();
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveVehicles, FSWPFleetSnapshot::BatchSize),
+					 [Packets, WheelPackets, WheelBases, PhysicsData, NumActiveVehicles, SnapshotVehicles, SnapshotWheels, SnapshotCompressions](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPFleetSnapshot::BatchSize;
+			const int32 End = FMath::Min(Begin + FSWPFleetSnapshot::BatchSize, NumActiveVehicles);
+			for (int32 i = Begin; i < End; ++i)
+			{
+				FSWPFleetSnapshot::Capture(*Packets[i], WheelPackets, PhysicsData[i]->PhysicsHandle, PhysicsData[i]->SimState, WheelBases[i],
+										   SnapshotVehicles[i], SnapshotWheels, SnapshotCompressions);
+			}
+		});
+	}
+
+	// Autopilot stage: AI vehicles get this step's controls from the road graph (chunks of vehicles,
+	// each touching only its own state). Runs before the vehicle step, which consumes the controls.
+	const int32 NumAutopilots = PhysicsSortedAutopilots.Num();
+	if (GSWP_Autopilot && RoadGraph.IsValid() && NumAutopilots > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_AutopilotStage);
+		INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_AutopilotVehicles, NumAutopilots);
+
+		const FSWPRoadGraphData& Graph = *RoadGraph;
+		const int32* Autopilots = PhysicsSortedAutopilots.GetData();
+
+		// Planning pass first, up to the budget (in fleet order), one reused scratch per planner.
+		AutopilotReplans.Reset();
+		const int32 MaxReplans = GSWP_MaxReplansPerStep > 0 ? GSWP_MaxReplansPerStep : NumAutopilots;
+		for (int32 k = 0; k < NumAutopilots && AutopilotReplans.Num() < MaxReplans; ++k)
+		{
+			if (PhysicsData[Autopilots[k]]->SimState.Autopilot.bReplan)
+			{
+				AutopilotReplans.Add(Autopilots[k]);
+			}
+		}
+
+		if (AutopilotReplans.Num() > 0)
+		{
+			if (RouteScratch.Num() < AutopilotReplans.Num())
+			{
+				RouteScratch.SetNum(AutopilotReplans.Num());
+			}
+
+			const int32* Replans = AutopilotReplans.GetData();
+			FSWPRouteScratch* Scratch = RouteScratch.GetData();
+			SWP_RunStage(AutopilotReplans.Num(), [&Graph, Replans, Scratch, PhysicsData](int32 r)
+			{
+				const int32 i = Replans[r];
+				FSWPAutopilotSolver::Plan(Graph, PhysicsData[i]->PhysicsHandle, Scratch[r], PhysicsData[i]->SimState.Autopilot);
+			});
+		}
+
+		SWP_RunStage(FMath::DivideAndRoundUp(NumAutopilots, FSWPAutopilotSolver::BatchSize),
+					 [&Graph, &Context, Autopilots, NumAutopilots, Packets, WheelPackets, PhysicsData, SimTime](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPAutopilotSolver::BatchSize;
+			const int32 End = FMath::Min(Begin + FSWPAutopilotSolver::BatchSize, NumAutopilots);
+			for (int32 k = Begin; k < End; ++k)
+			{
+				const int32 i = Autopilots[k];
+				FSWPVehicleState& SimState = PhysicsData[i]->SimState;
+				FSWPAutopilotSolver::Solve(Graph, Context.Neighbors, i, PhysicsData[i]->PhysicsHandle, *Packets[i], WheelPackets, SimTime,
+										   SimState.Autopilot, SimState.Controls);
+			}
+		});
+	}
+	else
+	{
+		// Stage off (or no graph): engaged vehicles are not driven, their last throttle/steering must not stick.
+		for (const int32 i : PhysicsSortedAutopilots)
+		{
+			FSWPVehicleControls& Controls = PhysicsData[i]->SimState.Controls;
+			Controls.Throttle = 0.0f;
+			Controls.Steering = 0.0f;
+		}
+	}
+
+	const int32 NumPublishedNeighbors = Context.Neighbors ? FMath::Clamp(GSWP_PublishNeighbors, 0, FSWPVehicleOut::MaxNeighbors) : 0;
+	const float NeighborRadius = GSWP_NeighborRadius;
+	const bool bNetStates = AsyncInput->bNetStates;
+
+	// Per-vehicle step shared by both execution paths. Each iteration touches only its own slot.
+	auto StepVehicle = [&Context, Packets, WheelBases, WheelPackets, PhysicsData, Outs, NumPublishedNeighbors, NeighborRadius, bNetStates](int32 i)
+	{
+		FSWPVehiclePhysicsData* VehiclePhysicsData = PhysicsData[i];
+		const FSWPVehiclePacket& VehiclePacket = *Packets[i];
+		Chaos::FPBDRigidParticleHandle* Chassis = VehiclePhysicsData->PhysicsHandle;
+
+		FSWPVehicleOut& VehicleOut = Outs[i];
+		VehicleOut.Slot = { VehiclePacket.Slot, VehiclePacket.Generation };
+		VehicleOut.ChassisTransform = FTransform(Chassis->GetR(), Chassis->GetX());
+
+		if (NumPublishedNeighbors > 0)
+		{
+			TArray<FSWPSpatialHash::FNeighbor, TInlineAllocator<FSWPVehicleOut::MaxNeighbors>> Nearest;
+			Context.Neighbors->FindNearest(Context.Neighbors->GetPosition(i), NeighborRadius, NumPublishedNeighbors, i, Nearest);
+			for (const FSWPSpatialHash::FNeighbor& Neighbor : Nearest)
+			{
+				const FSWPVehiclePacket& NeighborPacket = *Packets[Neighbor.Index];
+				VehicleOut.Neighbors.Add({ NeighborPacket.Slot, NeighborPacket.Generation });
+			}
+		}
+
+		// Wheel-count specialized kernel (4/6/8 unrolled, generic otherwise), timed per contact mode.
+		switch (VehiclePacket.ContactMode)
+		{
+		case ESWPContactMode::RayFan:
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_VehicleStepRayFan);
+			INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_QueriesRayFan, VehiclePacket.NumWheels * FSWPSuspensionSolver::NumFanRays);
+			FSWPVehicleSolver::Step(Context, Chassis, VehiclePacket, WheelPackets, i, WheelBases[i], VehiclePhysicsData->SimState, VehicleOut);
+			break;
+		}
+		case ESWPContactMode::Sweep:
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_VehicleStepSweep);
+			INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_QueriesSweep, VehiclePacket.NumWheels);
+			FSWPVehicleSolver::Step(Context, Chassis, VehiclePacket, WheelPackets, i, WheelBases[i], VehiclePhysicsData->SimState, VehicleOut);
+			break;
+		}
+		default:
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_VehicleStepRay);
+			INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_QueriesRay, VehiclePacket.NumWheels);
+			FSWPVehicleSolver::Step(Context, Chassis, VehiclePacket, WheelPackets, i, WheelBases[i], VehiclePhysicsData->SimState, VehicleOut);
+			break;
+		}
+		}
+
+		// Replication: pose/velocities of the step start with this step's compressions, dirty bits against the previous step.
+		if (bNetStates)
+		{
+			FSWPVehicleState& SimState = VehiclePhysicsData->SimState;
+			VehicleOut.NetState = FSWPNetVehicleState::Make(VehicleOut.ChassisTransform, Chassis->GetV(), Chassis->GetW(), SimState.Suspensions);
+			VehicleOut.NetDirty = VehicleOut.NetState.Compare(SimState.NetState);
+			SimState.NetState = VehicleOut.NetState;
+			VehicleOut.Controls = SimState.Controls;
+			VehicleOut.AutopilotDestination = SimState.Autopilot.Destination;
+			VehicleOut.AutopilotCruiseSpeed = SimState.Autopilot.CruiseSpeed;
+		}
+	};
+
 	// 5) Execute per-vehicle step: single-thread or parallel.
 	if (GSWP_ForceSingleThread)
 	{
 		// Single-thread path: useful to compare against the parallel variant.
 		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_ChaosSingleThread);
 		{
-			for (int k = 0; k < NumVehicles; ++k)
-			{
-				FSWPVehiclePhysicsData* VehiclePhysicsData = PhysicsData[k];
-				ensureMsgf(VehiclePhysicsData != nullptr, TEXT("Physics data not found in Chaos::PhysicsParallelFor() !!"));
-				if (!VehiclePhysicsData) return;
-
-				const FSWPVehicleConfig& VehicleConfig = Configs[k];
-				FSWPVehicleState& VehicleSimState = VehiclePhysicsData->SimState;
-				
-				
-				Chaos::FPBDRigidParticleHandle* Chassis = VehiclePhysicsData->PhysicsHandle;
-				ensureMsgf(Chassis != nullptr, TEXT("PhysicsHandle not found in Chaos::PhysicsParallelFor() !!"));
-				if (!Chassis) return;
-
-				FSWPVehicleOut& VehicleOut = Outs[k];
-				VehicleOut.Guid = VehicleConfig.Guid;
-
-				const FTransform ChassisTransformWorld = FTransform(Chassis->GetR(), Chassis->GetX());
-
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.FrontLeftSuspension,
-					VehicleSimState.FrontLeftSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.FrontRightSuspension,
-					VehicleSimState.FrontRightSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.RearLeftSuspension,
-					VehicleSimState.RearLeftSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.RearRightSuspension,
-					VehicleSimState.RearRightSuspension,
-					VehicleOut,
-					SimTime);
-
-				// PT-safe force application via Chaos API (no UObjects involved).
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.FrontLeftSuspension.ForceLocation,
-					VehicleSimState.FrontLeftSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.FrontRightSuspension.ForceLocation,
-					VehicleSimState.FrontRightSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.RearLeftSuspension.ForceLocation,
-					VehicleSimState.RearLeftSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.RearRightSuspension.ForceLocation,
-					VehicleSimState.RearRightSuspension.Fz * 100.0f);
+			for (int32 k = 0; k < NumActiveVehicles; ++k)
+			{
+				StepVehicle(k);
 			}
 		}
 	}
@@ -186,69 +969,243 @@ void FSWPAsyncCallback::OnPreSimulate_Internal()
 		// Uses Chaos' worker pool and returns only after all iterations complete.
 		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_ChaosParallelFor);
 		{
-			Chaos::PhysicsParallelFor(NumVehicles, [World, SimTime, Configs, PhysicsData, Outs, this](int32 i)
-			{
-				FSWPVehiclePhysicsData* VehiclePhysicsData = PhysicsData[i];
-				ensureMsgf(VehiclePhysicsData != nullptr, TEXT("Physics data not found in Chaos::PhysicsParallelFor() !!"));
-				if (!VehiclePhysicsData) return;
-
-				const FSWPVehicleConfig& VehicleConfig = Configs[i];
-				FSWPVehicleState& VehicleSimState = VehiclePhysicsData->SimState;
-				
-				
-				Chaos::FPBDRigidParticleHandle* Chassis = VehiclePhysicsData->PhysicsHandle;
-				ensureMsgf(Chassis != nullptr, TEXT("PhysicsHandle not found in Chaos::PhysicsParallelFor() !!"));
-				if (!Chassis) return;
-
-				FSWPVehicleOut& VehicleOut = Outs[i];
-				VehicleOut.Guid = VehicleConfig.Guid;
-
-				const FTransform ChassisTransformWorld = FTransform(Chassis->GetR(), Chassis->GetX());
-
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.FrontLeftSuspension,
-					VehicleSimState.FrontLeftSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.FrontRightSuspension,
-					VehicleSimState.FrontRightSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.RearLeftSuspension,
-					VehicleSimState.RearLeftSuspension,
-					VehicleOut,
-					SimTime);
-				FSWPSuspensionSolver::Compute(World,
-					VehicleConfig.VehicleActor,
-					ChassisTransformWorld,
-					VehicleConfig.RearRightSuspension,
-					VehicleSimState.RearRightSuspension,
-					VehicleOut,
-					SimTime);
-
-				// PT-safe force application via Chaos API (no UObjects involved).
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.FrontLeftSuspension.ForceLocation,
-					VehicleSimState.FrontLeftSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.FrontRightSuspension.ForceLocation,
-					VehicleSimState.FrontRightSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.RearLeftSuspension.ForceLocation,
-					VehicleSimState.RearLeftSuspension.Fz * 100.0f);
-				FSWPPhysicsUtility::AddForceAtLocation(Chassis,
-					VehicleSimState.RearRightSuspension.ForceLocation,
-					VehicleSimState.RearRightSuspension.Fz * 100.0f);
-				
-			}, false);
+			Chaos::PhysicsParallelFor(NumActiveVehicles, StepVehicle, false);
+		}
+	}
+
+	// Sensors: timers and scan list (serial), then every due ray as one flat list in fixed-size chunks. A stage
+	// of its own after the vehicle step (not part of the per-vehicle suspension traces, so a dense lidar is not
+	// tied to its vehicle's task); the scene is the same, since Chaos has not integrated this step's forces yet.
+	if (GSWP_Sensors)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_SensorStage);
+
+		SensorScans.Reset();
+		int32 NumSensorRays = 0;
+		const int32 FirstUpdate = AsyncOutput.SensorUpdates.Num();
+		for (int32 i = 0; i < NumActiveVehicles; ++i)
+		{
+			const FSWPVehiclePacket& Packet = *Packets[i];
+			if (!SensorRigs.IsValidIndex(Packet.SensorRigIndex)) continue;
+
+			const FSWPSensorRig& Rig = SensorRigs[Packet.SensorRigIndex];
+			FSWPVehicleState& SimState = PhysicsData[i]->SimState;
+			if (SimState.SensorRanges.Num() != Rig.NumRanges || SimState.SensorTimers.Num() != Rig.NumSensors)
+			{
+				// New rig: no ranges yet. First scans are phase-shifted by slot so a fleet does not scan on the same step.
+				SimState.SensorRanges.Init(FSWPSensorRig::NoHit, Rig.NumRanges);
+				SimState.SensorTimers.SetNumUninitialized(Rig.NumSensors);
+				const float Phase = FMath::Frac(Packet.Slot * 0.618034f);
+				for (int32 s = 0; s < Rig.NumSensors; ++s)
+				{
+					SimState.SensorTimers[s] = Rig.Sensors[s].Interval * Phase;
+				}
+			}
+
+			const Chaos::FPBDRigidParticleHandle* Chassis = PhysicsData[i]->PhysicsHandle;
+			const FTransform ChassisTransform(Chassis->GetR(), Chassis->GetX());
+			for (int32 s = 0; s < Rig.NumSensors; ++s)
+			{
+				float& Timer = SimState.SensorTimers[s];
+				Timer -= SimTime;
+				if (Timer > 0.0f) continue;
+
+				const FSWPSensorRig::FSensor& Sensor = Rig.Sensors[s];
+				Timer = FMath::Max(Timer + Sensor.Interval, 0.0f);
+
+				FSWPSensorScan& Scan = SensorScans.AddDefaulted_GetRef();
+				Scan.Vehicle = &Packet;
+				Scan.Sensor = &Sensor;
+				Scan.Ranges = SimState.SensorRanges.GetData() + Sensor.FirstRange;
+				Scan.Origin = ChassisTransform.TransformPosition(FVector(Sensor.Location));
+				Scan.ChassisRotation = ChassisTransform.GetRotation();
+				Scan.FirstRay = NumSensorRays;
+				NumSensorRays += Sensor.NumRanges();
+
+				FSWPSensorRangesOut& Update = AsyncOutput.SensorUpdates.AddDefaulted_GetRef();
+				Update.Slot = FSWPVehicleSlot{ Packet.Slot, Packet.Generation };
+				Update.NumRigRanges = Rig.NumRanges;
+				Update.FirstRange = Sensor.FirstRange;
+				Update.NumRanges = Sensor.NumRanges();
+			}
+
+		}
+
+		INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_SensorRays, NumSensorRays);
+		const TArrayView<const FSWPSensorScan> Scans = SensorScans;
+		SWP_RunStage(FMath::DivideAndRoundUp(NumSensorRays, FSWPSensorSolver::BatchSize), [&Context, Scans, NumSensorRays](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPSensorSolver::BatchSize;
+			FSWPSensorSolver::TraceRange(Context, Scans, Begin, FMath::Min(Begin + FSWPSensorSolver::BatchSize, NumSensorRays));
+		});
+
+		// Publish only what was scanned this step: the GT keeps every sensor's latest ranges.
+		const int32 FirstValue = AsyncOutput.SensorRanges.Num();
+		AsyncOutput.SensorRanges.AddUninitialized(NumSensorRays);
+		for (int32 k = 0; k < SensorScans.Num(); ++k)
+		{
+			FSWPSensorRangesOut& Update = AsyncOutput.SensorUpdates[FirstUpdate + k];
+			Update.FirstValue = FirstValue + SensorScans[k].FirstRay;
+			FMemory::Memcpy(AsyncOutput.SensorRanges.GetData() + Update.FirstValue, SensorScans[k].Ranges, Update.NumRanges * sizeof(uint16));
 		}
 	}
+
+	// 6) Batched fleet stages over contiguous SoA buffers (fixed-size chunks): powertrain/aero per
+	// vehicle, then tires per wheel, then each vehicle applies all of its forces at once.
+	// Every stage only touches its own vehicle/wheel range.
+	if (bPowertrain)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_PowertrainStage);
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveVehicles, FSWPPowertrainSolver::BatchSize), [&Context, NumActiveVehicles](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPPowertrainSolver::BatchSize;
+			FSWPPowertrainSolver::SolveRange(*Context.Powertrain, Context.PowertrainPresets, Context.Tires, Begin,
+											 FMath::Min(Begin + FSWPPowertrainSolver::BatchSize, NumActiveVehicles));
+		});
+	}
+
+	if (bTireModel)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_TireStage);
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveWheels, FSWPTireSolver::BatchSize), [this, NumActiveWheels](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPTireSolver::BatchSize;
+			FSWPTireSolver::SolveRange(Tires, Begin, FMath::Min(Begin + FSWPTireSolver::BatchSize, NumActiveWheels));
+		});
+	}
+
+	if (Context.DefersApply())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_ApplyStage);
+		SWP_RunStage(NumActiveVehicles, [&Context, Packets, WheelBases, PhysicsData, Outs](int32 i)
+		{
+			FSWPVehicleSolver::ApplyForces(Context, PhysicsData[i]->PhysicsHandle, i, WheelBases[i], Packets[i]->NumWheels,
+										   PhysicsData[i]->SimState, Outs[i]);
+		});
+	}
+
+	// Rewind history: every vehicle saves its own records (arena grown serially first, never per step).
+	if (History.IsEnabled() && PhysicsStep != INDEX_NONE)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_HistorySave);
+
+		int32 MaxWheels = 0;
+		for (int32 i = 0; i < NumActiveVehicles; ++i)
+		{
+			MaxWheels = FMath::Max(MaxWheels, Packets[i]->NumWheels);
+		}
+		History.Reserve(PhysicsDataVehicles.Num(), MaxWheels);
+
+		const int32 SavedStep = PhysicsStep;
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveVehicles, FSWPStateHistory::BatchSize), [this, Packets, PhysicsData, NumActiveVehicles, SavedStep](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPStateHistory::BatchSize;
+			const int32 End = FMath::Min(Begin + FSWPStateHistory::BatchSize, NumActiveVehicles);
+			for (int32 i = Begin; i < End; ++i)
+			{
+				History.Save(SavedStep, Packets[i]->Slot, Packets[i]->Generation, PhysicsData[i]->SimState);
+			}
+		});
+	}
+
+	// Lockstep checksum: each vehicle hashes its own state in parallel, then the hashes are summed. The sum
+	// is order-independent: the local vehicle order follows this peer's spawn/despawn history, not the step's.
+	if (Context.bDeterministic)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_StateChecksum);
+
+		VehicleChecksums.SetNumUninitialized(NumActiveVehicles, EAllowShrinking::No);
+		uint32* Checksums = VehicleChecksums.GetData();
+		const FSWPPowertrainBatch* PowertrainBatch = bPowertrain ? &Powertrain : nullptr;
+		SWP_RunStage(FMath::DivideAndRoundUp(NumActiveVehicles, FSWPDeterminism::BatchSize), [Checksums, PhysicsData, PowertrainBatch, NumActiveVehicles](int32 Chunk)
+		{
+			const int32 Begin = Chunk * FSWPDeterminism::BatchSize;
+			const int32 End = FMath::Min(Begin + FSWPDeterminism::BatchSize, NumActiveVehicles);
+			for (int32 i = Begin; i < End; ++i)
+			{
+				Checksums[i] = FSWPDeterminism::HashVehicle(PhysicsData[i]->PhysicsHandle, PhysicsData[i]->SimState, PowertrainBatch, i);
+			}
+		});
+
+		uint32 StateChecksum = 0;
+		for (int32 i = 0; i < NumActiveVehicles; ++i)
+		{
+			StateChecksum += Checksums[i];
+		}
+		AsyncOutput.StateChecksum = StateChecksum;
+	}
+
+	// Forward predictions: pose ranges reserved serially, then one task per request on a scratch copy
+	// of its vehicle (after the vehicle step: the suspension states and contacts are this step's).
+	// With swp.Prediction off, every pending request is answered with an empty result instead.
+	if (PendingPredictions.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_PredictionStage);
+
+		const bool bPrediction = GSWP_Prediction;
+		const int32 NumPredictions = bPrediction && GSWP_MaxPredictionsPerStep > 0 ? FMath::Min(PendingPredictions.Num(), GSWP_MaxPredictionsPerStep) : PendingPredictions.Num();
+		if (bPrediction)
+		{
+			// Slot -> sorted index, for the request lookups below.
+			PhysicsSortedIndices.Init(INDEX_NONE, PhysicsDataVehicles.Num());
+			for (int32 i = 0; i < NumActiveVehicles; ++i)
+			{
+				PhysicsSortedIndices[Packets[i]->Slot] = i;
+			}
+		}
+
+		PredictionVehicles.Reset(NumPredictions);
+		for (int32 k = 0; k < NumPredictions; ++k)
+		{
+			// Vehicles not simulated this step (removed, pooled, not admitted yet) get an empty result.
+			FSWPPredictionRequest& Request = PendingPredictions[k];
+			int32 VehicleIndex = INDEX_NONE;
+			if (bPrediction && PhysicsSortedIndices.IsValidIndex(Request.Slot))
+			{
+				const FSWPVehiclePhysicsData& VehiclePhysicsData = PhysicsDataVehicles[Request.Slot];
+				if (VehiclePhysicsData.bAdmitted && VehiclePhysicsData.Generation == Request.Generation)
+				{
+					VehicleIndex = PhysicsSortedIndices[Request.Slot];
+				}
+			}
+			Request.NumSteps = FMath::Clamp(Request.NumSteps, 1, FMath::Max(GSWP_MaxPredictionSteps, 1));
+			Request.SampleEvery = FMath::Clamp(Request.SampleEvery, 1, Request.NumSteps);
+
+			FSWPPredictionOut& PredictionOut = AsyncOutput.Predictions.AddDefaulted_GetRef();
+			PredictionOut.RequestId = Request.RequestId;
+			PredictionOut.FirstPose = AsyncOutput.PredictedPoses.Num();
+			PredictionOut.NumPoses = VehicleIndex != INDEX_NONE ? Request.NumSteps / Request.SampleEvery : 0;
+			AsyncOutput.PredictedPoses.AddUninitialized(PredictionOut.NumPoses);
+			PredictionVehicles.Add(VehicleIndex);
+		}
+
+		INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_Predictions, NumPredictions);
+		const FSWPPredictionRequest* Requests = PendingPredictions.GetData();
+		const int32* Vehicles = PredictionVehicles.GetData();
+		FSWPPredictionOut* PredictionOuts = AsyncOutput.Predictions.GetData();
+		FTransform* Poses = AsyncOutput.PredictedPoses.GetData();
+		const float GravityZ = AsyncInput->GravityZ;
+		SWP_RunStage(NumPredictions, [&Context, Requests, Vehicles, PredictionOuts, Poses, Packets, WheelPackets, PhysicsData, GravityZ](int32 k)
+		{
+			const int32 i = Vehicles[k];
+			if (i == INDEX_NONE) return;
+
+			FSWPPredictionOut& PredictionOut = PredictionOuts[k];
+			if (!FSWPPredictionSolver::Predict(Context, PhysicsData[i]->PhysicsHandle, *Packets[i], WheelPackets, PhysicsData[i]->SimState,
+											   Requests[k], GravityZ, Poses + PredictionOut.FirstPose))
+			{
+				PredictionOut.NumPoses = 0;
+			}
+		});
+
+		PendingPredictions.RemoveAt(0, NumPredictions, EAllowShrinking::No);
+	}
+
+	// 7) Serial merge of the surface cache misses (the cache was read-only during the step).
+	for (int32 k = 0; k < NumActiveVehicles; ++k)
+	{
+		TArray<FSWPSurfaceCache::FEntry>& NewSurfaces = PhysicsData[k]->SimState.NewSurfaces;
+		SurfaceCache.Merge(NewSurfaces, GSWP_SurfaceCacheMaxEntries);
+		NewSurfaces.Reset();
+	}
 }
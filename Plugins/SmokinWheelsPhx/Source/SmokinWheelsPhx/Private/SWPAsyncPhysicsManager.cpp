@@ -3,10 +3,14 @@
 #include "SWPAsyncPhysicsManager.h"
 #include "PBDRigidsSolver.h"
 #include "SWPAsyncCallback.h"
+#include "SWPFleetReplicator.h"
+#include "SWPFleetVisualizer.h"
+#include "SWPPowertrainPreset.h"
+#include "SWPRewindCallback.h"
+#include "SWPRoadGraph.h"
 #include "SWPStat.h"
-#include "SWPSuspension.h"
+#include "SWPSurfaceTable.h"
 #include "SWPVehicle.h"
-#include "Configs/SWPVehicleConfig.h"
 #include "Debug/SWPDebugDrawCVars.h"
 #include "Debug/SWPDebugDrawExec.h"
 #include "Physics/Experimental/PhysScene_Chaos.h"
@@ -15,6 +19,8 @@
 // Show with 'stat SmokinWheelsPhx' in the UE console
 DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:ScenePreTick"), STAT_SmokinWheelsPhx_ScenePreTick, STATGROUP_SmokinWheelsPhx);
 DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:ScenePostTick"), STAT_SmokinWheelsPhx_ScenePostTick, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:BuildInputPacket"), STAT_SmokinWheelsPhx_BuildInputPacket, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:WaitInputPacket"), STAT_SmokinWheelsPhx_WaitInputPacket, STATGROUP_SmokinWheelsPhx);
 
 FDelegateHandle FSWPAsyncPhysicsManager::OnPostWorldInitializationHandle;
 FDelegateHandle FSWPAsyncPhysicsManager::OnWorldCleanupHandle;
@@ -43,11 +49,20 @@ FSWPAsyncPhysicsManager::FSWPAsyncPhysicsManager(FPhysScene* InPhysScene)
 
 FSWPAsyncPhysicsManager::~FSWPAsyncPhysicsManager()
 {
-	// Proactively flush GT-side vehicle registry (WeakObjectPtrs).
-	while (Vehicles.Num() > 0)
+	// Proactively flush GT-side vehicle registry (WeakObjectPtrs). Linear, no per-vehicle removal.
+	for (const TWeakObjectPtr<ASWPVehicle>& Vehicle : Vehicles.GetVehicles())
 	{
-		RemoveVehicle(Vehicles.Last());
+		if (Vehicle.IsValid())
+			Vehicle->SetRegistryIndex(INDEX_NONE);
 	}
+	Vehicles.Reset();
+	ExternalVehicles.Reset();
+	Slots.Reset();
+
+	// The build task reads the mirror: let it finish before the manager goes away.
+	BuildTask.Wait();
+	Mirror.Reset();
+	PendingMirrorEdits.Reset();
 
 	// Detach GT delegates and PT sim-callback.
 	UnregisterCallbacks();
@@ -118,14 +133,44 @@ void FSWPAsyncPhysicsManager::UnregisterCallbacks()
 		OnPhysScenePostTickHandle.Reset();
 	}
 	
+	// No background build may outlive the callbacks.
+	BuildTask.Wait();
+
+	// Release the cached output before the callback object that owns it goes away.
+	LatestOutput.Reset();
+	LatestOutIndices.Reset();
+	SensorRanges.Reset();
+	StepChecksums.Reset();
+	LatestStep = INDEX_NONE;
+	
 	if(AsyncObject != nullptr)
 	{
 		if (Chaos::FPhysicsSolver* Solver = PhysScene.GetSolver())
 		{
+			// The rewind callback points at the callback object: it goes first.
+			if (bRewindCallbackInstalled)
+			{
+				Solver->SetRewindCallback(TUniquePtr<Chaos::IRewindCallback>());
+			}
 			Solver->UnregisterAndFreeSimCallbackObject_External(AsyncObject);
 		}
+		bRewindCallbackInstalled = false;
+		RewindHistoryFrames = 0;
 		
 		AsyncObject = nullptr;
+		ControlBacklog.Reset();
+		Presets.ResetUploads();
+		Powertrains.ResetUploads();
+		SensorRigs.ResetUploads();
+		bSurfaceScalesDirty = SurfaceScales.Num() > 0;
+		bRoadGraphDirty = RoadGraph.IsValid();
+		AutopilotCommands.Reset();
+		PredictionRequests.Reset();
+		SuspensionCorrections.Reset();
+		CorrectedCompressions.Reset();
+		bSnapshotRequested = false;
+		VehicleRestores.Reset();
+		RestoredCompressions.Reset();
 	}
 }
 
@@ -153,48 +198,83 @@ void FSWPAsyncPhysicsManager::ScenePreTick(FPhysScene* InPhysScene, float DeltaT
 	// NOTE: Passing UWorld to PT is a conscious compromise for now.
 	// For a "PT-pure" step, prefer Chaos scene queries instead of UWorld line traces.
 	AsyncInput->CurrentWorld = World;
-	AsyncInput->VehicleConfigs.Reserve(Vehicles.Num());
-	AsyncInput->VehiclesToAdd.Reserve(VehiclesToAdd.Num());
-	AsyncInput->VehiclesToRemove.Reserve(VehiclesToRemove.Num());
-	//AsyncInput->Timestamp = Timestamp;
+	AsyncInput->Timestamp = Timestamp;
 
-	if (World)
+	// Control samples stamped up to this frame must be in the ring before the input is published.
+	FlushControlBacklog();
+
+	// Publish the packet built in the background since the previous pre-tick (normally already
+	// complete, so this does not block). Swapping hands the packet's old buffer back for reuse.
 	{
-		// Snapshot per-vehicle config (POD only). No UObject deref will be done on PT.
-		for (TWeakObjectPtr<ASWPVehicle> Vehicle : Vehicles)
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_WaitInputPacket);
+		BuildTask.Wait();
+	}
+	Swap(AsyncInput->Vehicles, StagedVehicles);
+	Swap(AsyncInput->Wheels, StagedWheels);
+
+	// Presets interned so far (covers every packet built up to now: edits intern at queue time).
+	Presets.CollectUploads(AsyncInput->PresetsToUpload);
+	Powertrains.CollectUploads(AsyncInput->PowertrainPresetsToUpload);
+	SensorRigs.CollectUploads(AsyncInput->SensorRigsToUpload);
+
+	if (bSurfaceScalesDirty)
+	{
+		AsyncInput->SurfaceScales = SurfaceScales;
+		bSurfaceScalesDirty = false;
+	}
+
+	if (bRoadGraphDirty)
+	{
+		AsyncInput->RoadGraph = RoadGraph;
+		bRoadGraphDirty = false;
+	}
+
+	// Mirror is not shared now: fold in GT edits, then start building the next packet.
+	// A mirror entry owns the preset references of its packet: the replaced/removed one gives them back.
+	for (const FSWPVehicleMirrorEdit& Edit : PendingMirrorEdits)
+	{
+		const FSWPVehiclePacket* Previous = Edit.Op != ESWPVehicleMirrorOp::SetActive ? Mirror.Find(Edit.Slot) : nullptr;
+		if (Previous)
 		{
-			if (!Vehicle.IsValid()) continue;
-			
-			FSWPVehicleConfig Config
-			{
-				Vehicle->GetGuid(),										// Gameplay ID (FGuid)
-				GetChaosUniqueIdx(Vehicle->GetBodyInstance()),		// Solver particle ID (FUniqueIdx)
-				Vehicle,												// Weak reference (GT-only)
-				BuildSuspensionCfg(Vehicle->GetFrontLeftSuspension()),
-				BuildSuspensionCfg(Vehicle->GetFrontRightSuspension()),
-				BuildSuspensionCfg(Vehicle->GetRearLeftSuspension()),
-				BuildSuspensionCfg(Vehicle->GetRearRightSuspension())
-			};
-			
-			AsyncInput->VehicleConfigs.Add(Config);
+			ReleaseTunings(*Previous, Mirror.GetWheels(*Previous));
 		}
+		Mirror.Apply(Edit);
 	}
+	PendingMirrorEdits.Reset();
+	LaunchInputBuild();
 
 	// Publish add/remove sets (will be applied by PT at the beginning of the step).
-	for (FGuid IdToAdd : VehiclesToAdd)
-	{
-		AsyncInput->VehiclesToAdd.Add(IdToAdd);
-	}
+	AsyncInput->VehiclesToAdd.Append(VehiclesToAdd);
 	VehiclesToAdd.Reset();
 	
-	for (FGuid IdToRemove : VehiclesToRemove)
-	{
-		AsyncInput->VehiclesToRemove.Add(IdToRemove);
-	}
+	AsyncInput->VehiclesToRemove.Append(VehiclesToRemove);
 	VehiclesToRemove.Reset();
 
-	// Optional frame counter increment (helps when skipping late outputs).
-	//++Timestamp;
+	AsyncInput->VehiclesToReset = VehiclesToReset;
+	VehiclesToReset.Reset();
+
+	AsyncInput->AutopilotCommands = AutopilotCommands;
+	AutopilotCommands.Reset();
+
+	AsyncInput->PredictionRequests = PredictionRequests;
+	AsyncInput->GravityZ = World->GetGravityZ();
+	AsyncInput->RewindHistoryFrames = RewindHistoryFrames;
+	PredictionRequests.Reset();
+
+	AsyncInput->bNetStates = FleetReplicator.IsValid() || bHibernation;
+	AsyncInput->SuspensionCorrections = SuspensionCorrections;
+	AsyncInput->CorrectedCompressions = CorrectedCompressions;
+	SuspensionCorrections.Reset();
+	CorrectedCompressions.Reset();
+
+	AsyncInput->bCaptureSnapshot = bSnapshotRequested;
+	AsyncInput->VehicleRestores = VehicleRestores;
+	AsyncInput->RestoredCompressions = RestoredCompressions;
+	VehicleRestores.Reset();
+	RestoredCompressions.Reset();
+
+	// Frame counter: control samples pushed from now on belong to the next input.
+	++Timestamp;
 }
 
 // GT ← PT: Consume all pending output packets produced by the PT callback.
@@ -211,6 +291,7 @@ void FSWPAsyncPhysicsManager::ScenePostTick(FChaosScene* InChaosScene)
 	// PT may produce more snapshots than GT consumes (PT usually runs faster).
 	// Drain the queue to keep debug info fresh and prevent backlog growth.
 	//while (Chaos::TSimCallbackOutputHandle<FGripRushAsyncCallbackOutput> OutH = AsyncObject->PopOutputData_External())
+	bool bNewOutput = false;
 	while (true)
 	{
 		Chaos::TSimCallbackOutputHandle<FSWPAsyncCallbackOutput> OutH = AsyncObject->PopOutputData_External();
@@ -224,18 +305,115 @@ void FSWPAsyncPhysicsManager::ScenePostTick(FChaosScene* InChaosScene)
 		{
 			FSWPDebugDrawExec::DrawVehicle(World, VehicleOut, SWP_GetDebugDrawSettings());
 		}
+
+		// Checksums are per step: keep every packet's, not only the newest (keyed by solver step, so resims overwrite).
+		if (Out->PhysicsStep >= 0)
+		{
+			if (StepChecksums.Num() != ChecksumHistorySize)
+			{
+				StepChecksums.SetNum(ChecksumHistorySize);
+			}
+			StepChecksums[Out->PhysicsStep % ChecksumHistorySize] = { Out->PhysicsStep, Out->StateChecksum };
+			LatestStep = Out->PhysicsStep;
+		}
+
+		// Predictions only travel in the output of the step that ran them: collect from every packet.
+		for (const FSWPPredictionOut& PredictionOut : Out->Predictions)
+		{
+			Predictions.Add(PredictionOut.RequestId, TArray<FTransform>(Out->PredictedPoses.GetData() + PredictionOut.FirstPose, PredictionOut.NumPoses));
+			Predictions.Remove(PredictionOut.RequestId - MaxUnclaimedPredictions);
+		}
+
+		// Sensor updates are per step too: merge every packet's, oldest first.
+		for (const FSWPSensorRangesOut& Update : Out->SensorUpdates)
+		{
+			if (Update.Slot.Index >= SensorRanges.Num())
+			{
+				SensorRanges.SetNum(Update.Slot.Index + 1);
+			}
+
+			FSensorRanges& Entry = SensorRanges[Update.Slot.Index];
+			if (Entry.Generation != Update.Slot.Generation || Entry.Ranges.Num() != Update.NumRigRanges)
+			{
+				Entry.Generation = Update.Slot.Generation;
+				Entry.Ranges.Init(FSWPSensorRig::NoHit, Update.NumRigRanges);
+			}
+			FMemory::Memcpy(Entry.Ranges.GetData() + Update.FirstRange, Out->SensorRanges.GetData() + Update.FirstValue, Update.NumRanges * sizeof(uint16));
+		}
+
+		// Snapshot: only in the output of the step that captured it (later duplicates of the same request are ignored).
+		// The GT preset tables are a superset of the PT's, with the same indices.
+		if (Out->bSnapshot && bSnapshotRequested)
+		{
+			FSWPFleetSnapshot::Write(Out->Step, Out->SnapshotVehicles, Out->SnapshotWheels, Out->SnapshotCompressions,
+									 Presets.GetPresets(), Powertrains.GetPresets(), SensorRigs.GetPresets(), CompletedSnapshot);
+
+			CompletedSnapshotGuids.Reset(Out->SnapshotVehicles.Num());
+			for (const FSWPSnapshotVehicle& SnapshotVehicle : Out->SnapshotVehicles)
+			{
+				const FGuid* Guid = Slots.ResolveGuid(SnapshotVehicle.State.Slot, SnapshotVehicle.State.Generation);
+				CompletedSnapshotGuids.Add(Guid ? *Guid : FGuid());
+			}
+			bSnapshotRequested = false;
+			bSnapshotReady = true;
+		}
+
+		// Replication dirty bits are per step as well.
+		if (FleetReplicator.IsValid())
+		{
+			FleetReplicator->ConsumeVehicleOuts(Out->VehicleOuts, Out->Step);
+		}
+
+		// Keep only the newest packet alive; the previous one goes back to the pool.
+		LatestOutput = MoveTemp(OutH);
+		bNewOutput = true;
+	}
+
+	// Refresh the GUID lookup used by FindLatestVehicleOut() (slot -> GUID, stale slots skipped).
+	if (bNewOutput)
+	{
+		LatestOutIndices.Reset();
+		const TArray<FSWPVehicleOut>& VehicleOuts = LatestOutput->VehicleOuts;
+		for (int32 i = 0; i < VehicleOuts.Num(); ++i)
+		{
+			if (const FGuid* Guid = Slots.ResolveGuid(VehicleOuts[i].Slot.Index, VehicleOuts[i].Slot.Generation))
+			{
+				LatestOutIndices.Add(*Guid, i);
+			}
+		}
+
+		// Instanced visuals: one batched transform update per mesh part.
+		if (VisualBackend.IsValid())
+		{
+			VisualBackend->ApplyVehicleOuts(VehicleOuts);
+		}
 	}
 }
 
-// Register a new vehicle on GT. Returns its FGuid (used by both GT & PT).
+// Register a new vehicle on GT. Returns its FGuid (used by gameplay; PT only sees its slot).
 FGuid FSWPAsyncPhysicsManager::AddVehicle(TWeakObjectPtr<ASWPVehicle> Vehicle)
 {
 	if (Vehicle.IsValid())
 	{
 		FGuid Guid = FGuid::NewGuid();
+		const FSWPVehicleSlot Slot = Slots.Allocate(Guid);
+
+		// Preset tables full: not registered.
+		FSWPVehicleMirrorEdit& Edit = QueueMirrorEdit(ESWPVehicleMirrorOp::Upsert, Slot.Index, !Vehicle->IsPooled());
+		if (!BuildVehiclePacket(*Vehicle, Slot, Edit))
+		{
+			PendingMirrorEdits.Pop(EAllowShrinking::No);
+			Slots.Free(Guid);
+			return FGuid();
+		}
 			
-		Vehicles.Add(Vehicle);
-		VehiclesToAdd.Add(Guid);
+		Vehicle->SetRegistryIndex(Vehicles.Add(Vehicle));
+		VehiclesToAdd.Add(Slot);
+
+		if (FleetReplicator.IsValid())
+		{
+			FleetReplicator->AddVehicle(Vehicle.Get(), Slot);
+		}
 		
 		return Guid;
 	}
@@ -243,16 +421,503 @@ FGuid FSWPAsyncPhysicsManager::AddVehicle(TWeakObjectPtr<ASWPVehicle> Vehicle)
 	return FGuid();		// Invalid
 }
 
-// Unregister vehicle on GT. We keep only the GUID for PT-side removal at next step.
+// Unregister vehicle on GT (O(1) through the slot stored on the vehicle).
+// We keep only the slot for PT-side removal at next step.
 void FSWPAsyncPhysicsManager::RemoveVehicle(TWeakObjectPtr<ASWPVehicle> Vehicle)
 {
-	if (Vehicle.IsValid())
+	if (Vehicle.IsValid() && Vehicles.Remove(Vehicle->GetRegistryIndex()))
+	{
+		Vehicle->SetRegistryIndex(INDEX_NONE);
+
+		const int32 SlotIndex = Slots.Free(Vehicle->GetGuid());
+		if (SlotIndex == INDEX_NONE) return;
+
+		VehiclesToRemove.Add(Slots.GetSlot(SlotIndex));
+		QueueMirrorEdit(ESWPVehicleMirrorOp::Remove, SlotIndex, false);
+
+		if (FleetReplicator.IsValid())
+		{
+			FleetReplicator->RemoveVehicle(SlotIndex);
+		}
+	}
+}
+
+// Re-sample a registered vehicle into the mirror (the only place actor data is read for PT).
+void FSWPAsyncPhysicsManager::UpdateVehicle(const ASWPVehicle* Vehicle)
+{
+	if (!IsValid(Vehicle) || Vehicle->GetRegistryIndex() == INDEX_NONE) return;
+
+	const int32 SlotIndex = Slots.Find(Vehicle->GetGuid());
+	if (SlotIndex == INDEX_NONE) return;
+
+	// Preset tables full: the mirror keeps the previous packet (and tuning).
+	FSWPVehicleMirrorEdit& Edit = QueueMirrorEdit(ESWPVehicleMirrorOp::Upsert, SlotIndex, !Vehicle->IsPooled());
+	if (!BuildVehiclePacket(*Vehicle, Slots.GetSlot(SlotIndex), Edit))
+	{
+		PendingMirrorEdits.Pop(EAllowShrinking::No);
+	}
+}
+
+void FSWPAsyncPhysicsManager::SetVehicleActive(const FGuid& Guid, bool bActive)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex != INDEX_NONE)
+	{
+		QueueMirrorEdit(ESWPVehicleMirrorOp::SetActive, SlotIndex, bActive);
+	}
+}
+
+// Driver inputs for a registered vehicle (actor or external). Cost is one ring write, no packet growth.
+bool FSWPAsyncPhysicsManager::PushControls(const FGuid& Guid, const FSWPVehicleControls& Controls)
+{
+	if (!AsyncObject) return false;
+
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex == INDEX_NONE) return false;
+
+	FSWPControlSample Sample;
+	Sample.Slot = SlotIndex;
+	Sample.Generation = Slots.GetSlot(SlotIndex).Generation;
+	Sample.Timestamp = Timestamp;
+	Sample.PushedAtStep = AsyncObject->GetNumSteps();
+	Sample.Controls = Controls;
+
+	// Keep FIFO order: once something is waiting, queue behind it.
+	if (!ControlBacklog.IsEmpty() || !AsyncObject->GetControlChannel().Push(Sample))
+	{
+		ControlBacklog.Add(Sample);
+	}
+	return true;
+}
+
+void FSWPAsyncPhysicsManager::FlushControlBacklog()
+{
+	int32 NumPushed = 0;
+	while (NumPushed < ControlBacklog.Num() && AsyncObject->GetControlChannel().Push(ControlBacklog[NumPushed]))
+	{
+		++NumPushed;
+	}
+	ControlBacklog.RemoveAt(0, NumPushed, EAllowShrinking::No);
+}
+
+// Destination change for the PT autopilot (actor or external vehicle). Route planning and driving happen on the PT.
+void FSWPAsyncPhysicsManager::SetAutopilotDestination(const FGuid& Guid, int32 DestinationNode, float CruiseSpeedKmh)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex == INDEX_NONE) return;
+
+	FSWPAutopilotCommand& Command = AutopilotCommands.AddDefaulted_GetRef();
+	Command.Slot = SlotIndex;
+	Command.Generation = Slots.GetSlot(SlotIndex).Generation;
+	Command.Destination = DestinationNode < 0 ? INDEX_NONE : DestinationNode;
+	Command.CruiseSpeed = FMath::Max(CruiseSpeedKmh, 0.0f) / 3.6f;
+}
+
+// Forward prediction request (actor or external vehicle). The rollout happens on the PT, the result comes back in a later output.
+int32 FSWPAsyncPhysicsManager::RequestPrediction(const FGuid& Guid, const FSWPVehicleControls& Controls, int32 NumSteps, int32 SampleEvery)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex == INDEX_NONE) return INDEX_NONE;
+
+	FSWPPredictionRequest& Request = PredictionRequests.AddDefaulted_GetRef();
+	Request.RequestId = NextPredictionId++;
+	Request.Slot = SlotIndex;
+	Request.Generation = Slots.GetSlot(SlotIndex).Generation;
+	Request.Controls = Controls;
+	Request.NumSteps = FMath::Max(NumSteps, 1);
+	Request.SampleEvery = FMath::Max(SampleEvery, 1);
+	return Request.RequestId;
+}
+
+bool FSWPAsyncPhysicsManager::TryGetPrediction(int32 RequestId, TArray<FTransform>& OutPoses)
+{
+	OutPoses.Reset();
+	return Predictions.RemoveAndCopyValue(RequestId, OutPoses);
+}
+
+// Register an actor-less vehicle (e.g., a Mass entity) on GT. The packet is built once here.
+FGuid FSWPAsyncPhysicsManager::AddExternalVehicle(Chaos::FUniqueIdx PhysicsIdx, const TArray<FSWPWheelDefinition>& Wheels,
+												 ESWPContactMode ContactMode, const USWPPowertrainPreset* Powertrain,
+												 const TArray<FSWPSensorDefinition>& Sensors)
+{
+	if (!PhysicsIdx.IsValid()) return FGuid();		// Invalid
+
+	const FGuid Guid = FGuid::NewGuid();
+	const FSWPVehicleSlot Slot = Slots.Allocate(Guid);
+
+	FSWPVehicleMirrorEdit& Edit = QueueMirrorEdit(ESWPVehicleMirrorOp::Upsert, Slot.Index, true);
+	Edit.Vehicle.Slot = Slot.Index;
+	Edit.Vehicle.Generation = Slot.Generation;
+	Edit.Vehicle.PhysicsIdx = PhysicsIdx.Idx;
+	Edit.Vehicle.ContactMode = ContactMode;
+	if (!InternTunings(Powertrain, Sensors, Wheels, Edit))
+	{
+		PendingMirrorEdits.Pop(EAllowShrinking::No);
+		Slots.Free(Guid);
+		return FGuid();		// Invalid (preset tables full)
+	}
+
+	ExternalVehicles.Add(Guid);
+	VehiclesToAdd.Add(Slot);
+	return Guid;
+}
+
+// Unregister an actor-less vehicle on GT (PT-side removal at next step).
+void FSWPAsyncPhysicsManager::RemoveExternalVehicle(const FGuid& Guid)
+{
+	if (ExternalVehicles.Remove(Guid) > 0)
+	{
+		const int32 SlotIndex = Slots.Free(Guid);
+		if (SlotIndex == INDEX_NONE) return;
+
+		VehiclesToRemove.Add(Slots.GetSlot(SlotIndex));
+		QueueMirrorEdit(ESWPVehicleMirrorOp::Remove, SlotIndex, false);
+	}
+}
+
+// GT lookup into the newest consumed PT output.
+const FSWPVehicleOut* FSWPAsyncPhysicsManager::FindLatestVehicleOut(const FGuid& Guid) const
+{
+	if (!LatestOutput) return nullptr;
+
+	const int32* Index = LatestOutIndices.Find(Guid);
+	return Index ? &LatestOutput->VehicleOuts[*Index] : nullptr;
+}
+
+// Neighbour slots from the PT resolved back to GUIDs (no GT scene query).
+bool FSWPAsyncPhysicsManager::FindLatestNeighbors(const FGuid& Guid, TArray<FGuid>& OutNeighbors) const
+{
+	OutNeighbors.Reset();
+
+	const FSWPVehicleOut* VehicleOut = FindLatestVehicleOut(Guid);
+	if (!VehicleOut) return false;
+
+	for (const FSWPVehicleSlot& Neighbor : VehicleOut->Neighbors)
+	{
+		if (const FGuid* NeighborGuid = Slots.ResolveGuid(Neighbor.Index, Neighbor.Generation))
+		{
+			OutNeighbors.Add(*NeighborGuid);
+		}
+	}
+	return true;
+}
+
+TConstArrayView<uint16> FSWPAsyncPhysicsManager::FindLatestSensorRanges(const FGuid& Guid) const
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (!SensorRanges.IsValidIndex(SlotIndex)) return TConstArrayView<uint16>();
+
+	const FSensorRanges& Entry = SensorRanges[SlotIndex];
+	return Entry.Generation == Slots.GetSlot(SlotIndex).Generation ? TConstArrayView<uint16>(Entry.Ranges) : TConstArrayView<uint16>();
+}
+
+// Rewind capture on the solver with our callback in front of the game's (one rewind callback per solver).
+void FSWPAsyncPhysicsManager::EnableRewindHistory(int32 NumFrames, TUniquePtr<Chaos::IRewindCallback>&& GameRewindCallback)
+{
+	Chaos::FPhysicsSolver* Solver = PhysScene.GetSolver();
+	if (!AsyncObject || !Solver) return;
+
+	RewindHistoryFrames = FMath::Max(NumFrames, 0);
+	if (RewindHistoryFrames == 0)
+	{
+		// The PT history follows RewindHistoryFrames on the next input. Chaos cannot turn its own capture
+		// off once enabled, but the wrapper goes and the game's callback (if any) gets the solver directly.
+		if (bRewindCallbackInstalled || GameRewindCallback)
+		{
+			Solver->SetRewindCallback(MoveTemp(GameRewindCallback));
+		}
+		bRewindCallbackInstalled = false;
+		return;
+	}
+
+	Solver->EnableRewindCapture(RewindHistoryFrames, true, MakeUnique<FSWPRewindCallback>(AsyncObject, MoveTemp(GameRewindCallback)));
+	bRewindCallbackInstalled = true;
+}
+
+bool FSWPAsyncPhysicsManager::FindStepChecksum(int32 PhysicsStep, uint32& OutChecksum) const
+{
+	if (PhysicsStep < 0 || StepChecksums.Num() != ChecksumHistorySize) return false;
+
+	const FStepChecksum& Entry = StepChecksums[PhysicsStep % ChecksumHistorySize];
+	if (Entry.PhysicsStep != PhysicsStep) return false;
+
+	OutChecksum = Entry.Checksum;
+	return true;
+}
+
+void FSWPAsyncPhysicsManager::RequestSnapshot()
+{
+	bSnapshotRequested = true;
+	bSnapshotReady = false;
+}
+
+bool FSWPAsyncPhysicsManager::TryGetSnapshot(TArray<uint8>& OutSnapshot, TArray<FGuid>& OutGuids)
+{
+	if (!bSnapshotReady) return false;
+
+	OutSnapshot = MoveTemp(CompletedSnapshot);
+	OutGuids = MoveTemp(CompletedSnapshotGuids);
+	bSnapshotReady = false;
+	return true;
+}
+
+// Restore onto registered vehicles (actor or external). Only the carried-over state travels; configs stay the vehicles' own.
+int32 FSWPAsyncPhysicsManager::RestoreSnapshot(TConstArrayView<uint8> Snapshot, TConstArrayView<FGuid> Guids)
+{
+	FSWPFleetSnapshot View;
+	return View.Init(Snapshot) ? QueueRestores(View, Guids) : INDEX_NONE;
+}
+
+// Actor-less vehicles built from the snapshot's packets: its preset tables are interned here (identical
+// tables map 1:1), so no tuning is rebuilt from definitions.
+bool FSWPAsyncPhysicsManager::AddSnapshotVehicles(TConstArrayView<uint8> Snapshot, TConstArrayView<Chaos::FUniqueIdx> PhysicsIdxs, TArray<FGuid>& OutGuids)
+{
+	OutGuids.Reset();
+
+	FSWPFleetSnapshot View;
+	if (!View.Init(Snapshot)) return false;
+
+	// The tables hold one reference per entry while the packets take theirs, released at the end.
+	TArray<int32> PresetIndices;
+	TArray<int32> PowertrainIndices;
+	TArray<int32> SensorRigIndices;
+	for (const FSWPSuspensionTuning& Tuning : View.GetPresets())
+	{
+		PresetIndices.Add(Presets.Intern(Tuning));
+	}
+	for (const FSWPPowertrainTuning& Tuning : View.GetPowertrainPresets())
+	{
+		PowertrainIndices.Add(Powertrains.Intern(Tuning));
+	}
+	for (const FSWPSensorRig& Rig : View.GetSensorRigs())
+	{
+		SensorRigIndices.Add(SensorRigs.Intern(Rig));
+	}
+
+	auto ReleaseTables = [&]()
+	{
+		for (const int32 Index : PresetIndices)
+		{
+			if (Index != INDEX_NONE) Presets.Release(static_cast<uint16>(Index));
+		}
+		for (const int32 Index : PowertrainIndices)
+		{
+			if (Index != INDEX_NONE) Powertrains.Release(static_cast<uint16>(Index));
+		}
+		for (const int32 Index : SensorRigIndices)
+		{
+			if (Index != INDEX_NONE) SensorRigs.Release(static_cast<uint16>(Index));
+		}
+	};
+
+	// Preset tables full: nothing is added.
+	if (PresetIndices.Contains(INDEX_NONE) || PowertrainIndices.Contains(INDEX_NONE) || SensorRigIndices.Contains(INDEX_NONE))
+	{
+		ReleaseTables();
+		return false;
+	}
+
+	const TConstArrayView<FSWPSnapshotVehicle> SnapshotVehicles = View.GetVehicles();
+	const TConstArrayView<FSWPWheelPacket> SnapshotWheels = View.GetWheels();
+	const int32 NumVehicles = FMath::Min(SnapshotVehicles.Num(), PhysicsIdxs.Num());
+	OutGuids.Reserve(NumVehicles);
+	for (int32 i = 0; i < NumVehicles; ++i)
+	{
+		if (!PhysicsIdxs[i].IsValid())
+		{
+			OutGuids.Add(FGuid());
+			continue;
+		}
+
+		const FGuid Guid = FGuid::NewGuid();
+		const FSWPVehicleSlot Slot = Slots.Allocate(Guid);
+		ExternalVehicles.Add(Guid);
+
+		const FSWPVehiclePacket& Packet = SnapshotVehicles[i].Packet;
+		FSWPVehicleMirrorEdit& Edit = QueueMirrorEdit(ESWPVehicleMirrorOp::Upsert, Slot.Index, true);
+		Edit.Vehicle = Packet;
+		Edit.Vehicle.Slot = Slot.Index;
+		Edit.Vehicle.Generation = Slot.Generation;
+		Edit.Vehicle.PhysicsIdx = PhysicsIdxs[i].Idx;
+		Edit.Vehicle.IgnoreActorId = 0;
+		if (Packet.PowertrainIndex != FSWPVehiclePacket::NoPowertrain)
+		{
+			Edit.Vehicle.PowertrainIndex = static_cast<uint16>(PowertrainIndices[Packet.PowertrainIndex]);
+			Powertrains.AddRef(Edit.Vehicle.PowertrainIndex);
+		}
+		if (Packet.SensorRigIndex != FSWPVehiclePacket::NoSensors)
+		{
+			Edit.Vehicle.SensorRigIndex = static_cast<uint16>(SensorRigIndices[Packet.SensorRigIndex]);
+			SensorRigs.AddRef(Edit.Vehicle.SensorRigIndex);
+		}
+		Edit.Wheels.Append(SnapshotWheels.GetData() + Packet.FirstWheel, Packet.NumWheels);
+		for (FSWPWheelPacket& Wheel : Edit.Wheels)
+		{
+			Wheel.PresetIndex = static_cast<uint16>(PresetIndices[Wheel.PresetIndex]);
+			Presets.AddRef(Wheel.PresetIndex);
+		}
+
+		VehiclesToAdd.Add(Slot);
+		OutGuids.Add(Guid);
+	}
+	ReleaseTables();
+
+	QueueRestores(View, OutGuids);
+	return true;
+}
+
+int32 FSWPAsyncPhysicsManager::QueueRestores(const FSWPFleetSnapshot& View, TConstArrayView<FGuid> Guids)
+{
+	const TConstArrayView<FSWPSnapshotVehicle> SnapshotVehicles = View.GetVehicles();
+	const TConstArrayView<float> Compressions = View.GetCompressions();
+	const int32 NumVehicles = FMath::Min(SnapshotVehicles.Num(), Guids.Num());
+	VehicleRestores.Reserve(VehicleRestores.Num() + NumVehicles);
+
+	int32 NumQueued = 0;
+	for (int32 i = 0; i < NumVehicles; ++i)
+	{
+		const int32 SlotIndex = Slots.Find(Guids[i]);
+		if (SlotIndex == INDEX_NONE) continue;
+
+		const FSWPVehicleRestore& State = SnapshotVehicles[i].State;
+		FSWPVehicleRestore& Restore = VehicleRestores.Add_GetRef(State);
+		Restore.Slot = SlotIndex;
+		Restore.Generation = Slots.GetSlot(SlotIndex).Generation;
+		Restore.FirstCompression = RestoredCompressions.Num();
+		RestoredCompressions.Append(Compressions.GetData() + State.FirstCompression, State.NumWheels);
+		++NumQueued;
+	}
+	return NumQueued;
+}
+
+void FSWPAsyncPhysicsManager::RestoreVehicle(const FGuid& Guid, const FSWPVehicleRestore& State, TConstArrayView<float> Compressions)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex == INDEX_NONE) return;
+
+	FSWPVehicleRestore& Restore = VehicleRestores.Add_GetRef(State);
+	Restore.Slot = SlotIndex;
+	Restore.Generation = Slots.GetSlot(SlotIndex).Generation;
+	Restore.FirstCompression = RestoredCompressions.Num();
+	Restore.NumWheels = Compressions.Num();
+	RestoredCompressions.Append(Compressions.GetData(), Compressions.Num());
+}
+
+// Install/remove the replication channel; vehicles registered before it are handed over now.
+void FSWPAsyncPhysicsManager::SetFleetReplicator(ASWPFleetReplicator* InFleetReplicator)
+{
+	FleetReplicator = InFleetReplicator;
+	if (!InFleetReplicator) return;
+
+	for (const TWeakObjectPtr<ASWPVehicle>& Vehicle : Vehicles.GetVehicles())
+	{
+		const int32 SlotIndex = Vehicle.IsValid() ? Slots.Find(Vehicle->GetGuid()) : INDEX_NONE;
+		if (SlotIndex != INDEX_NONE)
+		{
+			InFleetReplicator->AddVehicle(Vehicle.Get(), Slots.GetSlot(SlotIndex));
+		}
+	}
+}
+
+// Replicated suspension state (actor or external vehicle), applied by the PT before the next step.
+void FSWPAsyncPhysicsManager::SetSuspensionCompressions(const FGuid& Guid, TConstArrayView<float> Compressions)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex == INDEX_NONE) return;
+
+	FSWPSuspensionCorrection& Correction = SuspensionCorrections.AddDefaulted_GetRef();
+	Correction.Slot = SlotIndex;
+	Correction.Generation = Slots.GetSlot(SlotIndex).Generation;
+	Correction.FirstCompression = CorrectedCompressions.Num();
+	Correction.NumWheels = Compressions.Num();
+	CorrectedCompressions.Append(Compressions.GetData(), Compressions.Num());
+}
+
+// Install/remove the instanced visual backend and toggle per-actor vehicle meshes accordingly.
+void FSWPAsyncPhysicsManager::SetVisualBackend(ASWPFleetVisualizer* InVisualBackend)
+{
+	VisualBackend = InVisualBackend;
+
+	const bool bHide = ShouldHideVehicleMeshes();
+	for (const TWeakObjectPtr<ASWPVehicle>& Vehicle : Vehicles.GetVehicles())
+	{
+		if (Vehicle.IsValid())
+			Vehicle->SetActorHiddenInGame(bHide);
+	}
+}
+
+bool FSWPAsyncPhysicsManager::ShouldHideVehicleMeshes() const
+{
+	return VisualBackend.IsValid() && VisualBackend->bHideVehicleMeshes;
+}
+
+// Flatten the authored table into one row per surface type (the PT indexes it by surface ID).
+void FSWPAsyncPhysicsManager::SetSurfaceTable(const USWPSurfaceTable* SurfaceTable)
+{
+	SurfaceScales.Init(FSWPSurfaceScale(), SurfaceType_Max);
+	if (SurfaceTable)
+	{
+		for (const FSWPSurfaceResponse& Response : SurfaceTable->Surfaces)
+		{
+			FSWPSurfaceScale& Scale = SurfaceScales[Response.Surface.GetValue()];
+			Scale.Stiffness = Response.StiffnessScale;
+			Scale.Damping = Response.DampingScale;
+			Scale.Friction = Response.FrictionScale;
+		}
+	}
+	bSurfaceScalesDirty = true;
+}
+
+// Flatten the graph once on GT; the PT receives it as an immutable shared object.
+void FSWPAsyncPhysicsManager::SetRoadGraph(const USWPRoadGraph* InRoadGraph)
+{
+	RoadGraph = MakeShared<const FSWPRoadGraphData, ESPMode::ThreadSafe>(InRoadGraph ? FSWPRoadGraphData::Make(*InRoadGraph) : FSWPRoadGraphData());
+	bRoadGraphDirty = true;
+}
+
+// Queue a PT state reset for a registered vehicle (applied at the beginning of the next step).
+void FSWPAsyncPhysicsManager::ResetVehicleState(const FGuid& Guid)
+{
+	const int32 SlotIndex = Slots.Find(Guid);
+	if (SlotIndex != INDEX_NONE)
 	{
-		Vehicles.Remove(Vehicle);
-		VehiclesToRemove.Add(Vehicle->GetGuid());
+		VehiclesToReset.Add(Slots.GetSlot(SlotIndex));
 	}
 }
 
+// New gameplay identity for the same slot: the previous GUID stops resolving (stale handles cannot reach the new life).
+bool FSWPAsyncPhysicsManager::RekeyVehicle(const FGuid& OldGuid, const FGuid& NewGuid)
+{
+	if (!Slots.Rekey(OldGuid, NewGuid)) return false;
+
+	int32 OutIndex = INDEX_NONE;
+	if (LatestOutIndices.RemoveAndCopyValue(OldGuid, OutIndex))
+	{
+		LatestOutIndices.Add(NewGuid, OutIndex);
+	}
+	return true;
+}
+
+FSWPVehicleMirrorEdit& FSWPAsyncPhysicsManager::QueueMirrorEdit(ESWPVehicleMirrorOp Op, int32 Slot, bool bActive)
+{
+	FSWPVehicleMirrorEdit& Edit = PendingMirrorEdits.AddDefaulted_GetRef();
+	Edit.Op = Op;
+	Edit.Slot = Slot;
+	Edit.bActive = bActive;
+	return Edit;
+}
+
+// Copy the active mirror entries into the staged packet on a worker, overlapping the game frame.
+// Only the mirror (POD) is read: no actor/component access off the GT.
+void FSWPAsyncPhysicsManager::LaunchInputBuild()
+{
+	BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_BuildInputPacket);
+		Mirror.Build(StagedVehicles, StagedWheels);
+	});
+}
+
 // Fetch Chaos particle UniqueIdx from a BodyInstance. Must be called on GT.
 Chaos::FUniqueIdx FSWPAsyncPhysicsManager::GetChaosUniqueIdx(const FBodyInstance* BI)
 {
@@ -269,21 +934,62 @@ Chaos::FUniqueIdx FSWPAsyncPhysicsManager::GetChaosUniqueIdx(const FBodyInstance
 	return GT.UniqueIdx();
 }
 
-// Build a POD suspension config from a USWPSuspension component (GT).
-// PT will consume this data without touching the component/UObject.
-FSWPSuspensionConfig FSWPAsyncPhysicsManager::BuildSuspensionCfg(const USWPSuspension* Suspension)
+// Snapshot a vehicle into wire format (POD only). GT-only: reads the actor and its body instance.
+// False when a tuning could not be interned (nothing is referenced then).
+bool FSWPAsyncPhysicsManager::BuildVehiclePacket(const ASWPVehicle& Vehicle, const FSWPVehicleSlot& Slot, FSWPVehicleMirrorEdit& OutEdit)
 {
-	FSWPSuspensionConfig Config {};
+	OutEdit.Vehicle.Slot = Slot.Index;												// PT slot (replaces the FGuid on the wire)
+	OutEdit.Vehicle.Generation = Slot.Generation;
+	OutEdit.Vehicle.PhysicsIdx = GetChaosUniqueIdx(Vehicle.GetBodyInstance()).Idx;	// Solver particle ID (FUniqueIdx)
+	OutEdit.Vehicle.IgnoreActorId = Vehicle.GetUniqueID();							// Trace filter (no UObject on PT)
+	OutEdit.Vehicle.ContactMode = Vehicle.GetContactMode();
 
-	if (!Suspension) return Config;
-	
-	Config.AttachLocal = Suspension->GetRelativeTransform();
-	
-	Config.TravelCm = Suspension->TravelCm;
-	Config.SpringStiffness = Suspension->SpringStiffness;
-	Config.ShockBump = Suspension->ShockBump;
-	Config.ShockRebound = Suspension->ShockRebound;
-	Config.MaxForce = Suspension->MaxForce;
-	Config.WheelRadiusCm = Suspension->WheelRadiusCm;
-	return Config;
+	return InternTunings(Vehicle.GetPowertrain(), Vehicle.GetSensors(), Vehicle.GetWheels(), OutEdit);
+}
+
+// Powertrain, sensor rig and one wheel packet per wheel definition (any wheel count). Tunings are
+// interned: wheels sharing a preset (or identical values) share one PT table entry. All or nothing:
+// when a table is full, the references already taken are released and false is returned.
+bool FSWPAsyncPhysicsManager::InternTunings(const USWPPowertrainPreset* Powertrain, const TArray<FSWPSensorDefinition>& Sensors,
+											const TArray<FSWPWheelDefinition>& Wheels, FSWPVehicleMirrorEdit& OutEdit)
+{
+	const int32 PowertrainIndex = Powertrain ? Powertrains.Intern(FSWPPowertrainTuning::Make(*Powertrain)) : FSWPVehiclePacket::NoPowertrain;
+	const int32 SensorRigIndex = Sensors.IsEmpty() ? FSWPVehiclePacket::NoSensors : SensorRigs.Intern(FSWPSensorRig::Make(Sensors));
+	OutEdit.Vehicle.PowertrainIndex = PowertrainIndex != INDEX_NONE ? static_cast<uint16>(PowertrainIndex) : FSWPVehiclePacket::NoPowertrain;
+	OutEdit.Vehicle.SensorRigIndex = SensorRigIndex != INDEX_NONE ? static_cast<uint16>(SensorRigIndex) : FSWPVehiclePacket::NoSensors;
+	bool bInterned = PowertrainIndex != INDEX_NONE && SensorRigIndex != INDEX_NONE;
+
+	OutEdit.Wheels.Reset(Wheels.Num());
+	for (int32 w = 0; bInterned && w < Wheels.Num(); ++w)
+	{
+		const int32 PresetIndex = Presets.Intern(FSWPSuspensionTuning::Make(Wheels[w]));
+		if (PresetIndex == INDEX_NONE)
+		{
+			bInterned = false;
+			break;
+		}
+		OutEdit.Wheels.Add(FSWPWheelPacket::Pack(Wheels[w], static_cast<uint16>(PresetIndex)));
+	}
+
+	if (!bInterned)
+	{
+		ReleaseTunings(OutEdit.Vehicle, OutEdit.Wheels);
+	}
+	return bInterned;
+}
+
+void FSWPAsyncPhysicsManager::ReleaseTunings(const FSWPVehiclePacket& Vehicle, TConstArrayView<FSWPWheelPacket> Wheels)
+{
+	if (Vehicle.PowertrainIndex != FSWPVehiclePacket::NoPowertrain)
+	{
+		Powertrains.Release(Vehicle.PowertrainIndex);
+	}
+	if (Vehicle.SensorRigIndex != FSWPVehiclePacket::NoSensors)
+	{
+		SensorRigs.Release(Vehicle.SensorRigIndex);
+	}
+	for (const FSWPWheelPacket& Wheel : Wheels)
+	{
+		Presets.Release(Wheel.PresetIndex);
+	}
 }
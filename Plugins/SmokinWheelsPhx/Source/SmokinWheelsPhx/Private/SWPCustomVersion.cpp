@@ -0,0 +1,8 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPCustomVersion.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FSWPCustomVersion::GUID(0x5A3C91E2, 0x4B7D4F08, 0x9E21C6A4, 0x1D83F57B);
+
+static FCustomVersionRegistration GRegisterSWPCustomVersion(FSWPCustomVersion::GUID, FSWPCustomVersion::LatestVersion, TEXT("SmokinWheelsPhx"));
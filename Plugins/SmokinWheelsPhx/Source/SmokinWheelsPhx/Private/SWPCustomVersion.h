@@ -0,0 +1,22 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+// Serialization version of the plugin's assets (load-time data migrations key off it).
+struct FSWPCustomVersion
+{
+	enum Type
+	{
+		BeforeCustomVersionWasAdded = 0,
+		// ASWPVehicle: the four USWPSuspension components became the Wheels array.
+		WheelDefinitions,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+};
@@ -0,0 +1,133 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Outs/SWPNetVehicleState.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+/**
+ * FSWPFleetNetCodec (GT side)
+ *
+ * Bit-level encoding of FSWPNetVehicleState against a baseline the receiver already holds (a
+ * default state for full updates). Only the fields in the field mask are written, each integer
+ * as a zigzag varint of its difference to the baseline, so a vehicle that moved a little costs
+ * a few bytes and fields that did not change cost nothing.
+ *
+ * Per vehicle: field mask (3 bits), then for each field in the mask
+ *  - Pose: 3 position deltas, largest component (2 bits), 3 rotation deltas,
+ *  - Velocity: 3 linear and 3 angular velocity deltas,
+ *  - Wheels: wheel count, one compression delta per wheel.
+ */
+struct FSWPFleetNetCodec
+{
+	// Bounds a malformed wheel count (the vehicles themselves have no hard limit).
+	static constexpr uint32 MaxWheels = 64;
+
+	static void Write(FBitWriter& Writer, const FSWPNetVehicleState& State, const FSWPNetVehicleState& Baseline, const uint8 Fields)
+	{
+		uint32 FieldMask = Fields;
+		Writer.SerializeInt(FieldMask, FSWPNetVehicleState::AllFields + 1);
+
+		if (Fields & FSWPNetVehicleState::Pose)
+		{
+			for (int32 a = 0; a < 3; ++a)
+			{
+				WriteDelta(Writer, State.Position[a], Baseline.Position[a]);
+			}
+			uint32 LargestComponent = State.LargestComponent;
+			Writer.SerializeInt(LargestComponent, 4);
+			for (int32 k = 0; k < 3; ++k)
+			{
+				WriteDelta(Writer, State.Rotation[k], Baseline.Rotation[k]);
+			}
+		}
+
+		if (Fields & FSWPNetVehicleState::Velocity)
+		{
+			for (int32 a = 0; a < 3; ++a)
+			{
+				WriteDelta(Writer, State.LinearVelocity[a], Baseline.LinearVelocity[a]);
+				WriteDelta(Writer, State.AngularVelocity[a], Baseline.AngularVelocity[a]);
+			}
+		}
+
+		if (Fields & FSWPNetVehicleState::Wheels)
+		{
+			uint32 NumWheels = State.Compressions.Num();
+			Writer.SerializeIntPacked(NumWheels);
+			for (int32 w = 0; w < State.Compressions.Num(); ++w)
+			{
+				WriteDelta(Writer, State.Compressions[w], Baseline.Compressions.IsValidIndex(w) ? Baseline.Compressions[w] : 0);
+			}
+		}
+	}
+
+	// OutState starts as the baseline; fields outside the mask keep its values. False on a malformed packet.
+	static bool Read(FBitReader& Reader, const FSWPNetVehicleState& Baseline, FSWPNetVehicleState& OutState)
+	{
+		OutState = Baseline;
+		OutState.bValid = true;
+
+		uint32 Fields = 0;
+		Reader.SerializeInt(Fields, FSWPNetVehicleState::AllFields + 1);
+		if (Reader.IsError()) return false;
+
+		if (Fields & FSWPNetVehicleState::Pose)
+		{
+			for (int32 a = 0; a < 3; ++a)
+			{
+				OutState.Position[a] = ReadDelta<int32>(Reader, Baseline.Position[a]);
+			}
+			uint32 LargestComponent = 0;
+			Reader.SerializeInt(LargestComponent, 4);
+			OutState.LargestComponent = static_cast<uint8>(LargestComponent);
+			for (int32 k = 0; k < 3; ++k)
+			{
+				OutState.Rotation[k] = ReadDelta<int16>(Reader, Baseline.Rotation[k]);
+			}
+		}
+
+		if (Fields & FSWPNetVehicleState::Velocity)
+		{
+			for (int32 a = 0; a < 3; ++a)
+			{
+				OutState.LinearVelocity[a] = ReadDelta<int16>(Reader, Baseline.LinearVelocity[a]);
+				OutState.AngularVelocity[a] = ReadDelta<int16>(Reader, Baseline.AngularVelocity[a]);
+			}
+		}
+
+		if (Fields & FSWPNetVehicleState::Wheels)
+		{
+			uint32 NumWheels = 0;
+			Reader.SerializeIntPacked(NumWheels);
+			if (NumWheels > MaxWheels) return false;
+
+			OutState.Compressions.SetNumUninitialized(NumWheels);
+			for (uint32 w = 0; w < NumWheels; ++w)
+			{
+				OutState.Compressions[w] = ReadDelta<uint8>(Reader, Baseline.Compressions.IsValidIndex(w) ? Baseline.Compressions[w] : 0);
+			}
+		}
+
+		return !Reader.IsError();
+	}
+
+private:
+	// Small differences of either sign become small unsigned values (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...).
+	FORCEINLINE static void WriteDelta(FBitWriter& Writer, const int32 Value, const int32 Baseline)
+	{
+		const int32 Delta = static_cast<int32>(static_cast<uint32>(Value) - static_cast<uint32>(Baseline));
+		uint32 ZigZag = (static_cast<uint32>(Delta) << 1) ^ static_cast<uint32>(Delta >> 31);
+		Writer.SerializeIntPacked(ZigZag);
+	}
+
+	template<typename IntType>
+	FORCEINLINE static IntType ReadDelta(FBitReader& Reader, const int32 Baseline)
+	{
+		uint32 ZigZag = 0;
+		Reader.SerializeIntPacked(ZigZag);
+		const uint32 Delta = (ZigZag >> 1) ^ (0u - (ZigZag & 1u));
+		return static_cast<IntType>(static_cast<int32>(static_cast<uint32>(Baseline) + Delta));
+	}
+};
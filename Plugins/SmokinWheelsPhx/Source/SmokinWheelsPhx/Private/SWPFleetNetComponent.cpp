@@ -0,0 +1,231 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPFleetNetComponent.h"
+#include "SWPFleetNetCodec.h"
+#include "SWPFleetReplicator.h"
+#include "SWPStat.h"
+#include "Net/UnrealNetwork.h"
+
+// Show with 'stat SmokinWheelsPhx' in the UE console
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:FleetNetSend"), STAT_SmokinWheelsPhx_FleetNetSend, STATGROUP_SmokinWheelsPhx);
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:FleetNetReceive"), STAT_SmokinWheelsPhx_FleetNetReceive, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Net bytes sent"), STAT_SmokinWheelsPhx_NetBytesSent, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Net vehicles sent"), STAT_SmokinWheelsPhx_NetVehiclesSent, STATGROUP_SmokinWheelsPhx);
+
+// Bounds the client baseline arena against a malformed network ID.
+static constexpr uint32 SWP_MaxNetIds = 1 << 16;
+
+USWPFleetNetComponent::USWPFleetNetComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;		// Driven by the replicator, not by Tick.
+
+	SetIsReplicatedByDefault(true);
+}
+
+void USWPFleetNetComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(USWPFleetNetComponent, Replicator);
+}
+
+void USWPFleetNetComponent::SendPacket(const ASWPFleetReplicator& InReplicator, const FVector& ViewLocation, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_FleetNetSend);
+
+	const TArray<FSWPFleetNetVehicle>& NetVehicles = InReplicator.GetNetVehicles();
+	if (ClientVehicles.Num() < NetVehicles.Num())
+	{
+		ClientVehicles.SetNum(NetVehicles.Num());
+	}
+	if (SentPackets.Num() != BaselineWindow)
+	{
+		SentPackets.SetNum(BaselineWindow);
+	}
+
+	const uint32 Sequence = NextSequence;
+	const double RelevanceDistanceSq = FMath::Square(static_cast<double>(FMath::Max(InReplicator.RelevanceDistance, 1.0f)));
+	const double CullDistanceSq = InReplicator.CullDistance > 0.0f ? FMath::Square(static_cast<double>(InReplicator.CullDistance)) : TNumericLimits<double>::Max();
+
+	// Candidates: vehicles with a field changed after the state this client acknowledged. Their priority grows
+	// with the time they wait, faster when close to the view point.
+	Candidates.Reset();
+	for (int32 NetId = 0; NetId < NetVehicles.Num(); ++NetId)
+	{
+		const FSWPFleetNetVehicle& NetVehicle = NetVehicles[NetId];
+		if (!NetVehicle.State.bValid) continue;
+
+		FClientVehicle& ClientVehicle = ClientVehicles[NetId];
+		if (ClientVehicle.Generation != NetVehicle.Generation)
+		{
+			ClientVehicle = FClientVehicle();
+			ClientVehicle.Generation = NetVehicle.Generation;
+		}
+
+		uint8 Fields = FSWPNetVehicleState::AllFields;
+		if (ClientVehicle.AckedSequence != 0)
+		{
+			Fields = 0;
+			for (int32 f = 0; f < FSWPNetVehicleState::NumFields; ++f)
+			{
+				if (NetVehicle.ChangedSteps[f] > ClientVehicle.AckedStep)
+				{
+					Fields |= 1 << f;
+				}
+			}
+		}
+		if (Fields == 0) continue;
+
+		const double DistanceSq = FVector::DistSquared(NetVehicle.State.GetLocation(), ViewLocation);
+		if (DistanceSq > CullDistanceSq) continue;
+
+		ClientVehicle.Priority += DeltaTime * static_cast<float>(RelevanceDistanceSq / (RelevanceDistanceSq + DistanceSq));
+		Candidates.Emplace(NetId, Fields);
+	}
+	if (Candidates.IsEmpty()) return;
+
+	Candidates.Sort([this](const TPair<int32, uint8>& A, const TPair<int32, uint8>& B)
+	{
+		return ClientVehicles[A.Key].Priority > ClientVehicles[B.Key].Priority;
+	});
+
+	// Most relevant first until the byte budget; a vehicle that does not fit is rolled back and ends the packet.
+	const int32 MaxBytes = FMath::Max(InReplicator.MaxBytesPerPacket, 64);
+	FBitWriter Body(MaxBytes * 8, true);
+	FSentPacket& SentPacket = SentPackets[Sequence % BaselineWindow];
+	SentPacket.Sequence = Sequence;
+	SentPacket.Vehicles.Reset();
+
+	const FSWPNetVehicleState NoBaseline;
+	for (const TPair<int32, uint8>& Candidate : Candidates)
+	{
+		const int32 NetId = Candidate.Key;
+		const FSWPFleetNetVehicle& NetVehicle = NetVehicles[NetId];
+		FClientVehicle& ClientVehicle = ClientVehicles[NetId];
+
+		// The client's copy of the acknowledged state is overwritten once this vehicle is sent BaselineWindow packets later.
+		const bool bDelta = ClientVehicle.AckedSequence != 0 && ClientVehicle.LastSentSequence - ClientVehicle.AckedSequence < BaselineWindow;
+
+		FBitWriterMark Mark(Body);
+		uint32 Id = NetId;
+		uint32 BaselineAge = bDelta ? Sequence - ClientVehicle.AckedSequence : 0;
+		Body.SerializeIntPacked(Id);
+		Body.SerializeIntPacked(BaselineAge);
+		FSWPFleetNetCodec::Write(Body, NetVehicle.State, bDelta ? ClientVehicle.AckedState : NoBaseline, bDelta ? Candidate.Value : FSWPNetVehicleState::AllFields);
+
+		if (Body.GetNumBytes() > MaxBytes && SentPacket.Vehicles.Num() > 0)
+		{
+			Mark.Pop(Body);
+			break;
+		}
+
+		ClientVehicle.Priority = 0.0f;
+		ClientVehicle.LastSentSequence = Sequence;
+		SentPacket.Vehicles.Add({ NetId, NetVehicle.Generation, NetVehicle.Step, NetVehicle.State });
+	}
+
+	FBitWriter Writer(Body.GetNumBits() + 64, true);
+	uint32 PacketSequence = Sequence;
+	uint32 NumVehicles = SentPacket.Vehicles.Num();
+	Writer.SerializeIntPacked(PacketSequence);
+	Writer.SerializeIntPacked(NumVehicles);
+	Writer.SerializeBits(Body.GetData(), Body.GetNumBits());
+
+	const TArray<uint8> Packet(Writer.GetData(), Writer.GetNumBytes());
+	ClientReceiveFleetPacket(Packet);
+	++NextSequence;
+
+	INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_NetBytesSent, Packet.Num());
+	INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_NetVehiclesSent, NumVehicles);
+}
+
+// Server: the client holds every state of that packet; later deltas of those vehicles are against them.
+void USWPFleetNetComponent::ServerAckFleetPacket_Implementation(uint32 Sequence)
+{
+	if (SentPackets.Num() != BaselineWindow || Sequence == 0) return;
+
+	FSentPacket& SentPacket = SentPackets[Sequence % BaselineWindow];
+	if (SentPacket.Sequence != Sequence) return;		// Too old (slot reused) or acknowledged already.
+
+	for (const FSentVehicle& SentVehicle : SentPacket.Vehicles)
+	{
+		if (!ClientVehicles.IsValidIndex(SentVehicle.NetId)) continue;
+
+		FClientVehicle& ClientVehicle = ClientVehicles[SentVehicle.NetId];
+		if (ClientVehicle.Generation != SentVehicle.Generation || Sequence <= ClientVehicle.AckedSequence) continue;
+
+		ClientVehicle.AckedSequence = Sequence;
+		ClientVehicle.AckedStep = SentVehicle.Step;
+		ClientVehicle.AckedState = SentVehicle.State;
+	}
+	SentPacket.Sequence = 0;
+	SentPacket.Vehicles.Reset();
+}
+
+// Client: decode every vehicle against its baseline, keep the result as a future baseline, apply the newest.
+// Packets with a missing baseline are not acknowledged, so the server never deltas against them.
+void USWPFleetNetComponent::ClientReceiveFleetPacket_Implementation(const TArray<uint8>& Packet)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_FleetNetReceive);
+
+	FBitReader Reader(const_cast<uint8*>(Packet.GetData()), Packet.Num() * 8);
+	uint32 Sequence = 0;
+	uint32 NumVehicles = 0;
+	Reader.SerializeIntPacked(Sequence);
+	Reader.SerializeIntPacked(NumVehicles);
+	if (Reader.IsError() || Sequence == 0) return;
+
+	const FSWPNetVehicleState NoBaseline;
+	bool bComplete = true;
+	for (uint32 v = 0; v < NumVehicles; ++v)
+	{
+		uint32 NetId = 0;
+		uint32 BaselineAge = 0;
+		Reader.SerializeIntPacked(NetId);
+		Reader.SerializeIntPacked(BaselineAge);
+		if (Reader.IsError() || NetId >= SWP_MaxNetIds || BaselineAge >= Sequence) return;
+
+		if (static_cast<int32>(NetId) >= AppliedSequences.Num())
+		{
+			AppliedSequences.SetNumZeroed(NetId + 1);
+			Baselines.SetNum((NetId + 1) * BaselineWindow);
+		}
+
+		FBaseline* VehicleBaselines = Baselines.GetData() + NetId * BaselineWindow;
+		const FSWPNetVehicleState* Baseline = &NoBaseline;
+		if (BaselineAge != 0)
+		{
+			const uint32 BaselineSequence = Sequence - BaselineAge;
+			const FBaseline& Entry = VehicleBaselines[BaselineSequence % BaselineWindow];
+			Baseline = Entry.Sequence == BaselineSequence ? &Entry.State : nullptr;
+		}
+
+		// Field sizes do not depend on the baseline: a vehicle without one is still read past, then dropped.
+		FSWPNetVehicleState State;
+		if (!FSWPFleetNetCodec::Read(Reader, Baseline ? *Baseline : NoBaseline, State)) return;
+		if (!Baseline)
+		{
+			bComplete = false;
+			continue;
+		}
+
+		FBaseline& Entry = VehicleBaselines[Sequence % BaselineWindow];
+		Entry.Sequence = Sequence;
+		Entry.State = State;
+
+		// Unreliable packets may arrive out of order: only a newer state is applied.
+		if (Sequence > AppliedSequences[NetId])
+		{
+			AppliedSequences[NetId] = Sequence;
+			if (Replicator)
+			{
+				Replicator->ApplyNetState(NetId, State);
+			}
+		}
+	}
+
+	if (bComplete)
+	{
+		ServerAckFleetPacket(Sequence);
+	}
+}
@@ -0,0 +1,178 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPFleetReplicator.h"
+#include "SWPAsyncPhysicsManager.h"
+#include "SWPFleetNetComponent.h"
+#include "SWPVehicle.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+
+ASWPFleetReplicator::ASWPFleetReplicator()
+{
+	PrimaryActorTick.bCanEverTick = true;		// Server: paces the client packets.
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASWPFleetReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ASWPFleetReplicator, Vehicles);
+}
+
+void ASWPFleetReplicator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Only the server reads PT outputs; clients just decode packets.
+	if (!HasAuthority()) return;
+
+	if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+			PhysManager->SetFleetReplicator(this);
+	}
+}
+
+void ASWPFleetReplicator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (HasAuthority())
+	{
+		if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+		{
+			if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+				PhysManager->SetFleetReplicator(nullptr);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASWPFleetReplicator::AddVehicle(ASWPVehicle* Vehicle, const FSWPVehicleSlot& Slot)
+{
+	if (!IsValid(Vehicle) || Slot.Index == INDEX_NONE) return;
+
+	const int32 NetId = FreeNetIds.Num() > 0 ? FreeNetIds.Pop(EAllowShrinking::No) : NetVehicles.AddDefaulted();
+	if (NetId == Vehicles.Num())
+	{
+		Vehicles.Add(nullptr);
+	}
+
+	FSWPFleetNetVehicle& NetVehicle = NetVehicles[NetId];
+	const uint32 Generation = NetVehicle.Generation + 1;
+	NetVehicle = FSWPFleetNetVehicle();
+	NetVehicle.Generation = Generation;
+	NetVehicle.Slot = Slot;
+	Vehicles[NetId] = Vehicle;
+
+	for (int32 i = SlotToNetId.Num(); i <= Slot.Index; ++i)
+	{
+		SlotToNetId.Add(INDEX_NONE);
+	}
+	SlotToNetId[Slot.Index] = NetId;
+
+	// The fleet channel carries the movement from now on.
+	Vehicle->SetReplicatingMovement(false);
+}
+
+void ASWPFleetReplicator::RemoveVehicle(int32 SlotIndex)
+{
+	const int32 NetId = SlotToNetId.IsValidIndex(SlotIndex) ? SlotToNetId[SlotIndex] : INDEX_NONE;
+	if (NetId == INDEX_NONE) return;
+
+	const uint32 Generation = NetVehicles[NetId].Generation;
+	NetVehicles[NetId] = FSWPFleetNetVehicle();
+	NetVehicles[NetId].Generation = Generation;
+	Vehicles[NetId] = nullptr;
+	SlotToNetId[SlotIndex] = INDEX_NONE;
+	FreeNetIds.Add(NetId);
+}
+
+// Latest quantized state of every vehicle, plus the step each field last changed (from the PT dirty bits).
+// Called for every drained output, so no step's changes are missed.
+void ASWPFleetReplicator::ConsumeVehicleOuts(const TArray<FSWPVehicleOut>& VehicleOuts, uint32 Step)
+{
+	for (const FSWPVehicleOut& VehicleOut : VehicleOuts)
+	{
+		if (!VehicleOut.NetState.bValid || !SlotToNetId.IsValidIndex(VehicleOut.Slot.Index)) continue;
+
+		const int32 NetId = SlotToNetId[VehicleOut.Slot.Index];
+		if (NetId == INDEX_NONE) continue;
+
+		FSWPFleetNetVehicle& NetVehicle = NetVehicles[NetId];
+		if (NetVehicle.Slot.Generation != VehicleOut.Slot.Generation) continue;
+
+		for (int32 f = 0; f < FSWPNetVehicleState::NumFields; ++f)
+		{
+			if (VehicleOut.NetDirty & (1 << f))
+			{
+				NetVehicle.ChangedSteps[f] = Step;
+			}
+		}
+		NetVehicle.State = VehicleOut.NetState;
+		NetVehicle.Step = Step;
+	}
+}
+
+// Server: one packet per remote client every 1 / NetUpdateRate seconds.
+void ASWPFleetReplicator::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	UWorld* World = GetWorld();
+	if (!World || !HasAuthority()) return;
+
+	const float Interval = 1.0f / FMath::Max(NetUpdateRate, 1.0f);
+	TimeToNextPacket -= DeltaSeconds;
+	if (TimeToNextPacket > 0.0f) return;
+	TimeToNextPacket = FMath::Max(TimeToNextPacket + Interval, 0.0f);
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+		if (!PlayerController || PlayerController->IsLocalController()) continue;		// The listen server sees its own simulation.
+
+		USWPFleetNetComponent* NetComponent = PlayerController->FindComponentByClass<USWPFleetNetComponent>();
+		if (!NetComponent)
+		{
+			NetComponent = NewObject<USWPFleetNetComponent>(PlayerController);
+			NetComponent->Replicator = this;
+			NetComponent->RegisterComponent();
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		NetComponent->SendPacket(*this, ViewLocation, Interval);
+	}
+}
+
+// Client: the replicated state wins over the local simulation (pose/velocities teleported, PT suspensions overwritten).
+void ASWPFleetReplicator::ApplyNetState(int32 NetId, const FSWPNetVehicleState& State) const
+{
+	ASWPVehicle* Vehicle = Vehicles.IsValidIndex(NetId) ? Vehicles[NetId].Get() : nullptr;
+	if (!IsValid(Vehicle) || Vehicle->IsPooled()) return;
+
+	UPrimitiveComponent* Body = Cast<UPrimitiveComponent>(Vehicle->GetRootComponent());
+	if (!Body) return;
+
+	Vehicle->SetActorTransform(State.GetTransform(), false, nullptr, ETeleportType::TeleportPhysics);
+	Body->SetPhysicsLinearVelocity(State.GetLinearVelocity());
+	Body->SetPhysicsAngularVelocityInRadians(State.GetAngularVelocity());
+
+	FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr;
+	FSWPAsyncPhysicsManager* PhysManager = PhysScene ? FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene) : nullptr;
+	if (!PhysManager) return;
+
+	TArray<float, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Compressions;
+	Compressions.SetNumUninitialized(State.Compressions.Num());
+	for (int32 w = 0; w < Compressions.Num(); ++w)
+	{
+		Compressions[w] = State.GetCompression(w);
+	}
+	PhysManager->SetSuspensionCompressions(Vehicle->GetGuid(), Compressions);
+}
@@ -0,0 +1,114 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPFleetVisualizer.h"
+#include "SWPAsyncPhysicsManager.h"
+#include "SWPStat.h"
+#include "Components/InstancedStaticMeshComponent.h"
+
+// Show with 'stat SmokinWheelsPhx' in the UE console
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:FleetVisualUpdate"), STAT_SmokinWheelsPhx_FleetVisualUpdate, STATGROUP_SmokinWheelsPhx);
+
+ASWPFleetVisualizer::ASWPFleetVisualizer()
+{
+	PrimaryActorTick.bCanEverTick = false;		// Driven by the physics manager, not by Tick.
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASWPFleetVisualizer::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// One ISM per mesh part. Instances are placed in world space, so the actor pose is irrelevant.
+	for (const FSWPFleetVisualPart& Part : Parts)
+	{
+		UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(this);
+		ISM->SetStaticMesh(Part.Mesh);
+		for (int32 i = 0; i < Part.OverrideMaterials.Num(); ++i)
+		{
+			ISM->SetMaterial(i, Part.OverrideMaterials[i]);
+		}
+		ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		ISM->SetMobility(EComponentMobility::Movable);
+		ISM->SetupAttachment(RootComponent);
+		ISM->RegisterComponent();
+
+		PartComponents.Add(ISM);
+	}
+
+	if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+			PhysManager->SetVisualBackend(this);
+	}
+}
+
+void ASWPFleetVisualizer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr)
+	{
+		if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+			PhysManager->SetVisualBackend(nullptr);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASWPFleetVisualizer::ApplyVehicleOuts(const TArray<FSWPVehicleOut>& VehicleOuts)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SmokinWheelsPhx_FleetVisualUpdate);
+
+	for (int32 p = 0; p < Parts.Num() && p < PartComponents.Num(); ++p)
+	{
+		const FSWPFleetVisualPart& Part = Parts[p];
+		UInstancedStaticMeshComponent* ISM = PartComponents[p];
+		if (!ISM) continue;
+
+		// Gather all instance transforms for this part (vehicle order = output order).
+		InstanceTransforms.Reset();
+		for (const FSWPVehicleOut& VehicleOut : VehicleOuts)
+		{
+			if (Part.bPerWheel)
+			{
+				for (const FTransform& WheelTransform : VehicleOut.WheelTransforms)
+				{
+					InstanceTransforms.Add(Part.RelativeTransform * WheelTransform);
+				}
+			}
+			else
+			{
+				InstanceTransforms.Add(Part.RelativeTransform * VehicleOut.ChassisTransform);
+			}
+		}
+
+		// Fleet size changed: only the tail is added/removed, everything else is updated in place (instances
+		// are interchangeable, so index i simply shows the i-th transform of this frame).
+		const int32 NumExisting = ISM->GetInstanceCount();
+		const int32 NumTarget = InstanceTransforms.Num();
+		if (NumTarget < NumExisting)
+		{
+			RemovedInstances.Reset();
+			for (int32 i = NumExisting - 1; i >= NumTarget; --i)
+			{
+				RemovedInstances.Add(i);
+			}
+			ISM->RemoveInstances(RemovedInstances);
+		}
+
+		AddedTransforms.Reset();
+		if (NumTarget > NumExisting)
+		{
+			AddedTransforms.Append(InstanceTransforms.GetData() + NumExisting, NumTarget - NumExisting);
+			InstanceTransforms.SetNum(NumExisting, EAllowShrinking::No);
+		}
+
+		if (InstanceTransforms.Num() > 0)
+		{
+			ISM->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+		}
+		if (AddedTransforms.Num() > 0)
+		{
+			ISM->AddInstances(AddedTransforms, false, true);
+		}
+	}
+}
@@ -0,0 +1,240 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPHibernationSubsystem.h"
+#include "SWPAsyncPhysicsManager.h"
+#include "SWPFleetNetCodec.h"
+#include "SWPStat.h"
+#include "SWPVehicle.h"
+
+// Show with 'stat SmokinWheelsPhx' in the UE console
+DECLARE_CYCLE_STAT(TEXT("SmokinWheelsPhx:Rehydrate"), STAT_SmokinWheelsPhx_Rehydrate, STATGROUP_SmokinWheelsPhx);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SmokinWheelsPhx:Rehydrated vehicles"), STAT_SmokinWheelsPhx_RehydratedVehicles, STATGROUP_SmokinWheelsPhx);
+
+// Streaming hibernation (read when the world begins play): unloaded vehicles keep their state for the next load.
+// Off by default: while on, every vehicle's replication state is quantized on the PT each step.
+static bool GSWP_Hibernation = false;
+FAutoConsoleVariableRef CVarSWP_Hibernation(
+	TEXT("swp.Hibernation"),
+	GSWP_Hibernation,
+	TEXT("If true, vehicles unloaded with their level are hibernated and restored when it streams back in (1/0). Costs a per-step state quantization of the whole fleet. Read at world begin play."),
+	ECVF_Default
+);
+
+// Rehydration budget: a reloaded cell re-enters the simulation a few vehicles per frame.
+static int32 GSWP_MaxRehydrationsPerFrame = 16;
+FAutoConsoleVariableRef CVarSWP_MaxRehydrationsPerFrame(
+	TEXT("swp.MaxRehydrationsPerFrame"),
+	GSWP_MaxRehydrationsPerFrame,
+	TEXT("Max number of hibernated vehicles rehydrated per game frame (0 = unlimited)."),
+	ECVF_Default
+);
+
+static FSWPAsyncPhysicsManager* SWP_GetPhysicsManager(const UWorld* World)
+{
+	FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+	return PhysScene ? FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene) : nullptr;
+}
+
+bool USWPHibernationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USWPHibernationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Clients get vehicle state from the server.
+	bEnabled = GSWP_Hibernation && InWorld.GetNetMode() != NM_Client;
+	if (!bEnabled) return;
+
+	if (FSWPAsyncPhysicsManager* PhysManager = SWP_GetPhysicsManager(&InWorld))
+		PhysManager->SetHibernationEnabled(true);
+}
+
+void USWPHibernationSubsystem::Deinitialize()
+{
+	if (bEnabled)
+	{
+		if (FSWPAsyncPhysicsManager* PhysManager = SWP_GetPhysicsManager(GetWorld()))
+			PhysManager->SetHibernationEnabled(false);
+	}
+
+	bEnabled = false;
+	NumHibernated = 0;
+	Cells.Reset();
+	PendingRehydrations.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId USWPHibernationSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_SmokinWheelsPhx_Rehydrate);
+}
+
+// Latest quantized PT state, coded as a full update (no baseline) and appended to the cell's buffer. A vehicle
+// that still has a record (unloaded again before it was rehydrated) has its old bytes dropped first.
+bool USWPHibernationSubsystem::HibernateVehicle(const ASWPVehicle* Vehicle)
+{
+	if (!bEnabled || !IsValid(Vehicle)) return false;
+
+	const FSWPAsyncPhysicsManager* PhysManager = SWP_GetPhysicsManager(GetWorld());
+	const FSWPVehicleOut* VehicleOut = PhysManager ? PhysManager->FindLatestVehicleOut(Vehicle->GetGuid()) : nullptr;
+	if (!VehicleOut || !VehicleOut->NetState.bValid) return false;
+
+	FBitWriter Writer(0, true);
+	FSWPFleetNetCodec::Write(Writer, VehicleOut->NetState, FSWPNetVehicleState(), FSWPNetVehicleState::AllFields);
+	if (Writer.IsError() || Writer.GetNumBytes() > MAX_uint16) return false;
+
+	FHibernatedCell& Cell = Cells.FindOrAdd(GetCellName(Vehicle));
+	if (const FHibernatedVehicle* Existing = Cell.Vehicles.Find(Vehicle->GetFName()))
+	{
+		RemoveRecord(Cell, *Existing);
+	}
+	else
+	{
+		++NumHibernated;
+	}
+
+	FHibernatedVehicle& Entry = Cell.Vehicles.Add(Vehicle->GetFName());
+	Entry.Offset = Cell.Records.Num();
+	Entry.NumBytes = static_cast<uint16>(Writer.GetNumBytes());
+	Entry.Gear = static_cast<int8>(FMath::Clamp(VehicleOut->Gear, static_cast<int32>(MIN_int8), static_cast<int32>(MAX_int8)));
+	Entry.Controls = FVector3f(VehicleOut->Controls.Throttle, VehicleOut->Controls.Steering, VehicleOut->Controls.Brake);
+	Entry.Destination = VehicleOut->AutopilotDestination;
+	Entry.CruiseSpeed = VehicleOut->AutopilotCruiseSpeed;
+	Cell.Records.Append(Writer.GetData(), Writer.GetNumBytes());
+	return true;
+}
+
+bool USWPHibernationSubsystem::QueueRehydration(ASWPVehicle* Vehicle)
+{
+	if (!bEnabled || !IsValid(Vehicle)) return false;
+
+	const FHibernatedCell* Cell = Cells.Find(GetCellName(Vehicle));
+	if (!Cell || !Cell->Vehicles.Contains(Vehicle->GetFName())) return false;
+
+	PendingRehydrations.Add(Vehicle);
+	return true;
+}
+
+SIZE_T USWPHibernationSubsystem::GetHibernatedBytes() const
+{
+	SIZE_T Bytes = Cells.GetAllocatedSize();
+	for (const TPair<FName, FHibernatedCell>& Cell : Cells)
+	{
+		Bytes += Cell.Value.Records.GetAllocatedSize() + Cell.Value.Vehicles.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+// Oldest requests first, up to the budget; vehicles unloaded again before their turn are skipped (their record stays).
+void USWPHibernationSubsystem::Tick(float DeltaTime)
+{
+	if (PendingRehydrations.IsEmpty()) return;
+
+	const int32 MaxRehydrations = GSWP_MaxRehydrationsPerFrame > 0 ? GSWP_MaxRehydrationsPerFrame : PendingRehydrations.Num();
+	int32 NumRehydrated = 0;
+	int32 NumProcessed = 0;
+	for (; NumProcessed < PendingRehydrations.Num() && NumRehydrated < MaxRehydrations; ++NumProcessed)
+	{
+		ASWPVehicle* Vehicle = PendingRehydrations[NumProcessed].Get();
+		if (!IsValid(Vehicle) || !Vehicle->IsHibernated()) continue;
+
+		RehydrateVehicle(Vehicle);
+		++NumRehydrated;
+	}
+	PendingRehydrations.RemoveAt(0, NumProcessed, EAllowShrinking::No);
+
+	INC_DWORD_STAT_BY(STAT_SmokinWheelsPhx_RehydratedVehicles, NumRehydrated);
+}
+
+// Chassis teleported on the GT, then the PT loads the same pose/velocities plus compressions, gear, controls and
+// autopilot target once the body is bound (restore path: no admission budget, no settling from the level's authored pose).
+void USWPHibernationSubsystem::RehydrateVehicle(ASWPVehicle* Vehicle)
+{
+	const FName CellName = GetCellName(Vehicle);
+	FHibernatedCell* Cell = Cells.Find(CellName);
+	const FHibernatedVehicle* Entry = Cell ? Cell->Vehicles.Find(Vehicle->GetFName()) : nullptr;
+
+	FSWPNetVehicleState State;
+	FHibernatedVehicle Record;
+	if (Entry)
+	{
+		FBitReader Reader(Cell->Records.GetData() + Entry->Offset, Entry->NumBytes * 8);
+		if (!FSWPFleetNetCodec::Read(Reader, FSWPNetVehicleState(), State))
+		{
+			State.bValid = false;
+		}
+		Record = *Entry;
+
+		// Bytes compacted out, the buffer itself goes with the last vehicle of the cell.
+		RemoveRecord(*Cell, Record);
+		Cell->Vehicles.Remove(Vehicle->GetFName());
+		--NumHibernated;
+		if (Cell->Vehicles.IsEmpty())
+		{
+			Cells.Remove(CellName);
+		}
+	}
+
+	if (!State.bValid)
+	{
+		Vehicle->WakeFromHibernation(Vehicle->GetActorTransform(), FVector::ZeroVector, FVector::ZeroVector, FVector3f::ZeroVector);
+		return;
+	}
+
+	const FTransform Transform = State.GetTransform();
+	const FVector LinearVelocity = State.GetLinearVelocity();
+	const FVector AngularVelocity = State.GetAngularVelocity();
+	Vehicle->WakeFromHibernation(Transform, LinearVelocity, AngularVelocity, Record.Controls);
+
+	FSWPAsyncPhysicsManager* PhysManager = SWP_GetPhysicsManager(GetWorld());
+	if (!PhysManager) return;
+
+	FSWPVehicleRestore Restore;
+	const FVector Location = Transform.GetLocation();
+	const FQuat Rotation = Transform.GetRotation();
+	for (int32 a = 0; a < 3; ++a)
+	{
+		Restore.Location[a] = Location[a];
+		Restore.LinearVelocity[a] = static_cast<float>(LinearVelocity[a]);
+		Restore.AngularVelocity[a] = static_cast<float>(AngularVelocity[a]);
+	}
+	Restore.Rotation[0] = static_cast<float>(Rotation.X);
+	Restore.Rotation[1] = static_cast<float>(Rotation.Y);
+	Restore.Rotation[2] = static_cast<float>(Rotation.Z);
+	Restore.Rotation[3] = static_cast<float>(Rotation.W);
+	Restore.Gear = Record.Gear;
+	Restore.Controls = FSWPVehicleControls{ Record.Controls.X, Record.Controls.Y, Record.Controls.Z };
+	Restore.Destination = Record.Destination;
+	Restore.CruiseSpeed = Record.CruiseSpeed;
+
+	TArray<float, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Compressions;
+	Compressions.SetNumUninitialized(State.Compressions.Num());
+	for (int32 w = 0; w < Compressions.Num(); ++w)
+	{
+		Compressions[w] = State.GetCompression(w);
+	}
+	PhysManager->RestoreVehicle(Vehicle->GetGuid(), Restore, Compressions);
+}
+
+// Closes the gap left by a record, so a cell that never empties does not grow with every reload.
+void USWPHibernationSubsystem::RemoveRecord(FHibernatedCell& Cell, const FHibernatedVehicle& Record)
+{
+	Cell.Records.RemoveAt(Record.Offset, Record.NumBytes, EAllowShrinking::No);
+	for (TPair<FName, FHibernatedVehicle>& Other : Cell.Vehicles)
+	{
+		if (Other.Value.Offset > Record.Offset)
+		{
+			Other.Value.Offset -= Record.NumBytes;
+		}
+	}
+}
+
+FName USWPHibernationSubsystem::GetCellName(const AActor* Actor)
+{
+	const ULevel* Level = Actor->GetLevel();
+	return Level ? Level->GetPackage()->GetFName() : NAME_None;
+}
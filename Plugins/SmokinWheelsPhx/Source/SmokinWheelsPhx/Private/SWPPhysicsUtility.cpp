@@ -1,21 +1,90 @@
 // Copyright (c) [2025] [Federico Grenoville]
 
 #include "SWPPhysicsUtility.h"
+#include "Chaos/Box.h"
+#include "Physics/PhysicsFiltering.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
 
-void FSWPPhysicsUtility::AddForceAtLocation(Chaos::FPBDRigidParticleHandle* RigidHandle,
-												const FVector Location, const FVector Force)
+void FSWPPhysicsUtility::AddForceAndTorque(Chaos::FPBDRigidParticleHandle* RigidHandle,
+												const FVector Force, const FVector Torque)
 {
 	if (!RigidHandle) return;
 
-	// World-space Center of Mass (not the pivot). Using CoM gives the correct torque arm.
-	const Chaos::FVec3 CoM = RigidHandle->XCom();
-
-	// r = Location - CoM (both in world space). τ = r × F.
-	const Chaos::FVec3 Torque = Chaos::FVec3::CrossProduct(Location - CoM, Force);
-
-	// Apply force and torque for this step.
-	// The boolean flag uses Chaos' API semantics; 'false' here means we add a regular force/torque
-	// to be integrated by the solver (not a mass-independent accel/impulse mode).
 	RigidHandle->AddForce(Force, false);
 	RigidHandle->AddTorque(Torque, false);
 }
+
+FPhysicsActorHandle FSWPPhysicsUtility::CreateChassisParticle(FPhysScene* PhysScene, const FTransform& Transform,
+												const FVector& HalfExtents, float MassKg)
+{
+	check(IsInGameThread());
+
+	if (!PhysScene || MassKg <= 0.0f) return nullptr;
+
+	FActorCreationParams Params;
+	Params.Scene = PhysScene;
+	Params.InitialTM = Transform;
+	Params.bStatic = false;
+	Params.bQueryOnly = false;
+	Params.bSimulatePhysics = true;
+	Params.bEnableGravity = true;
+
+	FPhysicsActorHandle Handle = nullptr;
+	FPhysicsInterface::CreateActor(Params, Handle);
+	if (!Handle) return nullptr;
+
+	Chaos::FRigidBodyHandle_External& Body = Handle->GetGameThreadAPI();
+
+	// Box collision, simulation only.
+	Body.SetGeometry(Chaos::MakeImplicitObjectPtr<Chaos::TBox<Chaos::FReal, 3>>(-HalfExtents, HalfExtents));
+
+	FCollisionFilterData QueryFilter;
+	FCollisionFilterData SimFilter;
+	CreateShapeFilterData(ECC_PhysicsBody, FMaskFilter(0), 0, FCollisionResponseContainer::GetDefaultResponseContainer(),
+		0, 0, QueryFilter, SimFilter, false, false, false);
+	
+	for (const TUniquePtr<Chaos::FPerShapeData>& Shape : Body.ShapesArray())
+	{
+		Shape->SetQueryData(QueryFilter);
+		Shape->SetSimData(SimFilter);
+		Shape->SetQueryEnabled(false);
+		Shape->SetSimEnabled(true);
+	}
+
+	// Solid box inertia: I = m/12 * (b² + c²) per axis (full extents).
+	const FVector Size = HalfExtents * 2.0;
+	const Chaos::FVec3f Inertia(
+		MassKg / 12.0f * static_cast<float>(Size.Y * Size.Y + Size.Z * Size.Z),
+		MassKg / 12.0f * static_cast<float>(Size.X * Size.X + Size.Z * Size.Z),
+		MassKg / 12.0f * static_cast<float>(Size.X * Size.X + Size.Y * Size.Y));
+
+	Body.SetM(MassKg);
+	Body.SetInvM(1.0f / MassKg);
+	Body.SetI(Inertia);
+	Body.SetInvI(Inertia.Reciprocal());
+	Body.SetCenterOfMass(Chaos::FVec3::ZeroVector);
+	Body.SetRotationOfMass(Chaos::FRotation3::Identity);
+	Body.SetGravityEnabled(true);
+	Body.SetObjectState(Chaos::EObjectStateType::Dynamic);
+
+	TArray<FPhysicsActorHandle> Handles = { Handle };
+	FPhysicsCommand::ExecuteWrite(PhysScene, [PhysScene, &Handles]()
+	{
+		PhysScene->AddActorsToScene_AssumesLocked(Handles, true);
+	});
+
+	return Handle;
+}
+
+void FSWPPhysicsUtility::ReleaseChassisParticle(FPhysScene* PhysScene, FPhysicsActorHandle& Handle)
+{
+	check(IsInGameThread());
+
+	if (!Handle) return;
+
+	// Removes the particle from the solver and frees the proxy (Handle is reset).
+	FPhysicsInterface::ReleaseActor(Handle, PhysScene);
+	Handle = nullptr;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "RewindData.h"
+#include "SWPAsyncCallback.h"
+
+/**
+ * FSWPRewindCallback (PT side)
+ *
+ * Chaos rewind callback installed by FSWPAsyncPhysicsManager::EnableRewindHistory(). Tells the
+ * plugin's callback which physics step is running and when a resimulation starts, so its state
+ * history can be saved per step and restored on rewind. A game rewind callback (e.g., the one
+ * deciding when to rewind after a server correction) is wrapped and receives every call.
+ */
+class FSWPRewindCallback : public Chaos::IRewindCallback
+{
+public:
+	FSWPRewindCallback(FSWPAsyncCallback* InAsyncCallback, TUniquePtr<Chaos::IRewindCallback>&& InGameCallback)
+		: AsyncCallback(InAsyncCallback)
+		, GameCallback(MoveTemp(InGameCallback))
+	{
+	}
+
+	virtual void ProcessInputs_External(int32 PhysicsStep, const TArray<Chaos::FSimCallbackInputAndObject>& SimCallbackInputs) override
+	{
+		if (GameCallback)
+		{
+			GameCallback->RewindData = RewindData;
+			GameCallback->ProcessInputs_External(PhysicsStep, SimCallbackInputs);
+		}
+	}
+
+	virtual void ProcessInputs_Internal(int32 PhysicsStep, const TArray<Chaos::FSimCallbackInputAndObject>& SimCallbackInputs) override
+	{
+		AsyncCallback->SetPhysicsStep_Internal(PhysicsStep);
+		if (GameCallback)
+		{
+			GameCallback->RewindData = RewindData;
+			GameCallback->ProcessInputs_Internal(PhysicsStep, SimCallbackInputs);
+		}
+	}
+
+	virtual int32 TriggerRewindIfNeeded_Internal(int32 LatestStepCompleted) override
+	{
+		return GameCallback ? GameCallback->TriggerRewindIfNeeded_Internal(LatestStepCompleted) : INDEX_NONE;
+	}
+
+	virtual void PreResimStep_Internal(int32 PhysicsStep, bool bFirstStep) override
+	{
+		AsyncCallback->PreResimStep_Internal(PhysicsStep, bFirstStep);
+		if (GameCallback)
+		{
+			GameCallback->PreResimStep_Internal(PhysicsStep, bFirstStep);
+		}
+	}
+
+	virtual void PostResimStep_Internal(int32 PhysicsStep) override
+	{
+		AsyncCallback->PostResimStep_Internal(PhysicsStep);
+		if (GameCallback)
+		{
+			GameCallback->PostResimStep_Internal(PhysicsStep);
+		}
+	}
+
+	virtual void InjectInputs_External(int32 PhysicsStep, int32 NumSteps) override
+	{
+		if (GameCallback)
+		{
+			GameCallback->InjectInputs_External(PhysicsStep, NumSteps);
+		}
+	}
+
+	virtual void RegisterRewindableSimCallback_Internal(Chaos::ISimCallbackObject* Callback) override
+	{
+		if (GameCallback)
+		{
+			GameCallback->RegisterRewindableSimCallback_Internal(Callback);
+		}
+	}
+
+	virtual void UnregisterRewindableSimCallback_Internal(Chaos::ISimCallbackObject* Callback) override
+	{
+		if (GameCallback)
+		{
+			GameCallback->UnregisterRewindableSimCallback_Internal(Callback);
+		}
+	}
+
+private:
+	FSWPAsyncCallback* AsyncCallback;
+	TUniquePtr<Chaos::IRewindCallback> GameCallback;
+};
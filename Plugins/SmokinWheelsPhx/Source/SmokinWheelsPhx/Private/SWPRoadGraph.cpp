@@ -0,0 +1,71 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPRoadGraph.h"
+#include "Components/SplineComponent.h"
+#include "SWPAsyncPhysicsManager.h"
+
+int32 USWPRoadGraph::AppendSpline(const USplineComponent* Spline, float SpacingCm, float SpeedLimitKmh, bool bOneWay)
+{
+	if (!Spline) return INDEX_NONE;
+
+	const float Length = Spline->GetSplineLength();
+	const int32 NumSegments = FMath::Max(FMath::CeilToInt32(Length / FMath::Max(SpacingCm, 1.0f)), 1);
+	const bool bLoop = Spline->IsClosedLoop();
+
+	// A closed spline ends where it starts: its last sample would duplicate the first node.
+	const int32 NumSamples = bLoop ? NumSegments : NumSegments + 1;
+	const int32 FirstNode = Nodes.Num();
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		FSWPRoadNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Location = Spline->GetLocationAtDistanceAlongSpline(Length * i / NumSegments, ESplineCoordinateSpace::World);
+		Node.SpeedLimitKmh = SpeedLimitKmh;
+	}
+
+	for (int32 i = 0; i + 1 < NumSamples; ++i)
+	{
+		LinkNodes(FirstNode + i, FirstNode + i + 1, bOneWay);
+	}
+	if (bLoop && NumSamples > 1)
+	{
+		LinkNodes(FirstNode + NumSamples - 1, FirstNode, bOneWay);
+	}
+
+	return FirstNode;
+}
+
+void USWPRoadGraph::LinkNodes(int32 From, int32 To, bool bOneWay)
+{
+	if (!Nodes.IsValidIndex(From) || !Nodes.IsValidIndex(To) || From == To) return;
+
+	Nodes[From].Links.AddUnique(To);
+	if (!bOneWay)
+	{
+		Nodes[To].Links.AddUnique(From);
+	}
+}
+
+int32 USWPRoadGraph::FindNearestNode(const FVector& Location) const
+{
+	int32 Nearest = INDEX_NONE;
+	double NearestDistSq = TNumericLimits<double>::Max();
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		const double DistSq = FVector::DistSquared(Nodes[i].Location, Location);
+		if (DistSq < NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			Nearest = i;
+		}
+	}
+	return Nearest;
+}
+
+void USWPRoadGraph::InstallInWorld(UWorld* World) const
+{
+	FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+	if (!PhysScene) return;
+
+	if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+		PhysManager->SetRoadGraph(this);
+}
@@ -0,0 +1,13 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#include "SWPSurfaceTable.h"
+#include "SWPAsyncPhysicsManager.h"
+
+void USWPSurfaceTable::InstallInWorld(UWorld* World) const
+{
+	FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+	if (!PhysScene) return;
+
+	if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
+		PhysManager->SetSurfaceTable(this);
+}
@@ -4,9 +4,9 @@
 
 USWPSuspension::USWPSuspension()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 
-	// --- Default tuning parameters (can be adjusted via UI) ---
+	// Defaults of the old component: values equal to them were not saved.
 	TravelCm = 80.0f;
 	SpringStiffness = 35000.0f;
 	ShockBump = 4300.0f;
@@ -15,17 +15,3 @@ USWPSuspension::USWPSuspension()
 	
 	WheelRadiusCm = 30.0f;
 }
-
-void USWPSuspension::BeginPlay()
-{
-	Super::BeginPlay();
-}
-
-void USWPSuspension::TickComponent(float DeltaTime, ELevelTick TickType,
-										FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// Note: game-thread tick is unused here. All physics happens in PT.
-}
-
@@ -2,71 +2,338 @@
 
 #include "SWPVehicle.h"
 #include "SWPAsyncPhysicsManager.h"
+#include "SWPCustomVersion.h"
+#include "SWPHibernationSubsystem.h"
 #include "SWPSuspension.h"
 
 ASWPVehicle::ASWPVehicle()
 {
+	// No per-actor tick: the chassis is kept awake on PT and config sampling is a single
+	// batched pass in FSWPAsyncPhysicsManager::ScenePreTick. Subclasses may opt back in.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	Guid = FGuid();
 	VehicleMass = 1'500.0f;
 	
-	// --- Vehicle composition: chassis + four suspensions ---
+	// --- Vehicle composition: chassis + wheel definitions (plain data, no per-wheel components) ---
 	BodyMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BodyMesh"));
 	RootComponent = BodyMeshComponent;
 
-	FrontLeftSuspension = CreateDefaultSubobject<USWPSuspension>("FrontLeftSuspension");
-	FrontLeftSuspension->SetupAttachment(BodyMeshComponent);
+	// Default layout: two axles. Trucks/trailers simply append more entries.
+	Wheels.Emplace(TEXT("FrontLeft"), FVector(130.0f, -80.0f, 0.0f));
+	Wheels.Emplace(TEXT("FrontRight"), FVector(130.0f, 80.0f, 0.0f));
+	Wheels.Emplace(TEXT("RearLeft"), FVector(-130.0f, -80.0f, 0.0f));
+	Wheels.Emplace(TEXT("RearRight"), FVector(-130.0f, 80.0f, 0.0f));
+	Wheels[0].MaxSteerAngle = 35.0f;	// Front steering.
+	Wheels[1].MaxSteerAngle = 35.0f;
+	Wheels[2].bDriven = true;			// Rear-wheel drive.
+	Wheels[3].bDriven = true;
 
-	FrontRightSuspension = CreateDefaultSubobject<USWPSuspension>("FrontRightSuspension");
-	FrontRightSuspension->SetupAttachment(BodyMeshComponent);
+#if WITH_EDITORONLY_DATA
+	// Same subobject names as the old components, so their saved placement/tuning loads into them (see PostLoad).
+	static const TCHAR* LegacySuspensionNames[] = { TEXT("FrontLeftSuspension"), TEXT("FrontRightSuspension"), TEXT("RearLeftSuspension"), TEXT("RearRightSuspension") };
+	for (const TCHAR* LegacySuspensionName : LegacySuspensionNames)
+	{
+		USWPSuspension* LegacySuspension = CreateEditorOnlyDefaultSubobject<USWPSuspension>(LegacySuspensionName);
+		if (LegacySuspension)
+		{
+			LegacySuspension->SetupAttachment(BodyMeshComponent);
+			LegacySuspensions.Add(LegacySuspension);
+		}
+	}
+#endif
+}
 
-	RearLeftSuspension = CreateDefaultSubobject<USWPSuspension>("RearLeftSuspension");
-	RearLeftSuspension->SetupAttachment(BodyMeshComponent);
+void ASWPVehicle::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
 
-	RearRightSuspension = CreateDefaultSubobject<USWPSuspension>("RearRightSuspension");
-	RearRightSuspension->SetupAttachment(BodyMeshComponent);
+	Ar.UsingCustomVersion(FSWPCustomVersion::GUID);
 }
 
-void ASWPVehicle::BeginPlay()
+void ASWPVehicle::PostLoad()
 {
-	Super::BeginPlay();
+	Super::PostLoad();
 
-	if (GetWorld())
+#if WITH_EDITORONLY_DATA
+	// Saved with the four suspension components: their mount and tuning become the matching Wheels entries
+	// (steering/drive flags keep the default layout). Re-saving the asset makes this permanent.
+	if (GetLinkerCustomVersion(FSWPCustomVersion::GUID) < FSWPCustomVersion::WheelDefinitions)
 	{
-		if (FPhysScene* PhysScene = GetWorld()->GetPhysicsScene())
+		for (int32 i = 0; i < LegacySuspensions.Num() && i < Wheels.Num(); ++i)
 		{
-			if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
-				Guid = PhysManager->AddVehicle(this);
+			USWPSuspension* LegacySuspension = LegacySuspensions[i];
+			if (!LegacySuspension) continue;
+
+			LegacySuspension->ConditionalPostLoad();
+
+			FSWPWheelDefinition& Wheel = Wheels[i];
+			Wheel.Preset = nullptr;
+			Wheel.AttachLocal = LegacySuspension->GetRelativeTransform();
+			Wheel.TravelCm = LegacySuspension->TravelCm;
+			Wheel.SpringStiffness = LegacySuspension->SpringStiffness;
+			Wheel.ShockBump = LegacySuspension->ShockBump;
+			Wheel.ShockRebound = LegacySuspension->ShockRebound;
+			Wheel.MaxForce = LegacySuspension->MaxForce;
+			Wheel.WheelRadiusCm = LegacySuspension->WheelRadiusCm;
 		}
 	}
+#endif
+}
+
+void ASWPVehicle::BeginPlay()
+{
+	Super::BeginPlay();
 
-	// --- Chassis rigid body setup (mass & simulation flags) ---
 	BodyMeshComponent->SetMassOverrideInKg(NAME_None, VehicleMass);
-	BodyMeshComponent->SetSimulatePhysics(true);
-	BodyMeshComponent->SetEnableGravity(true);
+	BodyMeshComponent->OnComponentPhysicsStateChanged.AddDynamic(this, &ASWPVehicle::OnBodyPhysicsStateChanged);
+
+	// Streamed back in with a hibernation record: parked until the subsystem's rehydration batch.
+	USWPHibernationSubsystem* Hibernation = GetWorld() ? GetWorld()->GetSubsystem<USWPHibernationSubsystem>() : nullptr;
+	if (Hibernation && Hibernation->QueueRehydration(this))
+	{
+		bHibernated = true;
+		PooledCollisionEnabled = BodyMeshComponent->GetCollisionEnabled();
+		BodyMeshComponent->SetSimulatePhysics(false);
+		BodyMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		SetActorHiddenInGame(true);
+		return;
+	}
+
+	EnterSimulation();
 }
 
 void ASWPVehicle::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (GetWorld())
+	BodyMeshComponent->OnComponentPhysicsStateChanged.RemoveDynamic(this, &ASWPVehicle::OnBodyPhysicsStateChanged);
+
+	// Still parked: never registered, its record is kept for the next load.
+	if (bHibernated)
 	{
-		if (FPhysScene* PhysScene = GetWorld()->GetPhysicsScene())
-		{
-			if (FSWPAsyncPhysicsManager* PhysManager = FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene))
-				PhysManager->RemoveVehicle(this);
-		}
+		Super::EndPlay(EndPlayReason);
+		return;
 	}
+
+	// Unloaded with its level (World Partition cell, streamed sub-level): record the state before the slot goes.
+	if (EndPlayReason == EEndPlayReason::RemovedFromWorld && !bPooled)
+	{
+		if (USWPHibernationSubsystem* Hibernation = GetWorld() ? GetWorld()->GetSubsystem<USWPHibernationSubsystem>() : nullptr)
+			Hibernation->HibernateVehicle(this);
+	}
+
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+		PhysManager->RemoveVehicle(this);
 	
 	Super::EndPlay(EndPlayReason);
 }
 
-void ASWPVehicle::Tick(float DeltaTime)
+void ASWPVehicle::WakeFromHibernation(const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity, const FVector3f& Controls)
+{
+	if (!bHibernated) return;
+	bHibernated = false;
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	BodyMeshComponent->SetCollisionEnabled(PooledCollisionEnabled);
+	BodyMeshComponent->SetSimulatePhysics(true);
+	SetActorHiddenInGame(false);
+	EnterSimulation();
+	BodyMeshComponent->SetPhysicsLinearVelocity(LinearVelocity);
+	BodyMeshComponent->SetPhysicsAngularVelocityInRadians(AngularVelocity);
+	LastControls = Controls;		// Restored on the PT with the rest of the record.
+}
+
+void ASWPVehicle::DeactivateToPool(const FVector& ParkLocation)
+{
+	if (bPooled) return;
+	bPooled = true;
+
+	// Park the body: no simulation, no collision, no rendering. The particle itself is kept.
+	PooledCollisionEnabled = BodyMeshComponent->GetCollisionEnabled();
+	BodyMeshComponent->SetSimulatePhysics(false);
+	BodyMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetActorHiddenInGame(true);
+	SetActorLocation(ParkLocation, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+		PhysManager->SetVehicleActive(Guid, false);
+}
+
+void ASWPVehicle::ActivateFromPool(const FTransform& Transform)
+{
+	if (!bPooled) return;
+	bPooled = false;
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	BodyMeshComponent->SetCollisionEnabled(PooledCollisionEnabled);
+	BodyMeshComponent->SetSimulatePhysics(true);
+	BodyMeshComponent->SetPhysicsLinearVelocity(FVector::ZeroVector);
+	BodyMeshComponent->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+	{
+		SetActorHiddenInGame(PhysManager->ShouldHideVehicleMeshes());
+
+		// New life, new GUID (IDs handed out for the previous one must not reach this one). Same slot:
+		// PT wipes the previous life's suspension state in place.
+		const FGuid NewGuid = FGuid::NewGuid();
+		if (PhysManager->RekeyVehicle(Guid, NewGuid))
+		{
+			Guid = NewGuid;
+		}
+		PhysManager->SetVehicleActive(Guid, true);
+		PhysManager->ResetVehicleState(Guid);
+		LastControls = FVector3f::ZeroVector;		// PT controls are part of the wiped state.
+	}
+	else
+	{
+		SetActorHiddenInGame(false);
+	}
+}
+
+void ASWPVehicle::OnBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (StateChange != EComponentPhysicsStateChange::Created) return;
+
+	// Not registered yet (BeginPlay, hibernation) or already gone: the manager ignores it.
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+		PhysManager->UpdateVehicle(this);
+}
+
+void ASWPVehicle::NotifyWheelsChanged()
+{
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+		PhysManager->UpdateVehicle(this);
+}
+
+void ASWPVehicle::SetWheelPreset(int32 WheelIndex, USWPSuspensionPreset* Preset)
 {
-	Super::Tick(DeltaTime);
+	for (int32 i = 0; i < Wheels.Num(); ++i)
+	{
+		if (WheelIndex != INDEX_NONE && WheelIndex != i) continue;
+
+		FSWPWheelDefinition& Wheel = Wheels[i];
+		Wheel.DetachPreset();
+		Wheel.Preset = Preset;
+	}
+
+	NotifyWheelsChanged();
+}
+
+void ASWPVehicle::SetContactMode(ESWPContactMode InContactMode)
+{
+	if (ContactMode == InContactMode) return;
+
+	ContactMode = InContactMode;
+	NotifyWheelsChanged();
+}
+
+void ASWPVehicle::SetControls(float Throttle, float Steering, float Brake)
+{
+	const FVector3f Controls(FMath::Clamp(Throttle, -1.0f, 1.0f), FMath::Clamp(Steering, -1.0f, 1.0f), FMath::Clamp(Brake, 0.0f, 1.0f));
+	if (Controls == LastControls) return;
+
+	// Only remember what was sent: a refused sample (not registered yet) is retried on the next call.
+	FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager();
+	if (PhysManager && PhysManager->PushControls(Guid, FSWPVehicleControls{ Controls.X, Controls.Y, Controls.Z }))
+	{
+		LastControls = Controls;
+	}
+}
+
+void ASWPVehicle::SetAutopilotDestination(int32 DestinationNode, float CruiseSpeedKmh)
+{
+	FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager();
+	if (!PhysManager) return;
+
+	PhysManager->SetAutopilotDestination(Guid, DestinationNode, CruiseSpeedKmh);
+
+	// Disengaging zeroes the PT controls: the next SetControls() must be sent even if unchanged.
+	if (DestinationNode < 0)
+	{
+		LastControls = FVector3f::ZeroVector;
+	}
+}
+
+int32 ASWPVehicle::RequestPrediction(float Throttle, float Steering, float Brake, int32 NumSteps, int32 SampleEvery)
+{
+	FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager();
+	if (!PhysManager) return INDEX_NONE;
+
+	const FSWPVehicleControls Controls{ FMath::Clamp(Throttle, -1.0f, 1.0f), FMath::Clamp(Steering, -1.0f, 1.0f), FMath::Clamp(Brake, 0.0f, 1.0f) };
+	return PhysManager->RequestPrediction(Guid, Controls, NumSteps, SampleEvery);
+}
+
+bool ASWPVehicle::GetPrediction(int32 RequestId, TArray<FTransform>& OutPoses)
+{
+	OutPoses.Reset();
+
+	FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager();
+	return PhysManager && PhysManager->TryGetPrediction(RequestId, OutPoses);
+}
+
+void ASWPVehicle::SetPowertrain(USWPPowertrainPreset* InPowertrain)
+{
+	if (Powertrain == InPowertrain) return;
+
+	Powertrain = InPowertrain;
+	NotifyWheelsChanged();
+}
+
+void ASWPVehicle::SetSensors(const TArray<FSWPSensorDefinition>& InSensors)
+{
+	Sensors = InSensors;
+	NotifyWheelsChanged();
+}
+
+bool ASWPVehicle::GetSensorRanges(int32 SensorIndex, TArray<float>& OutRangesCm) const
+{
+	OutRangesCm.Reset();
+	if (!Sensors.IsValidIndex(SensorIndex)) return false;
+
+	const FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager();
+	if (!PhysManager) return false;
+
+	// Same layout as the PT rig: sensors back to back in declaration order.
+	int32 FirstRange = 0;
+	for (int32 i = 0; i < SensorIndex; ++i)
+	{
+		FirstRange += Sensors[i].GetNumRanges();
+	}
+
+	const TConstArrayView<uint16> Ranges = PhysManager->FindLatestSensorRanges(Guid);
+	const int32 NumRanges = Sensors[SensorIndex].GetNumRanges();
+	if (FirstRange + NumRanges > Ranges.Num()) return false;
 
-	// Ensure the rigid body stays awake during the simulation.
-	BodyMeshComponent->WakeRigidBody();
+	OutRangesCm.Reserve(NumRanges);
+	for (int32 i = FirstRange; i < FirstRange + NumRanges; ++i)
+	{
+		OutRangesCm.Add(Ranges[i] == FSWPSensorRig::NoHit ? -1.0f : static_cast<float>(Ranges[i]));
+	}
+	return true;
+}
+
+void ASWPVehicle::EnterSimulation()
+{
+	if (FSWPAsyncPhysicsManager* PhysManager = GetPhysicsManager())
+	{
+		Guid = PhysManager->AddVehicle(this);
+
+		// Rendering is delegated to the instanced fleet visualizer when one is active.
+		if (PhysManager->ShouldHideVehicleMeshes())
+			SetActorHiddenInGame(true);
+	}
+
+	// --- Chassis rigid body setup (simulation flags) ---
+	BodyMeshComponent->SetSimulatePhysics(true);
+	BodyMeshComponent->SetEnableGravity(true);
+}
+
+FSWPAsyncPhysicsManager* ASWPVehicle::GetPhysicsManager() const
+{
+	UWorld* World = GetWorld();
+	FPhysScene* PhysScene = World ? World->GetPhysicsScene() : nullptr;
+	return PhysScene ? FSWPAsyncPhysicsManager::GetPhysicsManagerFromScene(PhysScene) : nullptr;
 }
 
 // Called to bind functionality to input
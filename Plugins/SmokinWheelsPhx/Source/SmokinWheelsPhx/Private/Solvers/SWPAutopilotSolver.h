@@ -0,0 +1,208 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Chaos/ParticleHandle.h"
+#include "Configs/SWPVehicleControls.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Registry/SWPRoadGraphData.h"
+#include "Registry/SWPSpatialHash.h"
+#include "States/SWPAutopilotState.h"
+
+/**
+ * FSWPAutopilotSolver (PT side)
+ *
+ * AI driver for one vehicle, run as a batched stage before the vehicle step so its controls
+ * are used in the same step. Pure math on the chassis pose and the shared road graph:
+ *  - Route: A* from the nearest node when the destination (or graph) changes, in a planning pass
+ *    ahead of the stage (Plan(), a few vehicles per step), then nodes are consumed as the vehicle
+ *    reaches or passes them. Until its turn a vehicle keeps its previous route on the same graph
+ *    (a new graph drops every route: those vehicles brake until planned).
+ *  - Steering: pure pursuit on a point one lookahead distance ahead along the route, with the
+ *    vehicle's own wheelbase and max steer angle (taken from its wheel packets).
+ *  - Speed: PID on forward speed towards min(cruise, node speed limit, curve speed, stopping
+ *    speed at the destination, following distance to the vehicle ahead), split into throttle/brake.
+ */
+struct FSWPAutopilotSolver
+{
+	// Vehicles per parallel task of the autopilot stage.
+	static constexpr int32 BatchSize = 32;
+
+	// Pursuit: lookahead grows with speed (cm).
+	static constexpr float LookaheadTime = 0.8f;		// s
+	static constexpr float MinLookahead = 600.0f;
+	static constexpr float MaxLookahead = 3000.0f;
+	static constexpr float ArriveRadius = 400.0f;
+
+	// Speed profile (m/s²) and controller gains (pedal per m/s).
+	static constexpr float MaxLateralAccel = 5.0f;
+	static constexpr float ComfortDecel = 4.0f;
+	static constexpr float Kp = 0.4f;
+	static constexpr float Ki = 0.08f;
+	static constexpr float Kd = 0.02f;
+	static constexpr float MaxIntegral = 8.0f;		// m (anti-windup)
+	static constexpr float HoldSpeed = 0.5f;		// Below this with a zero target the brakes hold the vehicle.
+
+	// Following: vehicles ahead within the lane corridor (cm) keep a time gap (s) plus a standstill gap between centers.
+	static constexpr float LeadRange = 4000.0f;
+	static constexpr float LaneHalfWidth = 200.0f;
+	static constexpr float StandstillGap = 700.0f;
+	static constexpr float TimeGap = 1.5f;
+
+	// Neighbors may be null (spatial hash off): no following distance. VehicleIndex is the vehicle's item in it.
+	static void Solve(const FSWPRoadGraphData& Graph, const FSWPSpatialHash* Neighbors, const int32 VehicleIndex,
+					  const Chaos::FPBDRigidParticleHandle* Chassis, const FSWPVehiclePacket& Vehicle, const FSWPWheelPacket* WheelPackets,
+					  const float DeltaTime, FSWPAutopilotState& State, FSWPVehicleControls& OutControls)
+	{
+		const FVector3f Position(Chassis->GetX());
+		const FQuat4f Rotation(Chassis->GetR());
+		const float Speed = FVector3f::DotProduct(FVector3f(Chassis->GetV()), Rotation.GetForwardVector()) * 0.01f;	// m/s
+
+		// No route (unreachable destination, empty graph, or waiting for the first plan): stop where we are.
+		const int32 LastIndex = State.Route.Num() - 1;
+		if (LastIndex < 0 || State.Route[LastIndex] >= Graph.Num())
+		{
+			OutControls = FSWPVehicleControls{ 0.0f, 0.0f, 1.0f };
+			return;
+		}
+
+		// Consume nodes that were reached, or passed (vehicle beyond the node along the next lane).
+		while (State.RouteIndex < LastIndex)
+		{
+			const FVector3f& Node = Graph.Locations[State.Route[State.RouteIndex]];
+			const FVector3f& Next = Graph.Locations[State.Route[State.RouteIndex + 1]];
+			const FVector3f ToVehicle = Position - Node;
+			if (ToVehicle.SizeSquared2D() > FMath::Square(ArriveRadius) && FVector3f::DotProduct(ToVehicle, Next - Node) <= 0.0f) break;
+
+			++State.RouteIndex;
+		}
+
+		// Lookahead point: walk the route polyline (starting at the vehicle) by the lookahead distance.
+		const float Lookahead = FMath::Clamp(FMath::Abs(Speed) * 100.0f * LookaheadTime, MinLookahead, MaxLookahead);
+		FVector3f Target = Position;
+		float Remaining = Lookahead;
+		for (int32 k = State.RouteIndex; k <= LastIndex; ++k)
+		{
+			const FVector3f& To = Graph.Locations[State.Route[k]];
+			const float SegmentLength = FVector3f::Dist(Target, To);
+			if (SegmentLength >= Remaining)
+			{
+				Target += (To - Target) * (Remaining / SegmentLength);
+				break;
+			}
+			Remaining -= SegmentLength;
+			Target = To;
+		}
+
+		// Pure pursuit: arc through the target point, curvature 2y / d² (1/cm, positive right).
+		const FVector3f Local = Rotation.UnrotateVector(Target - Position);
+		const float Curvature = 2.0f * Local.Y / FMath::Max(Local.SizeSquared2D(), 1.0f);
+
+		float Wheelbase = 0.0f;
+		float MaxSteerAngle = 0.0f;
+		GetSteeringGeometry(Vehicle, WheelPackets, Wheelbase, MaxSteerAngle);
+		const float Steering = MaxSteerAngle > 0.0f
+			? FMath::Clamp(FMath::Atan(Curvature * Wheelbase) / MaxSteerAngle, -1.0f, 1.0f)
+			: 0.0f;
+
+		// Target speed: cruise, capped by the lane's limit, the arc's lateral acceleration and the stop at the destination.
+		const int32 NextNode = State.Route[State.RouteIndex];
+		float TargetSpeed = State.CruiseSpeed;
+		if (Graph.SpeedLimits[NextNode] > 0.0f)
+		{
+			TargetSpeed = FMath::Min(TargetSpeed, Graph.SpeedLimits[NextNode]);
+		}
+		TargetSpeed = FMath::Min(TargetSpeed, FMath::Sqrt(MaxLateralAccel / FMath::Max(FMath::Abs(Curvature) * 100.0f, UE_KINDA_SMALL_NUMBER)));
+
+		const float DistanceToGo = (FVector3f::Dist(Position, Graph.Locations[NextNode]) + State.DistanceToGo[State.RouteIndex] - ArriveRadius) * 0.01f;
+		TargetSpeed = FMath::Min(TargetSpeed, FMath::Sqrt(2.0f * ComfortDecel * FMath::Max(DistanceToGo, 0.0f)));
+
+		if (Neighbors)
+		{
+			const float Gap = FindLeadGap(*Neighbors, VehicleIndex, Position, Rotation);
+			if (Gap < LeadRange)
+			{
+				TargetSpeed = FMath::Min(TargetSpeed, FMath::Max(Gap - StandstillGap, 0.0f) * 0.01f / TimeGap);
+			}
+		}
+
+		// Speed PID (throttle forward only: the autopilot never reverses).
+		const float Error = TargetSpeed - Speed;
+		State.SpeedIntegral = FMath::Clamp(State.SpeedIntegral + Error * DeltaTime, -MaxIntegral, MaxIntegral);
+		const float Derivative = DeltaTime > 0.0f ? (Error - State.PrevSpeedError) / DeltaTime : 0.0f;
+		State.PrevSpeedError = Error;
+		const float Command = Kp * Error + Ki * State.SpeedIntegral + Kd * Derivative;
+
+		OutControls.Steering = Steering;
+		if (TargetSpeed <= 0.0f && FMath::Abs(Speed) < HoldSpeed)
+		{
+			OutControls.Throttle = 0.0f;
+			OutControls.Brake = 1.0f;
+			State.SpeedIntegral = 0.0f;
+			return;
+		}
+		OutControls.Throttle = FMath::Clamp(Command, 0.0f, 1.0f);
+		OutControls.Brake = FMath::Clamp(-Command, 0.0f, 1.0f);
+	}
+
+	// Route from the node nearest to the chassis. Scratch is the planner's own (one per concurrent plan).
+	static void Plan(const FSWPRoadGraphData& Graph, const Chaos::FPBDRigidParticleHandle* Chassis, FSWPRouteScratch& Scratch, FSWPAutopilotState& State)
+	{
+		const FVector3f Position(Chassis->GetX());
+		State.bReplan = false;
+		State.RouteIndex = 0;
+		State.SpeedIntegral = 0.0f;
+		State.PrevSpeedError = 0.0f;
+		State.DistanceToGo.Reset();
+
+		if (!Graph.FindRoute(Graph.FindNearestNode(Position), State.Destination, Scratch, State.Route)) return;
+
+		// Remaining length from each node, so the stopping speed costs one lookup per step.
+		State.DistanceToGo.SetNumUninitialized(State.Route.Num());
+		float Distance = 0.0f;
+		for (int32 k = State.Route.Num() - 1; k >= 0; --k)
+		{
+			if (k + 1 < State.Route.Num())
+			{
+				Distance += FVector3f::Dist(Graph.Locations[State.Route[k]], Graph.Locations[State.Route[k + 1]]);
+			}
+			State.DistanceToGo[k] = Distance;
+		}
+	}
+
+private:
+	// Distance (cm, along our heading) to the closest vehicle ahead in our lane corridor; LeadRange when none.
+	static float FindLeadGap(const FSWPSpatialHash& Neighbors, const int32 VehicleIndex, const FVector3f& Position, const FQuat4f& Rotation)
+	{
+		float Gap = LeadRange;
+		Neighbors.ForEachInRadius(Position, LeadRange, [&Neighbors, &Gap, VehicleIndex, &Position, &Rotation](const int32 Item, const float)
+		{
+			if (Item == VehicleIndex) return;
+
+			const FVector3f Local = Rotation.UnrotateVector(Neighbors.GetPosition(Item) - Position);
+			if (Local.X > 0.0f && FMath::Abs(Local.Y) < LaneHalfWidth)
+			{
+				Gap = FMath::Min(Gap, Local.X);
+			}
+		});
+		return Gap;
+	}
+
+	// Wheelbase: longitudinal spread of the wheels (cm). Max steer: largest wheel steer angle (rad).
+	static void GetSteeringGeometry(const FSWPVehiclePacket& Vehicle, const FSWPWheelPacket* WheelPackets, float& OutWheelbase, float& OutMaxSteerAngle)
+	{
+		float MinX = MAX_flt;
+		float MaxX = -MAX_flt;
+		int32 MaxSteerDegrees = 0;
+		for (int32 w = 0; w < Vehicle.NumWheels; ++w)
+		{
+			const FSWPWheelPacket& Wheel = WheelPackets[Vehicle.FirstWheel + w];
+			MinX = FMath::Min(MinX, Wheel.AttachLocation.X);
+			MaxX = FMath::Max(MaxX, Wheel.AttachLocation.X);
+			MaxSteerDegrees = FMath::Max(MaxSteerDegrees, FMath::Abs(static_cast<int32>(Wheel.MaxSteerAngle)));
+		}
+
+		OutWheelbase = Vehicle.NumWheels > 0 ? MaxX - MinX : 0.0f;
+		OutMaxSteerAngle = FMath::DegreesToRadians(static_cast<float>(MaxSteerDegrees));
+	}
+};
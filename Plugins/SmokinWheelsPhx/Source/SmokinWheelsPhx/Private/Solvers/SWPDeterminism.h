@@ -0,0 +1,172 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Chaos/ParticleHandle.h"
+#include "States/SWPPowertrainBatch.h"
+#include "States/SWPSuspensionContact.h"
+#include "States/SWPSuspensionState.h"
+#include "States/SWPVehicleState.h"
+
+/**
+ * FSWPDeterminism (PT side, swp.Deterministic)
+ *
+ * Lockstep helpers. The step already has no cross-thread reductions (every vehicle/wheel
+ * writes only its own state, reductions run serially in step order), so results do not depend
+ * on the worker count or scheduling. On top of that, deterministic mode:
+ *  - snaps the inputs of every ground query (suspension origin and axis, fan direction) and its
+ *    results (distance, normal) to a fixed-point grid: the scene query itself is still Chaos', so
+ *    peers must run the same build on the same collision scene, but the force math only ever sees
+ *    grid values,
+ *  - runs the suspension force path (spring/damper solve, force and torque accumulation) in
+ *    64-bit fixed point instead of float, carrying the compression ratio exactly between steps,
+ *  - hashes the raw bit patterns of each vehicle's state (suspensions, gear, powertrain, controls,
+ *    autopilot, chassis pose/velocities) in parallel and sums the hashes into one checksum per
+ *    solver physics step. The sum does not depend on the local vehicle order, and no slot or
+ *    generation enters a hash, so peers with different spawn/despawn histories still agree.
+ * Chaos' integration of the applied forces is outside this: it must be deterministic on its own.
+ * The checksum is what catches a desync, on the step it appears (any differing bit counts).
+ */
+struct FSWPDeterminism
+{
+	// Vehicles per parallel task of the checksum pass.
+	static constexpr int32 BatchSize = 256;
+
+	// Grid steps: 1/1024 cm for distances, 1/32767 for unit vectors.
+	static constexpr double DistanceScale = 1024.0;
+	static constexpr double UnitScale = MAX_int16;
+
+	// Fixed point of the force path: Q16 (1/65536 of a unit, ratios 0..One).
+	static constexpr int32 FixedShift = 16;
+	static constexpr int64 FixedOne = int64(1) << FixedShift;
+
+	struct FFixedVector
+	{
+		int64 X = 0;
+		int64 Y = 0;
+		int64 Z = 0;
+
+		Chaos::FVec3 ToVector() const { return Chaos::FVec3(FromFixed(X), FromFixed(Y), FromFixed(Z)); }
+	};
+
+	static FORCEINLINE double Snap(const double Value, const double Scale)
+	{
+		return FMath::RoundToDouble(Value * Scale) / Scale;
+	}
+
+	static FORCEINLINE FVector Snap(const FVector& Value, const double Scale)
+	{
+		return FVector(Snap(Value.X, Scale), Snap(Value.Y, Scale), Snap(Value.Z, Scale));
+	}
+
+	// Query inputs: suspension origin and axis, before any trace is built from them.
+	static FORCEINLINE void QuantizeQuery(FSWPSuspensionContact& Contact)
+	{
+		Contact.Location = Snap(Contact.Location, DistanceScale);
+		Contact.Up = Snap(Contact.Up, UnitScale);
+	}
+
+	// Query results.
+	static FORCEINLINE void QuantizeContact(FSWPSuspensionContact& Contact)
+	{
+		Contact.HitDistance = static_cast<float>(Snap(Contact.HitDistance, DistanceScale));
+		Contact.ImpactNormal = Snap(Contact.ImpactNormal, UnitScale);
+	}
+
+	static FORCEINLINE int64 ToFixed(const double Value)
+	{
+		constexpr double Limit = static_cast<double>(int64(1) << 62);
+		return static_cast<int64>(FMath::Clamp(FMath::RoundToDouble(Value * FixedOne), -Limit, Limit));
+	}
+
+	static FORCEINLINE double FromFixed(const int64 Value)
+	{
+		return static_cast<double>(Value) / FixedOne;
+	}
+
+	static FORCEINLINE int64 Mul(const int64 A, const int64 B)
+	{
+		return (A * B) >> FixedShift;
+	}
+
+	static FORCEINLINE FFixedVector ToFixed(const FVector& Value)
+	{
+		return { ToFixed(Value.X), ToFixed(Value.Y), ToFixed(Value.Z) };
+	}
+
+	// FSWPSuspensionTuning::SampleTable in fixed point (same clamping and last-segment extrapolation).
+	static FORCEINLINE int64 SampleTable(const float* Table, const int32 NumSamples, const int64 X, const int64 InvStep)
+	{
+		const int64 Position = FMath::Max<int64>(Mul(X, InvStep), 0);
+		const int64 Index = FMath::Min<int64>(Position >> FixedShift, NumSamples - 2);
+		const int64 A = ToFixed(Table[Index]);
+		const int64 B = ToFixed(Table[Index + 1]);
+		return A + Mul(B - A, Position - (Index << FixedShift));
+	}
+
+	/**
+	 * Chassis force and torque of the wheels in fixed point, overwriting the float accumulation.
+	 * Arms are taken on the distance grid (Q10) so r × F stays well inside 64 bits.
+	 */
+	static void AccumulateWheels(const Chaos::FVec3& CoM, const FSWPSuspensionState* SuspensionStates, const int32 NumWheels,
+								 Chaos::FVec3& OutForce, Chaos::FVec3& OutTorque)
+	{
+		FFixedVector Force;
+		FFixedVector Torque;
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			const FFixedVector F = ToFixed(FVector(SuspensionStates[w].Fz) * 100.0);
+			const FVector Arm = SuspensionStates[w].ForceLocation - CoM;
+			const int64 RX = static_cast<int64>(FMath::RoundToDouble(Arm.X * DistanceScale));
+			const int64 RY = static_cast<int64>(FMath::RoundToDouble(Arm.Y * DistanceScale));
+			const int64 RZ = static_cast<int64>(FMath::RoundToDouble(Arm.Z * DistanceScale));
+
+			Force.X += F.X;
+			Force.Y += F.Y;
+			Force.Z += F.Z;
+			Torque.X += (RY * F.Z - RZ * F.Y) / static_cast<int64>(DistanceScale);
+			Torque.Y += (RZ * F.X - RX * F.Z) / static_cast<int64>(DistanceScale);
+			Torque.Z += (RX * F.Y - RY * F.X) / static_cast<int64>(DistanceScale);
+		}
+		OutForce = Force.ToVector();
+		OutTorque = Torque.ToVector();
+	}
+
+	// Hash of one vehicle's state once this callback's stages ran (suspensions, controls, autopilot, powertrain
+	// outputs of the step) with the chassis as Chaos hands it to the step: the pre-simulate callback runs before
+	// integration, so the pose/velocities are the previous step's result. Raw bit patterns, no quantization, and
+	// nothing local to this peer (slot, generation). Powertrain is null when the stage is off (Index into it otherwise).
+	static uint32 HashVehicle(const Chaos::FPBDRigidParticleHandle* Chassis, const FSWPVehicleState& VehicleSimState,
+							  const FSWPPowertrainBatch* Powertrain, const int32 Index)
+	{
+		const Chaos::FRotation3& Rotation = Chassis->GetR();
+		const Chaos::FReal Pose[] =
+		{
+			Chassis->GetX().X, Chassis->GetX().Y, Chassis->GetX().Z,
+			Rotation.X, Rotation.Y, Rotation.Z, Rotation.W,
+			Chassis->GetV().X, Chassis->GetV().Y, Chassis->GetV().Z,
+			Chassis->GetW().X, Chassis->GetW().Y, Chassis->GetW().Z,
+		};
+
+		const FSWPAutopilotState& Autopilot = VehicleSimState.Autopilot;
+		const float Values[] =
+		{
+			VehicleSimState.Controls.Throttle, VehicleSimState.Controls.Steering, VehicleSimState.Controls.Brake,
+			Autopilot.CruiseSpeed, Autopilot.SpeedIntegral, Autopilot.PrevSpeedError,
+			Powertrain ? Powertrain->EngineRPM[Index] : 0.0f, Powertrain ? Powertrain->DriveForce[Index] : 0.0f,
+		};
+		const int32 Indices[] = { VehicleSimState.Gear, Autopilot.Destination, Autopilot.RouteIndex };
+
+		uint32 Hash = FCrc::MemCrc32(Pose, sizeof(Pose));
+		Hash = FCrc::MemCrc32(Values, sizeof(Values), Hash);
+		Hash = FCrc::MemCrc32(Indices, sizeof(Indices), Hash);
+		for (const FSWPSuspensionState& SuspensionState : VehicleSimState.Suspensions)
+		{
+			const float Wheel[] = { SuspensionState.PreviousCompressionRatio, SuspensionState.TotalForce };
+			Hash = FCrc::MemCrc32(Wheel, sizeof(Wheel), Hash);
+		}
+
+		// Mixed, so the order-independent sum of the callback does not cancel CRC's linearity.
+		return MurmurFinalize32(Hash);
+	}
+};
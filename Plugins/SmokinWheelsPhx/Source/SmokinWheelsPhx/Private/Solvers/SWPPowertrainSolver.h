@@ -0,0 +1,113 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPPowertrainTuning.h"
+#include "Solvers/SWPTireSolver.h"
+#include "States/SWPPowertrainBatch.h"
+
+/**
+ * FSWPPowertrainSolver (PT side)
+ *
+ * Engine, automatic gearbox, open differential, brakes and aero for a range of vehicles, run
+ * as its own stage between the suspension stage and the tire stage. The gearbox is locked to
+ * the driven wheels (no clutch slip): engine RPM follows their rolling speed, clamped to
+ * [Idle, Redline]. The resulting drive force is split over the driven wheels and written,
+ * together with the brake force, into each wheel's DriveForce for the tire stage, which
+ * clamps it to the available grip.
+ */
+struct FSWPPowertrainSolver
+{
+	// Vehicles per parallel task of the powertrain stage.
+	static constexpr int32 BatchSize = 64;
+
+	// Below this forward speed (m/s) a negative throttle engages reverse instead of braking.
+	static constexpr float ReverseEngageSpeed = 1.0f;
+
+	static constexpr float RadPerSecToRPM = 60.0f / UE_TWO_PI;
+
+	// Tires may be null (tire model off): aero and engine state are still computed, drive is not applied.
+	static void SolveRange(FSWPPowertrainBatch& Batch, const FSWPPowertrainTuning* Presets, FSWPTireBatch* Tires,
+						   const int32 Begin, const int32 End)
+	{
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const int32 PresetIndex = Batch.PresetIndex[i];
+			if (PresetIndex == INDEX_NONE)
+			{
+				Batch.EngineRPM[i] = 0.0f;
+				Batch.DriveForce[i] = 0.0f;
+				Batch.AeroForce[i] = FVector3f::ZeroVector;
+				continue;
+			}
+
+			const FSWPPowertrainTuning& Tuning = Presets[PresetIndex];
+			const float ForwardSpeed = Batch.ForwardSpeed[i];
+
+			// Aero: drag against the velocity, downforce along -Up with forward speed squared.
+			const FVector3f Velocity = Batch.Velocity[i];
+			Batch.AeroForce[i] = Velocity * (-Tuning.DragFactor * Velocity.Size())
+				- Batch.Up[i] * (Tuning.DownforceFactor * ForwardSpeed * ForwardSpeed);
+
+			// Driver intent: negative throttle engages reverse near standstill; a pedal against the
+			// selected direction of travel becomes a brake request.
+			int32 Gear = Batch.Gear[i];
+			float Throttle = Batch.Throttle[i];
+			float Brake = Batch.Brake[i];
+			if (Throttle < 0.0f && ForwardSpeed < ReverseEngageSpeed)
+			{
+				Gear = -1;
+			}
+			else if (Throttle > 0.0f && Gear < 0 && ForwardSpeed > -ReverseEngageSpeed)
+			{
+				Gear = 1;
+			}
+			Gear = Gear < 0 ? -1 : FMath::Clamp(Gear, 1, FMath::Max(Tuning.NumGears, 1));
+			if (Throttle * Gear < 0.0f)
+			{
+				Brake = FMath::Max(Brake, FMath::Abs(Throttle));
+				Throttle = 0.0f;
+			}
+			const float Pedal = FMath::Abs(Throttle);
+
+			// Gearbox.
+			const float GearRatio = Gear < 0 ? -Tuning.ReverseRatio : (Tuning.NumGears > 0 ? Tuning.GearRatios[Gear - 1] : 0.0f);
+			const float TotalRatio = GearRatio * Tuning.FinalDriveRatio;
+			const float DriveRadius = Batch.DriveRadius[i];
+			const float WheelSpeed = DriveRadius > 0.0f ? ForwardSpeed / DriveRadius : 0.0f;		// rad/s
+			const float RawRPM = WheelSpeed * TotalRatio * RadPerSecToRPM;
+			const float RPM = FMath::Clamp(FMath::Abs(RawRPM), Tuning.IdleRPM, Tuning.RedlineRPM);
+
+			// Engine: curve torque on throttle (cut at redline), engine braking against the rotation off throttle.
+			const float Limiter = RPM < Tuning.RedlineRPM ? 1.0f : 0.0f;
+			const float CurveTorque = Tuning.MaxTorque * FSWPSuspensionTuning::SampleTable(Tuning.TorqueTable, RPM, Tuning.TorqueInvStep);
+			const float EngineBrake = Tuning.EngineBrakeTorque * FMath::Clamp(RawRPM / Tuning.RedlineRPM, -1.0f, 1.0f);
+			const float EngineTorque = Pedal * Limiter * CurveTorque - (1.0f - Pedal) * EngineBrake;
+
+			const float DriveForce = DriveRadius > 0.0f ? EngineTorque * TotalRatio * Tuning.Efficiency / DriveRadius : 0.0f;
+
+			// Automatic shifts take effect next step.
+			if (Gear > 0)
+			{
+				if (RPM > Tuning.UpshiftRPM && Gear < Tuning.NumGears) ++Gear;
+				else if (RPM < Tuning.DownshiftRPM && Gear > 1) --Gear;
+			}
+
+			Batch.Gear[i] = Gear;
+			Batch.EngineRPM[i] = RPM;
+			Batch.DriveForce[i] = DriveForce;
+
+			if (!Tires) continue;
+
+			// Open differential (equal split over the driven wheels) and brakes (even split, against the rolling direction).
+			const int32 FirstWheel = Batch.FirstWheel[i];
+			const int32 EndWheel = FirstWheel + Batch.NumWheels[i];
+			const float BrakePerWheel = Brake * Tuning.MaxBrakeForce / FMath::Max(Batch.NumWheels[i], 1);
+			for (int32 w = FirstWheel; w < EndWheel; ++w)
+			{
+				Tires->DriveForce[w] = Tires->DriveShare[w] * DriveForce
+					- BrakePerWheel * FMath::Clamp(Tires->VelLong[w] / FSWPTireSolver::MinSlipSpeed, -1.0f, 1.0f);
+			}
+		}
+	}
+};
@@ -0,0 +1,201 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPPredictionRequest.h"
+#include "Solvers/SWPPowertrainSolver.h"
+#include "Solvers/SWPTireSolver.h"
+#include "Solvers/SWPVehicleSolver.h"
+
+/**
+ * FSWPPredictionSolver (PT side)
+ *
+ * "What-if" forward prediction of one vehicle, run as a batched stage after the vehicle step
+ * (one task per request, many requests in parallel). The vehicle's suspension states, gear and
+ * the chassis state are copied into a scratch state and context with private tire/powertrain
+ * batches; the same suspension, tire and powertrain kernels as the live step are then rolled
+ * forward with the requested controls and a semi-implicit Euler integration of the chassis.
+ *
+ * Nothing is queried or written outside the scratch state: the ground is frozen as one plane
+ * per wheel taken from the contacts of the latest step (wheels without contact use the mean
+ * plane of the others), so predictions stay cheap and never touch the live Chaos solver.
+ * Collisions of the body itself and other vehicles are not part of the prediction.
+ */
+struct FSWPPredictionSolver
+{
+	// Frozen ground under one wheel.
+	struct FGroundPlane
+	{
+		FVector Point = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;		// Zero: no ground.
+		uint8 SurfaceId = 0;
+	};
+
+	// Fills Request.NumSteps / Request.SampleEvery poses (actor transforms). False when the vehicle was not stepped yet.
+	static bool Predict(const FSWPStepContext& Context, const Chaos::FPBDRigidParticleHandle* Chassis,
+						const FSWPVehiclePacket& VehiclePacket, const FSWPWheelPacket* WheelPackets,
+						const FSWPVehicleState& VehicleSimState, const FSWPPredictionRequest& Request,
+						const float GravityZ, FTransform* OutPoses)
+	{
+		const int32 NumWheels = VehiclePacket.NumWheels;
+		if (VehicleSimState.Suspensions.Num() != NumWheels || VehicleSimState.Contacts.Num() != NumWheels) return false;
+
+		// Scratch state and context: the batched stages of the live step, sized for this vehicle only.
+		FSWPVehicleState State;
+		State.Suspensions = VehicleSimState.Suspensions;
+		State.Controls = Request.Controls;
+		State.Gear = VehicleSimState.Gear;
+
+		FSWPTireBatch Tires;
+		FSWPPowertrainBatch Powertrain;
+		FSWPStepContext Scratch = Context;
+		Scratch.Tires = Context.Tires ? &Tires : nullptr;
+		Scratch.Powertrain = Context.Powertrain ? &Powertrain : nullptr;
+		Scratch.DebugMask = 0;
+		if (Scratch.Tires) Tires.SetNum(NumWheels);
+		if (Scratch.Powertrain) Powertrain.SetNum(1);
+
+		TArray<FSWPSuspensionConfig, TInlineAllocator<FSWPVehicleSolver::MaxStackWheels>> Configs;
+		TArray<FGroundPlane, TInlineAllocator<FSWPVehicleSolver::MaxStackWheels>> Ground;
+		TArray<FSWPSuspensionContact, TInlineAllocator<FSWPVehicleSolver::MaxStackWheels>> Contacts;
+		Configs.SetNumUninitialized(NumWheels);
+		Contacts.SetNum(NumWheels);
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			Configs[w] = WheelPackets[VehiclePacket.FirstWheel + w].Unpack(Context.Presets);
+		}
+		FreezeGround(VehicleSimState.Contacts, Ground);
+
+		// Chassis state (X is the actor origin, the body rotates about its center of mass).
+		const Chaos::FVec3 CoMLocal = Chassis->CenterOfMass();
+		const FQuat MassRotation(Chassis->RotationOfMass());
+		const FVector InvInertia(Chassis->InvI());
+		const double Mass = Chassis->M();
+		const double InvMass = Chassis->InvM();
+		const double LinearDrag = Chassis->LinearEtherDrag();
+		const double AngularDrag = Chassis->AngularEtherDrag();
+		FQuat Rotation(Chassis->GetR());
+		FVector CoM = Chassis->XCom();
+		FVector Velocity = Chassis->GetV();
+		FVector AngularVelocity = Chassis->GetW();
+
+		const float DeltaTime = Context.DeltaTime;
+		const float Steering = FMath::Clamp(State.Controls.Steering, -1.0f, 1.0f);
+		const int32 SampleEvery = FMath::Max(Request.SampleEvery, 1);
+		int32 NumPoses = 0;
+
+		for (int32 Step = 1; Step <= Request.NumSteps; ++Step)
+		{
+			const FTransform ChassisTransform(Rotation, CoM - Rotation.RotateVector(CoMLocal));
+			Chaos::FVec3 Force(0.0, 0.0, Mass * GravityZ);
+			Chaos::FVec3 Torque = Chaos::FVec3::ZeroVector;
+
+			// Suspensions against the frozen ground, then the tire inputs (same order as the live step).
+			for (int32 w = 0; w < NumWheels; ++w)
+			{
+				FSWPSuspensionContact& Contact = Contacts[w];
+				const FTransform AttachWorld = Configs[w].AttachLocal * ChassisTransform;
+				Contact.Location = AttachWorld.GetLocation();
+				Contact.Up = AttachWorld.GetRotation().GetUpVector();
+				ProjectContact(Ground[w], Configs[w].Tuning->TraceLength, Contact);
+
+				const FSWPSurfaceScale& Surface = Context.SurfaceScales[Contact.SurfaceId];
+				FSWPSuspensionSolver::Solve(Configs[w], Contact, Surface, State.Suspensions[w], DeltaTime);
+				FSWPVehicleSolver::AccumulateWheel(CoM, State.Suspensions[w], Force, Torque);
+
+				if (Scratch.Tires)
+				{
+					const FQuat WheelRotation = FSWPVehicleSolver::ComputeWheelTransform(Rotation, Configs[w], Contact, Steering).GetRotation();
+					FSWPVehicleSolver::WriteTireInputs(Tires, w, Velocity, AngularVelocity, CoM, WheelRotation, Configs[w], Contact, Surface, State.Suspensions[w]);
+				}
+			}
+
+			FSWPVehicleSolver::WriteDrivelineInputs(Scratch, Rotation, Velocity, VehiclePacket, WheelPackets, 0, 0, State);
+			if (Scratch.Powertrain)
+			{
+				FSWPPowertrainSolver::SolveRange(Powertrain, Scratch.PowertrainPresets, Scratch.Tires, 0, 1);
+				State.Gear = Powertrain.Gear[0];
+				Force += Chaos::FVec3(Powertrain.AeroForce[0]) * 100.0f;
+			}
+			if (Scratch.Tires)
+			{
+				FSWPTireSolver::SolveRange(Tires, 0, NumWheels);
+				for (int32 w = 0; w < NumWheels; ++w)
+				{
+					const Chaos::FVec3 TireForce = (Tires.Forward[w] * Tires.ForceLong[w] + Tires.Right[w] * Tires.ForceLat[w]) * 100.0f;
+					Force += TireForce;
+					Torque += Chaos::FVec3::CrossProduct(Tires.ContactPoint[w] - CoM, TireForce);
+				}
+			}
+
+			// Semi-implicit Euler: velocities first (world inverse inertia from the principal axes), then the pose.
+			const FQuat PrincipalRotation = Rotation * MassRotation;
+			Velocity = (Velocity + Force * (InvMass * DeltaTime)) * FMath::Max(0.0, 1.0 - LinearDrag * DeltaTime);
+			AngularVelocity += PrincipalRotation.RotateVector(PrincipalRotation.UnrotateVector(Torque) * InvInertia) * DeltaTime;
+			AngularVelocity *= FMath::Max(0.0, 1.0 - AngularDrag * DeltaTime);
+
+			CoM += Velocity * DeltaTime;
+			const FQuat Spin(AngularVelocity.X, AngularVelocity.Y, AngularVelocity.Z, 0.0);
+			Rotation = (Rotation + Spin * Rotation * (0.5 * DeltaTime)).GetNormalized();
+
+			if (Step % SampleEvery == 0)
+			{
+				OutPoses[NumPoses++] = FTransform(Rotation, CoM - Rotation.RotateVector(CoMLocal));
+			}
+		}
+		return true;
+	}
+
+private:
+	// One plane per wheel from its latest contact; wheels in the air get the mean plane of the wheels in contact.
+	template<typename ContactAllocator, typename GroundAllocator>
+	static void FreezeGround(const TArray<FSWPSuspensionContact, ContactAllocator>& Contacts, TArray<FGroundPlane, GroundAllocator>& OutGround)
+	{
+		OutGround.SetNum(Contacts.Num());
+
+		FGroundPlane Mean;
+		int32 NumInContact = 0;
+		for (int32 w = 0; w < Contacts.Num(); ++w)
+		{
+			const FSWPSuspensionContact& Contact = Contacts[w];
+			if (Contact.ContactMask <= 0.0f) continue;
+
+			FGroundPlane& Plane = OutGround[w];
+			Plane.Point = Contact.Location - Contact.Up * Contact.HitDistance;
+			Plane.Normal = Contact.ImpactNormal;
+			Plane.SurfaceId = Contact.SurfaceId;
+
+			Mean.Point += Plane.Point;
+			Mean.Normal += Plane.Normal;
+			++NumInContact;
+		}
+		if (NumInContact == 0) return;
+
+		Mean.Point /= NumInContact;
+		Mean.Normal = Mean.Normal.GetSafeNormal();
+		Mean.SurfaceId = static_cast<uint8>(SurfaceType_Default);
+		for (int32 w = 0; w < Contacts.Num(); ++w)
+		{
+			if (Contacts[w].ContactMask <= 0.0f)
+			{
+				OutGround[w] = Mean;
+			}
+		}
+	}
+
+	// Ray along -Up from the TopLink against the wheel's plane, reported like a ground query of the live step.
+	static FORCEINLINE void ProjectContact(const FGroundPlane& Ground, const float TraceLength, FSWPSuspensionContact& Contact)
+	{
+		const double Facing = FVector::DotProduct(Contact.Up, Ground.Normal);
+		const double Distance = Facing > UE_KINDA_SMALL_NUMBER
+			? FVector::DotProduct(Contact.Location - Ground.Point, Ground.Normal) / Facing
+			: TraceLength;
+		const bool bHasContact = Distance < TraceLength;
+
+		// Below the plane (TopLink already under the ground) reads as fully compressed.
+		Contact.HitDistance = static_cast<float>(FMath::Clamp(Distance, 0.0, static_cast<double>(TraceLength)));
+		Contact.ImpactNormal = bHasContact ? Ground.Normal : FVector::ZeroVector;
+		Contact.ContactMask = bHasContact ? 1.0f : 0.0f;
+		Contact.SurfaceId = bHasContact ? Ground.SurfaceId : static_cast<uint8>(SurfaceType_Default);
+	}
+};
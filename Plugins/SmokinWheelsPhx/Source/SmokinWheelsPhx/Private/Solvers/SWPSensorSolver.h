@@ -0,0 +1,45 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Algo/BinarySearch.h"
+#include "Solvers/SWPVehicleSolver.h"
+#include "States/SWPSensorScan.h"
+
+/**
+ * FSWPSensorSolver (PT side)
+ *
+ * Traces sensor rays as a flat list over every scan of the step, in fixed-size chunks, so a
+ * single vehicle's lidar spreads over all workers instead of one task. Each ray writes only
+ * its own range (whole cm, NoHit when nothing is within range).
+ */
+struct FSWPSensorSolver
+{
+	// Rays per parallel task of the sensor stage.
+	static constexpr int32 BatchSize = 64;
+
+	// Scans are sorted by FirstRay (built in that order).
+	static void TraceRange(const FSWPStepContext& Context, TArrayView<const FSWPSensorScan> Scans, const int32 Begin, const int32 End)
+	{
+		int32 ScanIndex = Algo::UpperBoundBy(Scans, Begin, &FSWPSensorScan::FirstRay) - 1;
+		int32 Ray = Begin;
+		while (Ray < End && Scans.IsValidIndex(ScanIndex))
+		{
+			const FSWPSensorScan& Scan = Scans[ScanIndex++];
+			const FSWPSensorRig::FSensor& Sensor = *Scan.Sensor;
+			const int32 ScanEnd = FMath::Min(End, Scan.FirstRay + Sensor.NumRanges());
+			const FCollisionQueryParams TraceParams = FSWPVehicleSolver::MakeTraceParams(*Scan.Vehicle);
+
+			for (; Ray < ScanEnd; ++Ray)
+			{
+				const int32 Index = Ray - Scan.FirstRay;
+				const FVector Direction = Scan.ChassisRotation.RotateVector(FVector(Sensor.GetDirection(Index)));
+
+				FHitResult Hit;
+				Scan.Ranges[Index] = Context.World->LineTraceSingleByChannel(Hit, Scan.Origin, Scan.Origin + Direction * Sensor.Range, ECC_Visibility, TraceParams)
+					? static_cast<uint16>(FMath::Min(FMath::RoundToInt32(Hit.Distance), FSWPSensorRig::NoHit - 1))
+					: FSWPSensorRig::NoHit;
+			}
+		}
+	}
+};
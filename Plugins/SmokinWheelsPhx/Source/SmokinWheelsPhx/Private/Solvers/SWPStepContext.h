@@ -0,0 +1,43 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPPowertrainTuning.h"
+#include "Configs/SWPSurfaceScale.h"
+#include "Configs/SWPSuspensionTuning.h"
+#include "Registry/SWPSurfaceCache.h"
+
+struct FSWPPowertrainBatch;
+struct FSWPSpatialHash;
+struct FSWPTireBatch;
+
+/**
+ * PT data shared by every vehicle of one step (read-only during the parallel step).
+ * Built once per OnPreSimulate_Internal and passed by reference to the solvers.
+ */
+struct FSWPStepContext
+{
+	UWorld* World = nullptr;
+	float DeltaTime = 0.0f;
+
+	const FSWPSuspensionTuning* Presets = nullptr;		// Preset table (wheel packets index into it).
+	const FSWPSurfaceScale* SurfaceScales = nullptr;	// Indexed by surface ID (SurfaceType_Max entries).
+	const FSWPSurfaceCache* SurfaceCache = nullptr;
+	bool bResolveSurfaces = true;						// swp.SurfaceAware
+	bool bDeterministic = false;						// swp.Deterministic: snapped ground queries, fixed-point force path (FSWPDeterminism).
+
+	// Fleet tire batch (swp.TireModel), each vehicle writes its own wheel range. Null when off.
+	FSWPTireBatch* Tires = nullptr;
+	// Fleet powertrain/aero batch (swp.Powertrain), indexed by step order. Null when off.
+	FSWPPowertrainBatch* Powertrain = nullptr;
+	const FSWPPowertrainTuning* PowertrainPresets = nullptr;
+
+	// Chassis positions of this step (swp.SpatialHash), items are step indices. Null when off.
+	const FSWPSpatialHash* Neighbors = nullptr;
+
+	// Debug categories to emit this step (0 when debug draw is off): skips building unused commands.
+	uint32 DebugMask = 0;
+
+	// Force application waits for the later stages when any of them runs.
+	FORCEINLINE bool DefersApply() const { return Tires || Powertrain; }
+};
@@ -3,90 +3,334 @@
 #pragma once
 
 #include "Configs/SWPSuspensionConfig.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Solvers/SWPDeterminism.h"
+#include "Solvers/SWPStepContext.h"
+#include "States/SWPSuspensionContact.h"
 #include "States/SWPSuspensionState.h"
 
 struct FSWPSuspensionSolver
 {
-	static FORCEINLINE void Compute(UWorld* World,
-									const TWeakObjectPtr<AActor> VehicleActor,
-									const FTransform& VehicleAsyncTransformWorld,
-									const FSWPSuspensionConfig& SuspensionConfig,
-									FSWPSuspensionState& SuspensionState,
-									FSWPVehicleOut& VehicleOut,
-									float PhysicsDeltaTime)
+	// RayFan: offsets along the rolling direction as a fraction of the wheel radius.
+	static constexpr int32 NumFanRays = 5;
+	static constexpr float FanOffsets[NumFanRays] = { -0.7f, -0.35f, 0.0f, 0.35f, 0.7f };
+
+	/**
+	 * Ground query for one wheel (the only branchy part of the suspension step).
+	 * Fills OutContact; the force math lives in Solve() and is branch-free. Every contact
+	 * mode reports the same thing: the distance along the suspension axis at which a wheel
+	 * centered under the TopLink would touch the ground (full trace length without contact).
+	 */
+	static FORCEINLINE void Trace(const FSWPStepContext& Context,
+								  const ESWPContactMode ContactMode,
+								  const FCollisionQueryParams& TraceParams,
+								  const FTransform& VehicleAsyncTransformWorld,
+								  const FSWPSuspensionConfig& SuspensionConfig,
+								  FSWPSuspensionContact& OutContact,
+								  TArray<FSWPSurfaceCache::FEntry>& OutNewSurfaces,
+								  FSWPVehicleOut& VehicleOut)
 	{
 		// Compute suspension transform in world space.
 		const FTransform AsyncWorld = SuspensionConfig.AttachLocal * VehicleAsyncTransformWorld;
-		const FQuat AsyncRotation = AsyncWorld.GetRotation();
 
-		FVector AsyncLocation = AsyncWorld.GetLocation();
-		FVector AsyncUp = AsyncRotation.GetUpVector();
+		OutContact.Location = AsyncWorld.GetLocation();
+		OutContact.Up = AsyncWorld.GetRotation().GetUpVector();
+		if (Context.bDeterministic)
+		{
+			FSWPDeterminism::QuantizeQuery(OutContact);
+		}
 
-		// Setup trace parameters to detect ground under the wheel.
-		FCollisionQueryParams TraceParams;
-		TraceParams.MobilityType = EQueryMobilityType::Any;
-		TraceParams.bReturnPhysicalMaterial = false;
-		if (VehicleActor.IsValid())
-			TraceParams.AddIgnoredActor(VehicleActor.Get());
-		TraceParams.bTraceComplex = true;
+		FSWPWheelHit WheelHit;
+		WheelHit.Distance = SuspensionConfig.Tuning->TraceLength;
 
-		SuspensionState.ForceLocation = AsyncLocation;
+		bool bHasContact = false;
+		switch (ContactMode)
+		{
+		case ESWPContactMode::RayFan:
+			bHasContact = TraceRayFan(Context, TraceParams, AsyncWorld, OutContact, *SuspensionConfig.Tuning, WheelHit, VehicleOut);
+			break;
+		case ESWPContactMode::Sweep:
+			bHasContact = TraceSweep(Context, TraceParams, OutContact, *SuspensionConfig.Tuning, WheelHit, VehicleOut);
+			break;
+		default:
+			bHasContact = TraceRay(Context, TraceParams, OutContact, *SuspensionConfig.Tuning, WheelHit, VehicleOut);
+			break;
+		}
 
-		// Line trace along suspension axis (downwards).
-		FVector StartTrace = AsyncLocation;
-		FVector EndTrace = StartTrace - AsyncUp * (SuspensionConfig.TravelCm + SuspensionConfig.WheelRadiusCm);
+		OutContact.HitDistance = WheelHit.Distance;
+		OutContact.ImpactNormal = bHasContact ? FVector(WheelHit.Hit.ImpactNormal) : FVector::ZeroVector;
+		OutContact.ContactMask = bHasContact ? 1.0f : 0.0f;
+		OutContact.SurfaceId = bHasContact && Context.bResolveSurfaces
+			? ResolveSurface(Context, WheelHit.Hit, WheelHit.RayStart, WheelHit.RayEnd, TraceParams, OutNewSurfaces)
+			: static_cast<uint8>(SurfaceType_Default);
+
+		if (Context.bDeterministic)
+		{
+			FSWPDeterminism::QuantizeContact(OutContact);
+		}
+	}
+
+	/**
+	 * Surface ID of a hit: one cache lookup in the common case. On a miss the ray is re-cast
+	 * once with physical materials enabled and the result is queued for the serial merge, for
+	 * the whole component unless its complex collision mixes physical materials.
+	 */
+	static uint8 ResolveSurface(const FSWPStepContext& Context,
+								const FHitResult& HitResult,
+								const FVector& StartTrace,
+								const FVector& EndTrace,
+								const FCollisionQueryParams& TraceParams,
+								TArray<FSWPSurfaceCache::FEntry>& OutNewSurfaces)
+	{
+		if (const uint8* SurfaceId = Context.SurfaceCache->Find(HitResult.Component, HitResult.FaceIndex))
+		{
+			return *SurfaceId;
+		}
+
+		// Same PT caveat as the trace itself: the physical material is only read, never modified.
+		FCollisionQueryParams MaterialParams = TraceParams;
+		MaterialParams.bReturnPhysicalMaterial = true;
+
+		FHitResult MaterialHit;
+		const bool bHit = Context.World->LineTraceSingleByChannel(MaterialHit, StartTrace, EndTrace, ECC_Visibility, MaterialParams);
+		const uint8 SurfaceId = bHit
+			? static_cast<uint8>(UPhysicalMaterial::DetermineSurfaceType(MaterialHit.PhysMaterial.Get()))
+			: static_cast<uint8>(SurfaceType_Default);
+
+		const bool bPerFace = bHit && HitResult.FaceIndex != INDEX_NONE && HasMixedComplexMaterials(MaterialHit.GetComponent());
+		OutNewSurfaces.Add({ { HitResult.Component, bPerFace ? HitResult.FaceIndex : INDEX_NONE }, SurfaceId, bPerFace });
+		return SurfaceId;
+	}
+
+	// Miss path only (read-only, like the material trace). Unknown layouts count as mixed.
+	static bool HasMixedComplexMaterials(const UPrimitiveComponent* Component)
+	{
+		const FBodyInstance* BodyInstance = Component ? Component->GetBodyInstance() : nullptr;
+		if (!BodyInstance) return true;
+
+		TArray<UPhysicalMaterial*> Materials;
+		BodyInstance->GetComplexPhysicalMaterials(Materials);
+		for (const UPhysicalMaterial* Material : Materials)
+		{
+			if (Material != Materials[0]) return true;
+		}
+		return Materials.IsEmpty();
+	}
+
+	/**
+	 * Spring/damper solve for one wheel. Branch-free: a missing contact is handled through
+	 * Contact.ContactMask, curves are fixed-size table lerps and the surface response is one
+	 * row of the surface table, so the same instruction stream runs for every wheel.
+	 */
+	static FORCEINLINE void Solve(const FSWPSuspensionConfig& SuspensionConfig,
+								  const FSWPSuspensionContact& Contact,
+								  const FSWPSurfaceScale& Surface,
+								  FSWPSuspensionState& SuspensionState,
+								  float PhysicsDeltaTime)
+	{
+		const FSWPSuspensionTuning& Tuning = *SuspensionConfig.Tuning;
+
+		// Compression ratio ∈ [0,1] (0 without contact). Reciprocal is precomputed per preset.
+		const float CompressionRatio = Contact.ContactMask * FMath::Clamp(1.0f - Contact.HitDistance * Tuning.InvTraceLength, 0.0f, 1.0f);
+		const float CompressionVelocity = (CompressionRatio - SuspensionState.PreviousCompressionRatio) / PhysicsDeltaTime;
+
+		// Spring curve (progressive rate / bump stop), linear table when none is authored.
+		const float SpringForce = Contact.ContactMask * Tuning.SpringStiffness * Surface.Stiffness *
+			FSWPSuspensionTuning::SampleTable(Tuning.SpringTable, CompressionRatio, FSWPSuspensionTuning::SpringInvStep);
+
+		// Damping: separate curves/coefficients for bump (compression) vs rebound (extension).
+		// Both tables are sampled and the result selected, keeping the solve branch-free.
+		const float Speed = FMath::Abs(CompressionVelocity);
+		const float BumpForce = Tuning.ShockBump * FSWPSuspensionTuning::SampleTable(Tuning.BumpTable, Speed, Tuning.DamperInvStep);
+		const float ReboundForce = Tuning.ShockRebound * FSWPSuspensionTuning::SampleTable(Tuning.ReboundTable, Speed, Tuning.DamperInvStep);
+		const float DampingForce = Contact.ContactMask * Surface.Damping * FMath::FloatSelect(CompressionVelocity, BumpForce, -ReboundForce);
+
+		// Combine spring + damping, clamp to max.
+		const float TotalForce = Contact.ContactMask * FMath::Clamp(SpringForce + DampingForce, 0.0f, Tuning.MaxForce);
+		// Vertical suspension force.
+		const FVector Fz = TotalForce * Contact.Up;
+		// Project along contact normal to eliminate unwanted lateral/forward components.
+		const FVector Fn = FMath::Max(0.0f, FVector::DotProduct(Fz, Contact.ImpactNormal)) * Contact.ImpactNormal;
+
+		// Update suspension state for next iteration.
+		SuspensionState.PreviousCompressionRatio = CompressionRatio;
+		SuspensionState.SpringForce = SpringForce;
+		SuspensionState.DampingForce = DampingForce;
+		SuspensionState.TotalForce = TotalForce;
+		SuspensionState.Fz = Fn;
+		SuspensionState.ForceLocation = Contact.Location;
+	}
+
+	/**
+	 * Solve() in Q16 fixed point (swp.Deterministic). Same model, every intermediate is an integer:
+	 * tuning and surface scales are converted once per call by rounding, the compression velocity
+	 * uses the step length in whole microseconds. The compression ratio it carries is exact.
+	 */
+	static void SolveFixed(const FSWPSuspensionConfig& SuspensionConfig,
+						   const FSWPSuspensionContact& Contact,
+						   const FSWPSurfaceScale& Surface,
+						   FSWPSuspensionState& SuspensionState,
+						   float PhysicsDeltaTime)
+	{
+		using D = FSWPDeterminism;
+		const FSWPSuspensionTuning& Tuning = *SuspensionConfig.Tuning;
+		const bool bContact = Contact.ContactMask > 0.0f;
+		constexpr int32 NumSamples = FSWPSuspensionTuning::NumCurveSamples;
+
+		const int64 TraceLength = D::ToFixed(Tuning.TraceLength);
+		const int64 Ratio = !bContact ? 0
+			: TraceLength > 0 ? FMath::Clamp<int64>(D::FixedOne - D::ToFixed(Contact.HitDistance) * D::FixedOne / TraceLength, 0, D::FixedOne)
+			: D::FixedOne;
+		const int64 PreviousRatio = D::ToFixed(SuspensionState.PreviousCompressionRatio);
+		const int64 DeltaMicroseconds = static_cast<int64>(FMath::RoundToDouble(static_cast<double>(PhysicsDeltaTime) * 1.0e6));
+		const int64 Velocity = DeltaMicroseconds > 0 ? (Ratio - PreviousRatio) * 1000000 / DeltaMicroseconds : 0;
+
+		const int64 SpringForce = !bContact ? 0
+			: D::Mul(D::Mul(D::ToFixed(Tuning.SpringStiffness), D::ToFixed(Surface.Stiffness)),
+					 D::SampleTable(Tuning.SpringTable, NumSamples, Ratio, D::ToFixed(FSWPSuspensionTuning::SpringInvStep)));
+
+		const int64 Speed = FMath::Abs(Velocity);
+		const int64 DamperInvStep = D::ToFixed(Tuning.DamperInvStep);
+		const int64 BumpForce = D::Mul(D::ToFixed(Tuning.ShockBump), D::SampleTable(Tuning.BumpTable, NumSamples, Speed, DamperInvStep));
+		const int64 ReboundForce = D::Mul(D::ToFixed(Tuning.ShockRebound), D::SampleTable(Tuning.ReboundTable, NumSamples, Speed, DamperInvStep));
+		const int64 DampingForce = !bContact ? 0 : D::Mul(D::ToFixed(Surface.Damping), Velocity >= 0 ? BumpForce : -ReboundForce);
+
+		const int64 TotalForce = !bContact ? 0 : FMath::Clamp<int64>(SpringForce + DampingForce, 0, D::ToFixed(Tuning.MaxForce));
+
+		// Fn = max(0, (TotalForce * Up) · N) * N.
+		const D::FFixedVector Up = D::ToFixed(Contact.Up);
+		const D::FFixedVector Normal = D::ToFixed(Contact.ImpactNormal);
+		const int64 UpDotNormal = D::Mul(Up.X, Normal.X) + D::Mul(Up.Y, Normal.Y) + D::Mul(Up.Z, Normal.Z);
+		const int64 NormalForce = FMath::Max<int64>(D::Mul(TotalForce, UpDotNormal), 0);
+		const D::FFixedVector Fn = { D::Mul(NormalForce, Normal.X), D::Mul(NormalForce, Normal.Y), D::Mul(NormalForce, Normal.Z) };
+
+		SuspensionState.PreviousCompressionRatio = static_cast<float>(D::FromFixed(Ratio));
+		SuspensionState.SpringForce = static_cast<float>(D::FromFixed(SpringForce));
+		SuspensionState.DampingForce = static_cast<float>(D::FromFixed(DampingForce));
+		SuspensionState.TotalForce = static_cast<float>(D::FromFixed(TotalForce));
+		SuspensionState.Fz = Fn.ToVector();
+		SuspensionState.ForceLocation = Contact.Location;
+	}
+
+private:
+	// Winning query of a wheel, plus a ray through its hit (used to re-query the material on a cache miss).
+	struct FSWPWheelHit
+	{
+		FHitResult Hit;
+		float Distance = 0.0f;
+		FVector RayStart = FVector::ZeroVector;
+		FVector RayEnd = FVector::ZeroVector;
+	};
+
+	// One line trace along the suspension axis (TravelCm + WheelRadiusCm).
+	static FORCEINLINE bool TraceRay(const FSWPStepContext& Context,
+									 const FCollisionQueryParams& TraceParams,
+									 const FSWPSuspensionContact& Contact,
+									 const FSWPSuspensionTuning& Tuning,
+									 FSWPWheelHit& OutWheelHit,
+									 FSWPVehicleOut& VehicleOut)
+	{
+		OutWheelHit.RayStart = Contact.Location;
+		OutWheelHit.RayEnd = Contact.Location - Contact.Up * Tuning.TraceLength;
 
 		// Debug: draw suspension ray.
-		VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeLine(StartTrace, EndTrace,
+		VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeLine(OutWheelHit.RayStart, OutWheelHit.RayEnd,
 			FColor::Magenta, 2.0f, 0.0f, ESWPDebugDrawCategory::Suspension));
 
-		FHitResult HitResult;
-		
-		// --- Suspension engaged only if ground contact is found ---
-		if (bool bHasContact = World->LineTraceSingleByChannel(HitResult, StartTrace, EndTrace, ECC_Visibility, TraceParams))
+		if (!Context.World->LineTraceSingleByChannel(OutWheelHit.Hit, OutWheelHit.RayStart, OutWheelHit.RayEnd, ECC_Visibility, TraceParams))
+			return false;
+
+		OutWheelHit.Distance = FVector::DotProduct(OutWheelHit.Hit.ImpactPoint - OutWheelHit.RayStart, -Contact.Up);
+		return true;
+	}
+
+	/**
+	 * Parallel rays spread over the contact patch, traced one after the other (NumFanRays separate
+	 * line traces, there is no packet query) and then reduced. A ray at offset x from the wheel center
+	 * touches the tire when the ground is r - sqrt(r² - x²) higher than under the center, so each hit
+	 * is shifted by that drop and the closest one wins.
+	 */
+	static bool TraceRayFan(const FSWPStepContext& Context,
+							const FCollisionQueryParams& TraceParams,
+							const FTransform& AsyncWorld,
+							const FSWPSuspensionContact& Contact,
+							const FSWPSuspensionTuning& Tuning,
+							FSWPWheelHit& OutWheelHit,
+							FSWPVehicleOut& VehicleOut)
+	{
+		const FVector Forward = Context.bDeterministic
+			? FSWPDeterminism::Snap(AsyncWorld.GetRotation().GetForwardVector(), FSWPDeterminism::UnitScale)
+			: AsyncWorld.GetRotation().GetForwardVector();
+		const float Radius = Tuning.WheelRadiusCm;
+
+		FVector Starts[NumFanRays];
+		FVector Ends[NumFanRays];
+		float Drops[NumFanRays];
+		FHitResult Hits[NumFanRays];
+		bool bHits[NumFanRays];
+
+		for (int32 r = 0; r < NumFanRays; ++r)
+		{
+			Drops[r] = Radius * (1.0f - FMath::Sqrt(1.0f - FMath::Square(FanOffsets[r])));
+			Starts[r] = Contact.Location + Forward * (FanOffsets[r] * Radius);
+			Ends[r] = Starts[r] - Contact.Up * (Tuning.TraceLength - Drops[r]);
+		}
+
+		for (int32 r = 0; r < NumFanRays; ++r)
 		{
-			const FVector TraceVector = HitResult.ImpactPoint - StartTrace;
-
-			// Distance along suspension axis.
-			const float HitDistanceInSuspensionAxis = FVector::DotProduct(TraceVector, -AsyncUp);
-
-			// Compression ratio ∈ [0,1]
-			const float CompressionRatio = FMath::Clamp(1.0f - (HitDistanceInSuspensionAxis / (SuspensionConfig.TravelCm + SuspensionConfig.WheelRadiusCm)), 0.0f, 1.0f);
-			const float CompressionVelocity = (CompressionRatio - SuspensionState.PreviousCompressionRatio) / PhysicsDeltaTime;
-			
-			const float SpringForce = CompressionRatio * SuspensionConfig.SpringStiffness;
-
-			// Damping: separate coefficients for bump vs rebound.
-			const float DampingForce = CompressionVelocity > 0.0f ?
-				CompressionVelocity * SuspensionConfig.ShockBump :				// Compression
-					 CompressionVelocity * SuspensionConfig.ShockRebound;		// Extension
-
-
-			// Combine spring + damping, clamp to max.
-			const float TotalForce = FMath::Clamp(SpringForce + DampingForce, 0.0f, SuspensionConfig.MaxForce);
-			// Vertical suspension force.
-			const FVector Fz = TotalForce * AsyncUp;
-			// Project along contact normal to eliminate unwanted lateral/forward components.
-			const FVector Fn = FMath::Max(0.0f, FVector::DotProduct(Fz, HitResult.ImpactNormal)) * HitResult.ImpactNormal;
-
-			// Update suspension state for next iteration.
-			SuspensionState.PreviousCompressionRatio = CompressionRatio;
-			SuspensionState.SpringForce = SpringForce;
-			SuspensionState.DampingForce = DampingForce;
-			SuspensionState.Fz = Fn;
-
-			// Debug: draw applied force vector.
-			VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeArrow(SuspensionState.ForceLocation,
-				SuspensionState.ForceLocation + SuspensionState.Fz * 0.02f, 20.0f, FColor::Emerald,
-				2.5f, 0, ESWPDebugDrawCategory::Engine));
+			bHits[r] = Context.World->LineTraceSingleByChannel(Hits[r], Starts[r], Ends[r], ECC_Visibility, TraceParams);
+
+			VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeLine(Starts[r], Ends[r],
+				FColor::Magenta, 1.0f, 0.0f, ESWPDebugDrawCategory::Suspension));
 		}
-		else
+
+		int32 Best = INDEX_NONE;
+		for (int32 r = 0; r < NumFanRays; ++r)
 		{
-			// No ground contact --> reset to zero.
-			SuspensionState.PreviousCompressionRatio = 0.0f;
-			SuspensionState.SpringForce = 0.0f;
-			SuspensionState.DampingForce = 0.0f;
-			SuspensionState.Fz = FVector::ZeroVector;
+			const float Distance = FVector::DotProduct(Hits[r].ImpactPoint - Starts[r], -Contact.Up) + Drops[r];
+			if (bHits[r] && Distance < OutWheelHit.Distance)
+			{
+				OutWheelHit.Distance = Distance;
+				Best = r;
+			}
 		}
+		if (Best == INDEX_NONE) return false;
+
+		OutWheelHit.Hit = Hits[Best];
+		OutWheelHit.RayStart = Starts[Best];
+		OutWheelHit.RayEnd = Ends[Best];
+		return true;
+	}
+
+	// Sphere of the wheel radius swept from the TopLink over the suspension travel.
+	static bool TraceSweep(const FSWPStepContext& Context,
+						   const FCollisionQueryParams& TraceParams,
+						   const FSWPSuspensionContact& Contact,
+						   const FSWPSuspensionTuning& Tuning,
+						   FSWPWheelHit& OutWheelHit,
+						   FSWPVehicleOut& VehicleOut)
+	{
+		const float Radius = Tuning.WheelRadiusCm;
+		const FVector Start = Contact.Location;
+		const FVector End = Start - Contact.Up * Tuning.TravelCm;
+
+		VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeLine(Start, End,
+			FColor::Magenta, 2.0f, 0.0f, ESWPDebugDrawCategory::Suspension));
+
+		FHitResult& Hit = OutWheelHit.Hit;
+		if (!Context.World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, ECC_Visibility,
+												 FCollisionShape::MakeSphere(Radius), TraceParams))
+			return false;
+
+		// Hub distance along the axis (0 when already penetrating = fully compressed) + radius.
+		OutWheelHit.Distance = (Hit.bStartPenetrating ? 0.0f : Hit.Distance) + Radius;
+
+		VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeSphere(Hit.Location, Radius,
+			FColor::Magenta, 0.0f, ESWPDebugDrawCategory::Suspension));
+
+		// Material re-query: a short ray through the impact point.
+		OutWheelHit.RayStart = Start;
+		OutWheelHit.RayEnd = Hit.ImpactPoint + (Hit.ImpactPoint - Start).GetSafeNormal() * 2.0f;
+		return true;
 	}
 };
@@ -0,0 +1,58 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "States/SWPTireBatch.h"
+
+/**
+ * FSWPTireSolver (PT side)
+ *
+ * Longitudinal/lateral tire forces for a range of wheels, run as its own stage after the
+ * suspension stage. Brush model: lateral force rises with slip at the cornering stiffness
+ * and saturates smoothly at the friction limit; longitudinal force is the requested drive
+ * force plus rolling resistance; both are clamped to the friction circle.
+ *
+ * The loop body is pure arithmetic on contiguous float streams (no branches, no
+ * transcendental calls), so the compiler can vectorize it across wheels of the whole fleet.
+ */
+struct FSWPTireSolver
+{
+	// Below this speed (cm/s) slip is measured against it instead of the rolling speed,
+	// turning the tire into a bounded damper at standstill instead of dividing by ~0.
+	static constexpr float MinSlipSpeed = 300.0f;
+
+	// Wheels per parallel task of the tire stage.
+	static constexpr int32 BatchSize = 256;
+
+	static void SolveRange(FSWPTireBatch& Batch, const int32 Begin, const int32 End)
+	{
+		const float* RESTRICT Load = Batch.Load.GetData();
+		const float* RESTRICT VelLong = Batch.VelLong.GetData();
+		const float* RESTRICT VelLat = Batch.VelLat.GetData();
+		const float* RESTRICT Friction = Batch.Friction.GetData();
+		const float* RESTRICT CorneringStiffness = Batch.CorneringStiffness.GetData();
+		const float* RESTRICT RollingResistance = Batch.RollingResistance.GetData();
+		const float* RESTRICT DriveForce = Batch.DriveForce.GetData();
+		float* RESTRICT ForceLong = Batch.ForceLong.GetData();
+		float* RESTRICT ForceLat = Batch.ForceLat.GetData();
+
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const float PeakForce = Friction[i] * Load[i];
+
+			// tan(slip angle), then brush model: u = θ·σ with θ = Cα / (3 μ Fz) and Cα = Cs·Fz.
+			const float Slip = VelLat[i] / FMath::Max(FMath::Abs(VelLong[i]), MinSlipSpeed);
+			const float U = FMath::Clamp(Slip * CorneringStiffness[i] / (3.0f * FMath::Max(Friction[i], UE_KINDA_SMALL_NUMBER)), -1.0f, 1.0f);
+			const float Lat = -PeakForce * (3.0f * U - 3.0f * U * FMath::Abs(U) + U * U * U);
+
+			// Rolling resistance opposes the rolling direction (smooth sign around standstill).
+			const float Long = DriveForce[i] - RollingResistance[i] * Load[i] * FMath::Clamp(VelLong[i] / MinSlipSpeed, -1.0f, 1.0f);
+
+			// Friction circle.
+			const float Magnitude = FMath::Sqrt(Long * Long + Lat * Lat);
+			const float Scale = FMath::Min(1.0f, PeakForce / FMath::Max(Magnitude, UE_KINDA_SMALL_NUMBER));
+			ForceLong[i] = Long * Scale;
+			ForceLat[i] = Lat * Scale;
+		}
+	}
+};
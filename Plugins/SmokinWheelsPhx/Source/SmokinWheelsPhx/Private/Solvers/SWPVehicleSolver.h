@@ -0,0 +1,419 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "SWPPhysicsUtility.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Outs/SWPVehicleOut.h"
+#include "Solvers/SWPStepContext.h"
+#include "Solvers/SWPSuspensionSolver.h"
+#include "States/SWPPowertrainBatch.h"
+#include "States/SWPTireBatch.h"
+#include "States/SWPVehicleState.h"
+#include "Templates/IntegerSequence.h"
+
+// Calls Func(0), Func(1), ... Func(N-1) as a flat sequence of calls (no loop counter, no branch).
+template<typename FuncType, int32... Indices>
+FORCEINLINE void SWP_UnrolledFor(TIntegerSequence<int32, Indices...>, FuncType&& Func)
+{
+	(Func(Indices), ...);
+}
+
+/**
+ * FSWPVehicleSolver (PT side)
+ *
+ * Per-vehicle step: unpack the wheel packets (geometry + preset reference), query all wheels,
+ * solve all suspensions, then apply the accumulated force/torque once on the chassis. Common
+ * wheel counts (4/6/8) run a compile-time specialized kernel whose per-wheel loops are fully
+ * unrolled; any other count goes through the generic path. Cost per vehicle is linear in its wheel count.
+ *
+ * With the tire model or the powertrain on (Context.DefersApply()), the step stops before
+ * applying: it keeps the suspension force/torque pending and fills the vehicle's entries of
+ * the fleet batches, and ApplyForces() runs after the batched stages.
+ */
+struct FSWPVehicleSolver
+{
+	// Generic path keeps per-wheel contacts on the stack up to this count (covers 18-wheelers).
+	static constexpr int32 MaxStackWheels = 24;
+
+	static void Step(const FSWPStepContext& Context,
+					 Chaos::FPBDRigidParticleHandle* Chassis,
+					 const FSWPVehiclePacket& VehiclePacket,
+					 const FSWPWheelPacket* WheelPackets,
+					 const int32 VehicleIndex,
+					 const int32 WheelBase,
+					 FSWPVehicleState& VehicleSimState,
+					 FSWPVehicleOut& VehicleOut)
+	{
+		const int32 NumWheels = VehiclePacket.NumWheels;
+
+		// Keep PT state layout in sync with the packet (wheel count may change on GT).
+		if (VehicleSimState.Suspensions.Num() != NumWheels || VehicleSimState.Contacts.Num() != NumWheels)
+		{
+			VehicleSimState.Suspensions.SetNum(NumWheels);
+			VehicleSimState.Contacts.SetNum(NumWheels);
+		}
+
+		switch (NumWheels)
+		{
+		case 4: StepFixed<4>(Context, Chassis, VehiclePacket, WheelPackets, WheelBase, VehicleSimState, VehicleOut); break;
+		case 6: StepFixed<6>(Context, Chassis, VehiclePacket, WheelPackets, WheelBase, VehicleSimState, VehicleOut); break;
+		case 8: StepFixed<8>(Context, Chassis, VehiclePacket, WheelPackets, WheelBase, VehicleSimState, VehicleOut); break;
+		default: StepGeneric(Context, Chassis, VehiclePacket, WheelPackets, WheelBase, VehicleSimState, VehicleOut); break;
+		}
+
+		WriteDrivelineInputs(Context, FQuat(Chassis->GetR()), Chassis->GetV(), VehiclePacket, WheelPackets, VehicleIndex, WheelBase, VehicleSimState);
+	}
+
+	// Batched stages output -> chassis: pending suspension force plus tire forces at their contact points and aero at the CoM.
+	static void ApplyForces(const FSWPStepContext& Context,
+							Chaos::FPBDRigidParticleHandle* Chassis,
+							const int32 VehicleIndex,
+							const int32 WheelBase,
+							const int32 NumWheels,
+							FSWPVehicleState& VehicleSimState,
+							FSWPVehicleOut& VehicleOut)
+	{
+		const Chaos::FVec3 CoM = Chassis->XCom();
+		Chaos::FVec3 Force = VehicleSimState.PendingForce;
+		Chaos::FVec3 Torque = VehicleSimState.PendingTorque;
+
+		if (const FSWPTireBatch* Tires = Context.Tires)
+		{
+			const bool bDrawTires = (Context.DebugMask & SWP_DebugCatBit(ESWPDebugDrawCategory::Tires)) != 0;
+			const bool bDrawDrive = (Context.DebugMask & SWP_DebugCatBit(ESWPDebugDrawCategory::Transmission)) != 0;
+			for (int32 i = WheelBase; i < WheelBase + NumWheels; ++i)
+			{
+				const Chaos::FVec3 TireForce = (Tires->Forward[i] * Tires->ForceLong[i] + Tires->Right[i] * Tires->ForceLat[i]) * 100.0f;
+				Force += TireForce;
+				Torque += Chaos::FVec3::CrossProduct(Tires->ContactPoint[i] - CoM, TireForce);
+
+#if !UE_BUILD_SHIPPING
+				// Debug: tire force (same scale as the suspension arrow) and requested drive/brake force.
+				if (bDrawTires && Tires->Load[i] > 0.0f)
+				{
+					VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeArrow(Tires->ContactPoint[i],
+						Tires->ContactPoint[i] + TireForce * 0.0002f, 20.0f, FColor::Orange,
+						2.5f, 0, ESWPDebugDrawCategory::Tires));
+				}
+				if (bDrawDrive && Tires->DriveForce[i] != 0.0f)
+				{
+					VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeArrow(Tires->ContactPoint[i],
+						Tires->ContactPoint[i] + Tires->Forward[i] * Tires->DriveForce[i] * 0.02f, 20.0f, FColor::Purple,
+						2.5f, 0, ESWPDebugDrawCategory::Transmission));
+				}
+#endif
+			}
+		}
+
+		if (const FSWPPowertrainBatch* Powertrain = Context.Powertrain)
+		{
+			const Chaos::FVec3 AeroForce = Chaos::FVec3(Powertrain->AeroForce[VehicleIndex]) * 100.0f;
+			Force += AeroForce;
+
+			VehicleSimState.Gear = Powertrain->Gear[VehicleIndex];
+			VehicleOut.EngineRPM = Powertrain->EngineRPM[VehicleIndex];
+			VehicleOut.Gear = Powertrain->PresetIndex[VehicleIndex] != INDEX_NONE ? VehicleSimState.Gear : 0;
+
+#if !UE_BUILD_SHIPPING
+			if (Context.DebugMask & SWP_DebugCatBit(ESWPDebugDrawCategory::Aero))
+			{
+				VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeArrow(CoM, CoM + AeroForce * 0.0002f, 20.0f,
+					FColor::Cyan, 2.5f, 0, ESWPDebugDrawCategory::Aero));
+			}
+			if ((Context.DebugMask & SWP_DebugCatBit(ESWPDebugDrawCategory::Engine)) && VehicleOut.Gear != 0)
+			{
+				// RPM gauge: vertical bar over the CoM, full length at 10000 RPM.
+				const Chaos::FVec3 Up = Chassis->GetR().GetUpVector();
+				VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeLine(CoM, CoM + Up * (VehicleOut.EngineRPM * 0.02f),
+					FColor::Red, 4.0f, 0, ESWPDebugDrawCategory::Engine));
+			}
+#endif
+		}
+
+		FSWPPhysicsUtility::AddForceAndTorque(Chassis, Force, Torque);
+	}
+
+	static FCollisionQueryParams MakeTraceParams(const FSWPVehiclePacket& VehiclePacket)
+	{
+		// Setup trace parameters to detect ground under the wheels (shared by all wheels and sensors of the vehicle).
+		FCollisionQueryParams TraceParams;
+		TraceParams.MobilityType = EQueryMobilityType::Any;
+		TraceParams.bReturnPhysicalMaterial = false;
+		if (VehiclePacket.IgnoreActorId != 0)
+			TraceParams.AddIgnoredActor(VehiclePacket.IgnoreActorId);		// By unique ID: no UObject on PT.
+		TraceParams.bTraceComplex = true;
+		return TraceParams;
+	}
+
+private:
+	// Forward prediction replays the same per-wheel helpers on a scratch state.
+	friend struct FSWPPredictionSolver;
+
+	static FORCEINLINE void AccumulateWheel(const Chaos::FVec3& CoM, const FSWPSuspensionState& SuspensionState,
+											Chaos::FVec3& InOutForce, Chaos::FVec3& InOutTorque)
+	{
+		// r = Location - CoM (both in world space). τ = r × F.
+		const Chaos::FVec3 Force = SuspensionState.Fz * 100.0f;
+		InOutForce += Force;
+		InOutTorque += Chaos::FVec3::CrossProduct(SuspensionState.ForceLocation - CoM, Force);
+	}
+
+	// Powertrain stage inputs of the vehicle and the differential split of its wheels.
+	static void WriteDrivelineInputs(const FSWPStepContext& Context, const FQuat& ChassisRotation, const FVector& LinearVelocity,
+									 const FSWPVehiclePacket& VehiclePacket, const FSWPWheelPacket* WheelPackets,
+									 const int32 VehicleIndex, const int32 WheelBase, const FSWPVehicleState& VehicleSimState)
+	{
+		const FSWPWheelPacket* Wheels = WheelPackets + VehiclePacket.FirstWheel;
+		const int32 NumWheels = VehiclePacket.NumWheels;
+
+		int32 NumDriven = 0;
+		float DrivenRadiusCm = 0.0f;
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			if (!Wheels[w].IsDriven()) continue;
+			++NumDriven;
+			DrivenRadiusCm += Context.Presets[Wheels[w].PresetIndex].WheelRadiusCm;
+		}
+
+		if (FSWPTireBatch* Tires = Context.Tires)
+		{
+			const float Share = NumDriven > 0 ? 1.0f / NumDriven : 0.0f;
+			for (int32 w = 0; w < NumWheels; ++w)
+			{
+				Tires->DriveShare[WheelBase + w] = Wheels[w].IsDriven() ? Share : 0.0f;
+			}
+		}
+
+		if (FSWPPowertrainBatch* Powertrain = Context.Powertrain)
+		{
+			const FVector3f Velocity = FVector3f(LinearVelocity * 0.01);		// m/s
+			const FSWPVehicleControls& Controls = VehicleSimState.Controls;
+
+			Powertrain->PresetIndex[VehicleIndex] = VehiclePacket.PowertrainIndex != FSWPVehiclePacket::NoPowertrain
+				? VehiclePacket.PowertrainIndex : INDEX_NONE;
+			Powertrain->Throttle[VehicleIndex] = FMath::Clamp(Controls.Throttle, -1.0f, 1.0f);
+			Powertrain->Brake[VehicleIndex] = FMath::Clamp(Controls.Brake, 0.0f, 1.0f);
+			Powertrain->ForwardSpeed[VehicleIndex] = FVector3f::DotProduct(Velocity, FVector3f(ChassisRotation.GetForwardVector()));
+			Powertrain->DriveRadius[VehicleIndex] = NumDriven > 0 ? DrivenRadiusCm * 0.01f / NumDriven : 0.0f;
+			Powertrain->Velocity[VehicleIndex] = Velocity;
+			Powertrain->Up[VehicleIndex] = FVector3f(ChassisRotation.GetUpVector());
+			Powertrain->FirstWheel[VehicleIndex] = WheelBase;
+			Powertrain->NumWheels[VehicleIndex] = NumWheels;
+			Powertrain->Gear[VehicleIndex] = VehicleSimState.Gear;
+		}
+	}
+
+	// Tire stage inputs of one wheel: load, contact patch velocity in the tire frame, friction, geometry.
+	static FORCEINLINE void WriteTireInputs(FSWPTireBatch& Tires, const int32 Index, const FVector& LinearVelocity,
+											const FVector& AngularVelocity, const Chaos::FVec3& CoM, const FQuat& WheelRotation, const FSWPSuspensionConfig& SuspensionConfig,
+											const FSWPSuspensionContact& Contact, const FSWPSurfaceScale& Surface,
+											const FSWPSuspensionState& SuspensionState)
+	{
+		const FSWPSuspensionTuning& Tuning = *SuspensionConfig.Tuning;
+
+		// Tire frame on the ground plane (degenerates to zero without contact, where the load is 0 too).
+		const FVector Normal = Contact.ImpactNormal;
+		const FVector Heading = WheelRotation.GetForwardVector();
+		const FVector Forward = (Heading - Normal * FVector::DotProduct(Heading, Normal)).GetSafeNormal();
+		const FVector Right = FVector::CrossProduct(Normal, Forward);
+
+		const FVector ContactPoint = Contact.Location - Contact.Up * Contact.HitDistance;
+		const FVector Velocity = LinearVelocity + FVector::CrossProduct(AngularVelocity, ContactPoint - CoM);
+
+		Tires.Load[Index] = SuspensionState.TotalForce;
+		Tires.VelLong[Index] = FVector::DotProduct(Velocity, Forward);
+		Tires.VelLat[Index] = FVector::DotProduct(Velocity, Right);
+		Tires.Friction[Index] = Tuning.TireFriction * Surface.Friction;
+		Tires.CorneringStiffness[Index] = Tuning.TireCorneringStiffness;
+		Tires.RollingResistance[Index] = Tuning.TireRollingResistance;
+		Tires.DriveForce[Index] = 0.0f;
+		Tires.ContactPoint[Index] = ContactPoint;
+		Tires.Forward[Index] = Forward;
+		Tires.Right[Index] = Right;
+	}
+
+	// Batched stages off: apply now. On: keep it for ApplyForces() (after those stages).
+	static FORCEINLINE void ApplyOrDefer(Chaos::FPBDRigidParticleHandle* Chassis, const FSWPStepContext& Context,
+										 const Chaos::FVec3& Force, const Chaos::FVec3& Torque, FSWPVehicleState& VehicleSimState)
+	{
+		if (Context.DefersApply())
+		{
+			VehicleSimState.PendingForce = Force;
+			VehicleSimState.PendingTorque = Torque;
+			return;
+		}
+
+		// PT-safe force application via Chaos API (no UObjects involved).
+		FSWPPhysicsUtility::AddForceAndTorque(Chassis, Force, Torque);
+	}
+
+	static FORCEINLINE FTransform ComputeWheelTransform(const FQuat& ChassisRotation, const FSWPSuspensionConfig& SuspensionConfig,
+														const FSWPSuspensionContact& Contact, const float Steering)
+	{
+		// Hub sits one radius above the contact, limited to the suspension travel (hangs fully extended in the air).
+		const float HubDistance = FMath::Clamp(Contact.HitDistance - SuspensionConfig.Tuning->WheelRadiusCm, 0.0f, SuspensionConfig.Tuning->TravelCm);
+		// Steering yaws the wheel about the suspension axis (also the tire heading).
+		const FQuat Steer(FVector::UpVector, Steering * SuspensionConfig.MaxSteerAngle);
+		return FTransform(ChassisRotation * SuspensionConfig.AttachLocal.GetRotation() * Steer, Contact.Location - Contact.Up * HubDistance);
+	}
+
+	static FORCEINLINE void DebugWheel(const FSWPSuspensionContact& Contact, const FSWPSuspensionState& SuspensionState,
+									   FSWPVehicleOut& VehicleOut)
+	{
+#if !UE_BUILD_SHIPPING
+		// Debug: draw applied force vector.
+		if (Contact.ContactMask > 0.0f)
+		{
+			VehicleOut.AddDebugDrawCommand(FSWPDebugDrawCommand::MakeArrow(SuspensionState.ForceLocation,
+				SuspensionState.ForceLocation + SuspensionState.Fz * 0.02f, 20.0f, FColor::Emerald,
+				2.5f, 0, ESWPDebugDrawCategory::Suspension));
+		}
+#endif
+	}
+
+	template<int32 NumWheels>
+	static void StepFixed(const FSWPStepContext& Context,
+						  Chaos::FPBDRigidParticleHandle* Chassis,
+						  const FSWPVehiclePacket& VehiclePacket,
+						  const FSWPWheelPacket* WheelPackets,
+						  const int32 WheelBase,
+						  FSWPVehicleState& VehicleSimState,
+						  FSWPVehicleOut& VehicleOut)
+	{
+		static_assert(NumWheels <= FSWPVehiclePacket::NumInlineWheels, "Specialized kernels must fit the inline wheel storage.");
+
+		using FWheelSequence = TMakeIntegerSequence<int32, NumWheels>;
+
+		// 0) Dequantize the wire format once per wheel (stack local; tuning stays in the shared preset table).
+		FSWPSuspensionConfig Configs[NumWheels];
+		SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+		{
+			Configs[w] = WheelPackets[VehiclePacket.FirstWheel + w].Unpack(Context.Presets);
+		});
+
+		FSWPSuspensionState* States = VehicleSimState.Suspensions.GetData();
+
+		const FTransform ChassisTransformWorld = FTransform(Chassis->GetR(), Chassis->GetX());
+		const FCollisionQueryParams TraceParams = MakeTraceParams(VehiclePacket);
+
+		// 1) Ground queries (kept in the vehicle state as the frozen ground of forward predictions).
+		FSWPSuspensionContact* Contacts = VehicleSimState.Contacts.GetData();
+		SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+		{
+			FSWPSuspensionSolver::Trace(Context, VehiclePacket.ContactMode, TraceParams, ChassisTransformWorld, Configs[w], Contacts[w], VehicleSimState.NewSurfaces, VehicleOut);
+		});
+
+		// 2) Branch-free suspension solve (fixed point in deterministic mode).
+		if (Context.bDeterministic)
+		{
+			SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+			{
+				FSWPSuspensionSolver::SolveFixed(Configs[w], Contacts[w], Context.SurfaceScales[Contacts[w].SurfaceId], States[w], Context.DeltaTime);
+			});
+		}
+		else
+		{
+			SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+			{
+				FSWPSuspensionSolver::Solve(Configs[w], Contacts[w], Context.SurfaceScales[Contacts[w].SurfaceId], States[w], Context.DeltaTime);
+			});
+		}
+
+		// 3) Accumulate and apply once (one force + one torque per chassis per step), feed the tire stage.
+		const float Steering = FMath::Clamp(VehicleSimState.Controls.Steering, -1.0f, 1.0f);
+		const Chaos::FVec3 CoM = Chassis->XCom();
+		Chaos::FVec3 Force = Chaos::FVec3::ZeroVector;
+		Chaos::FVec3 Torque = Chaos::FVec3::ZeroVector;
+		VehicleOut.WheelTransforms.SetNumUninitialized(NumWheels);
+		FTransform* WheelTransforms = VehicleOut.WheelTransforms.GetData();
+		SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+		{
+			AccumulateWheel(CoM, States[w], Force, Torque);
+			WheelTransforms[w] = ComputeWheelTransform(ChassisTransformWorld.GetRotation(), Configs[w], Contacts[w], Steering);
+			DebugWheel(Contacts[w], States[w], VehicleOut);
+		});
+		if (Context.bDeterministic)
+		{
+			FSWPDeterminism::AccumulateWheels(CoM, States, NumWheels, Force, Torque);
+		}
+
+		if (Context.Tires)
+		{
+			SWP_UnrolledFor(FWheelSequence(), [&](int32 w)
+			{
+				WriteTireInputs(*Context.Tires, WheelBase + w, Chassis->GetV(), Chassis->GetW(), CoM, WheelTransforms[w].GetRotation(), Configs[w], Contacts[w],
+								Context.SurfaceScales[Contacts[w].SurfaceId], States[w]);
+			});
+		}
+
+		ApplyOrDefer(Chassis, Context, Force, Torque, VehicleSimState);
+	}
+
+	static void StepGeneric(const FSWPStepContext& Context,
+							Chaos::FPBDRigidParticleHandle* Chassis,
+							const FSWPVehiclePacket& VehiclePacket,
+							const FSWPWheelPacket* WheelPackets,
+							const int32 WheelBase,
+							FSWPVehicleState& VehicleSimState,
+							FSWPVehicleOut& VehicleOut)
+	{
+		const int32 NumWheels = VehiclePacket.NumWheels;
+
+		TArray<FSWPSuspensionConfig, TInlineAllocator<MaxStackWheels>> Configs;
+		Configs.SetNumUninitialized(NumWheels);
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			Configs[w] = WheelPackets[VehiclePacket.FirstWheel + w].Unpack(Context.Presets);
+		}
+
+		FSWPSuspensionState* States = VehicleSimState.Suspensions.GetData();
+
+		const FTransform ChassisTransformWorld = FTransform(Chassis->GetR(), Chassis->GetX());
+		const FCollisionQueryParams TraceParams = MakeTraceParams(VehiclePacket);
+
+		FSWPSuspensionContact* Contacts = VehicleSimState.Contacts.GetData();
+
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			FSWPSuspensionSolver::Trace(Context, VehiclePacket.ContactMode, TraceParams, ChassisTransformWorld, Configs[w], Contacts[w], VehicleSimState.NewSurfaces, VehicleOut);
+		}
+
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			if (Context.bDeterministic)
+			{
+				FSWPSuspensionSolver::SolveFixed(Configs[w], Contacts[w], Context.SurfaceScales[Contacts[w].SurfaceId], States[w], Context.DeltaTime);
+				continue;
+			}
+			FSWPSuspensionSolver::Solve(Configs[w], Contacts[w], Context.SurfaceScales[Contacts[w].SurfaceId], States[w], Context.DeltaTime);
+		}
+
+		const float Steering = FMath::Clamp(VehicleSimState.Controls.Steering, -1.0f, 1.0f);
+		const Chaos::FVec3 CoM = Chassis->XCom();
+		Chaos::FVec3 Force = Chaos::FVec3::ZeroVector;
+		Chaos::FVec3 Torque = Chaos::FVec3::ZeroVector;
+		VehicleOut.WheelTransforms.SetNumUninitialized(NumWheels);
+		for (int32 w = 0; w < NumWheels; ++w)
+		{
+			AccumulateWheel(CoM, States[w], Force, Torque);
+			VehicleOut.WheelTransforms[w] = ComputeWheelTransform(ChassisTransformWorld.GetRotation(), Configs[w], Contacts[w], Steering);
+			DebugWheel(Contacts[w], States[w], VehicleOut);
+		}
+		if (Context.bDeterministic)
+		{
+			FSWPDeterminism::AccumulateWheels(CoM, States, NumWheels, Force, Torque);
+		}
+
+		if (Context.Tires)
+		{
+			for (int32 w = 0; w < NumWheels; ++w)
+			{
+				WriteTireInputs(*Context.Tires, WheelBase + w, Chassis->GetV(), Chassis->GetW(), CoM, VehicleOut.WheelTransforms[w].GetRotation(), Configs[w], Contacts[w],
+								Context.SurfaceScales[Contacts[w].SurfaceId], States[w]);
+			}
+		}
+
+		ApplyOrDefer(Chassis, Context, Force, Torque, VehicleSimState);
+	}
+};
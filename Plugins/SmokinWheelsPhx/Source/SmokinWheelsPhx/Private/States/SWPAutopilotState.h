@@ -0,0 +1,34 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+// PT autopilot of one vehicle: planned route, progress along it and speed controller memory.
+struct FSWPAutopilotState
+{
+	static constexpr int32 NumInlineRouteNodes = 32;
+
+	int32 Destination = INDEX_NONE;		// Road graph node; INDEX_NONE: disengaged (driver controls apply).
+	float CruiseSpeed = 0.0f;			// m/s
+	bool bReplan = false;				// Destination or road graph changed: plan from the nearest node.
+
+	TArray<int32, TInlineAllocator<NumInlineRouteNodes>> Route;				// Node indices, destination last.
+	TArray<float, TInlineAllocator<NumInlineRouteNodes>> DistanceToGo;		// cm from each route node to the destination.
+	int32 RouteIndex = 0;				// Next route node to reach.
+
+	float SpeedIntegral = 0.0f;
+	float PrevSpeedError = 0.0f;
+
+	FORCEINLINE bool IsEngaged() const { return Destination != INDEX_NONE; }
+
+	void Engage(const int32 InDestination, const float InCruiseSpeed)
+	{
+		Destination = InDestination;
+		CruiseSpeed = InCruiseSpeed;
+		bReplan = InDestination != INDEX_NONE;
+		if (!bReplan)
+		{
+			Route.Reset();
+			DistanceToGo.Reset();
+		}
+	}
+};
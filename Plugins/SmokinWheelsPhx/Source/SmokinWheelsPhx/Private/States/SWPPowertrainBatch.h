@@ -0,0 +1,48 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+/**
+ * Fleet-wide powertrain/aero buffers (SoA, PT-owned), one entry per simulated vehicle of the
+ * step, in step order. The suspension stage fills the inputs, the powertrain stage writes the
+ * outputs (and the drive force of the vehicle's wheels in the tire batch), the apply stage
+ * reads them back. Capacity is kept between steps.
+ */
+struct FSWPPowertrainBatch
+{
+	// Inputs (suspension stage).
+	TArray<int32> PresetIndex;		// Into the powertrain preset table, INDEX_NONE without powertrain.
+	TArray<float> Throttle;
+	TArray<float> Brake;
+	TArray<float> ForwardSpeed;		// Chassis velocity along its forward axis (m/s).
+	TArray<float> DriveRadius;		// Mean radius of the driven wheels (m), 0 without driven wheels.
+	TArray<FVector3f> Velocity;		// Chassis velocity (m/s).
+	TArray<FVector3f> Up;			// Chassis up axis.
+	TArray<int32> FirstWheel;		// Vehicle's range in the tire batch (differential/brake split).
+	TArray<int32> NumWheels;
+
+	// In/out: selected gear (-1 reverse, 1..N forward), mirrored from the vehicle state.
+	TArray<int32> Gear;
+
+	// Outputs (powertrain stage).
+	TArray<float> EngineRPM;
+	TArray<float> DriveForce;		// Total drive force at the contact patches (N), before the differential split.
+	TArray<FVector3f> AeroForce;	// Drag + downforce (N), applied at the center of mass.
+
+	void SetNum(const int32 NumVehicles)
+	{
+		for (TArray<int32>* Stream : { &PresetIndex, &FirstWheel, &NumWheels, &Gear })
+		{
+			Stream->SetNumUninitialized(NumVehicles, EAllowShrinking::No);
+		}
+		for (TArray<float>* Stream : { &Throttle, &Brake, &ForwardSpeed, &DriveRadius, &EngineRPM, &DriveForce })
+		{
+			Stream->SetNumUninitialized(NumVehicles, EAllowShrinking::No);
+		}
+		Velocity.SetNumUninitialized(NumVehicles, EAllowShrinking::No);
+		Up.SetNumUninitialized(NumVehicles, EAllowShrinking::No);
+		AeroForce.SetNumUninitialized(NumVehicles, EAllowShrinking::No);
+	}
+
+	FORCEINLINE int32 Num() const { return PresetIndex.Num(); }
+};
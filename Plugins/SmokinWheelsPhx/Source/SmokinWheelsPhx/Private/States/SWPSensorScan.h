@@ -0,0 +1,17 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "Configs/SWPSensorRig.h"
+#include "Configs/SWPVehiclePacket.h"
+
+// One sensor due this step, with its rays at [FirstRay, FirstRay + NumRanges) of the stage.
+struct FSWPSensorScan
+{
+	const FSWPVehiclePacket* Vehicle = nullptr;
+	const FSWPSensorRig::FSensor* Sensor = nullptr;
+	uint16* Ranges = nullptr;			// The sensor's slice of the vehicle's range buffer.
+	FVector Origin = FVector::ZeroVector;
+	FQuat ChassisRotation = FQuat::Identity;
+	int32 FirstRay = 0;
+};
@@ -0,0 +1,18 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+/**
+ * Result of the per-wheel ground query, consumed by the (branch-free) suspension solve.
+ * When there is no contact, HitDistance is the full trace length and ContactMask is 0.
+ */
+struct FSWPSuspensionContact
+{
+	FVector Location = FVector::ZeroVector;		// Suspension TopLink in world space (force application point).
+	FVector Up = FVector::UpVector;				// Suspension axis in world space.
+	FVector ImpactNormal = FVector::ZeroVector;
+
+	float HitDistance = 0.0f;					// Distance along -Up from TopLink to the hit.
+	float ContactMask = 0.0f;					// 1 with ground contact, 0 otherwise.
+	uint8 SurfaceId = 0;						// EPhysicalSurface of the hit (SurfaceType_Default without contact).
+};
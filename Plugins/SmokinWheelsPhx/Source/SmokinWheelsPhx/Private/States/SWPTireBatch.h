@@ -0,0 +1,45 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+/**
+ * Fleet-wide tire buffers (SoA, PT-owned), one entry per simulated wheel of the step.
+ * Vehicles own the contiguous range [WheelBase, WheelBase + NumWheels): the suspension stage
+ * fills the inputs, the tire stage streams over every wheel at once, and the apply stage reads
+ * the forces back. Capacity is kept between steps.
+ */
+struct FSWPTireBatch
+{
+	// Inputs (suspension stage).
+	TArray<float> Load;					// Normal load (suspension force units, 0 without contact).
+	TArray<float> VelLong;				// Contact patch velocity along the tire heading (cm/s).
+	TArray<float> VelLat;				// Contact patch velocity across the tire (cm/s).
+	TArray<float> Friction;				// Tire friction × surface friction.
+	TArray<float> CorneringStiffness;	// Per unit load (1/rad).
+	TArray<float> RollingResistance;
+	TArray<float> DriveForce;			// Requested longitudinal force (drive/brake), 0 without a powertrain.
+	TArray<float> DriveShare;			// Fraction of the vehicle's drive force (open differential), 0 on free wheels.
+
+	// Outputs (tire stage), same units as Load.
+	TArray<float> ForceLong;
+	TArray<float> ForceLat;
+
+	// Application geometry (apply stage only).
+	TArray<FVector> ContactPoint;
+	TArray<FVector> Forward;
+	TArray<FVector> Right;
+
+	void SetNum(const int32 NumWheels)
+	{
+		for (TArray<float>* Stream : { &Load, &VelLong, &VelLat, &Friction, &CorneringStiffness, &RollingResistance,
+									   &DriveForce, &DriveShare, &ForceLong, &ForceLat })
+		{
+			Stream->SetNumUninitialized(NumWheels, EAllowShrinking::No);
+		}
+		ContactPoint.SetNumUninitialized(NumWheels, EAllowShrinking::No);
+		Forward.SetNumUninitialized(NumWheels, EAllowShrinking::No);
+		Right.SetNumUninitialized(NumWheels, EAllowShrinking::No);
+	}
+
+	FORCEINLINE int32 Num() const { return Load.Num(); }
+};
@@ -2,12 +2,39 @@
 
 #pragma once
 
+#include "SWPAutopilotState.h"
+#include "SWPSuspensionContact.h"
 #include "SWPSuspensionState.h"
+#include "Configs/SWPSensorRig.h"
+#include "Configs/SWPVehicleControls.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Outs/SWPNetVehicleState.h"
+#include "Registry/SWPSurfaceCache.h"
 
 struct FSWPVehicleState
 {
-	FSWPSuspensionState FrontLeftSuspension;
-	FSWPSuspensionState FrontRightSuspension;
-	FSWPSuspensionState RearLeftSuspension;
-	FSWPSuspensionState RearRightSuspension;
+	// One entry per wheel, same order as the vehicle's wheel packets.
+	TArray<FSWPSuspensionState, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Suspensions;
+	// Ground contacts of the latest step, same order (frozen ground of forward predictions).
+	TArray<FSWPSuspensionContact, TInlineAllocator<FSWPVehiclePacket::NumInlineWheels>> Contacts;
+
+	// Surface cache misses found by this vehicle during the step (merged serially afterwards).
+	TArray<FSWPSurfaceCache::FEntry> NewSurfaces;
+
+	FSWPVehicleControls Controls;
+	int32 Gear = 1;		// -1 reverse, 1..N forward (automatic gearbox).
+
+	// When engaged, overrides Controls every step (AI traffic).
+	FSWPAutopilotState Autopilot;
+
+	// Latest range of every sensor ray (layout of the vehicle's sensor rig) and time left to each sensor's next scan.
+	TArray<uint16> SensorRanges;
+	TArray<float, TInlineAllocator<FSWPSensorRig::MaxSensors>> SensorTimers;
+
+	// Replication state published by the previous step (dirty bits compare against it).
+	FSWPNetVehicleState NetState;
+
+	// Suspension force/torque of the step, applied together with the tire/powertrain/aero forces.
+	Chaos::FVec3 PendingForce = Chaos::FVec3::ZeroVector;
+	Chaos::FVec3 PendingTorque = Chaos::FVec3::ZeroVector;
 };
@@ -0,0 +1,52 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "PhysicsInterfaceDeclaresCore.h"
+#include "SWPContactMode.h"
+#include "SWPWheelDefinition.h"
+#include "SWPPowertrainPreset.h"
+#include "SWPMassFragments.generated.h"
+
+/**
+ * Per-entity identity and physics binding of an actor-less vehicle.
+ * Guid is the same ID used by FSWPAsyncPhysicsManager / PT; PhysicsHandle is the chassis
+ * particle created directly in the physics scene (GT-side proxy, never touched on PT).
+ */
+USTRUCT()
+struct SMOKINWHEELSPHX_API FSWPMassVehicleFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FGuid Guid;
+	FPhysicsActorHandle PhysicsHandle = nullptr;
+};
+
+/**
+ * Tuning shared by every entity built from the same trait (one copy per archetype, not per vehicle).
+ */
+USTRUCT()
+struct SMOKINWHEELSPHX_API FSWPMassVehicleParamsFragment : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	/** Chassis collision box half extents (cm). */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Chassis")
+	FVector ChassisHalfExtents = FVector(220.0f, 90.0f, 50.0f);
+
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Chassis")
+	float VehicleMass = 1'500.0f;
+
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Wheels", meta = (TitleProperty = "Name"))
+	TArray<FSWPWheelDefinition> Wheels;
+
+	/** Ground query fidelity (traffic usually wants the cheapest, Ray). */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Wheels")
+	ESWPContactMode ContactMode = ESWPContactMode::Ray;
+
+	/** Engine/gearbox/aero (none: the entity only gets suspension and tire forces). */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Powertrain")
+	TObjectPtr<USWPPowertrainPreset> Powertrain = nullptr;
+};
@@ -0,0 +1,71 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassObserverProcessor.h"
+#include "MassProcessor.h"
+#include "SWPMassVehicleProcessors.generated.h"
+
+/**
+ * USWPMassVehicleInitializer (GT)
+ *
+ * Runs when FSWPMassVehicleFragment is added: creates the chassis particle at the entity
+ * transform and registers the vehicle with the scene's FSWPAsyncPhysicsManager.
+ */
+UCLASS()
+class SMOKINWHEELSPHX_API USWPMassVehicleInitializer : public UMassObserverProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USWPMassVehicleInitializer();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * USWPMassVehicleDeinitializer (GT)
+ *
+ * Runs when FSWPMassVehicleFragment is removed (entity destroyed): unregisters the vehicle
+ * and releases its chassis particle.
+ */
+UCLASS()
+class SMOKINWHEELSPHX_API USWPMassVehicleDeinitializer : public UMassObserverProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USWPMassVehicleDeinitializer();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * USWPMassVehicleSyncProcessor (GT)
+ *
+ * Consumes the latest PT output (FSWPAsyncPhysicsManager::FindLatestVehicleOut) and writes
+ * the chassis pose into FTransformFragment, where Mass visualization (ISM) picks it up.
+ */
+UCLASS()
+class SMOKINWHEELSPHX_API USWPMassVehicleSyncProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	USWPMassVehicleSyncProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
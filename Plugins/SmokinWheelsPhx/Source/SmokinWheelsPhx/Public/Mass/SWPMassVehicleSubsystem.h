@@ -0,0 +1,30 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SWPMassVehicleSubsystem.generated.h"
+
+class ASWPVehicle;
+
+/**
+ * USWPMassVehicleSubsystem
+ *
+ * GT entry point for actor-less vehicles. Crowds live as Mass entities (chassis particle +
+ * PT simulation, no UObject per vehicle); a single entity is promoted to a full ASWPVehicle
+ * only when gameplay needs an actor (e.g., the player interacts with it).
+ */
+UCLASS()
+class SMOKINWHEELSPHX_API USWPMassVehicleSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Spawn an ASWPVehicle at the entity's current pose/velocity and destroy the entity.
+	 * Returns the new actor, or nullptr if the entity is not an SWP vehicle.
+	 */
+	ASWPVehicle* PromoteToActor(const FMassEntityHandle Entity, TSubclassOf<ASWPVehicle> VehicleClass);
+};
@@ -0,0 +1,28 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "Mass/SWPMassFragments.h"
+#include "SWPMassVehicleTrait.generated.h"
+
+/**
+ * USWPMassVehicleTrait
+ *
+ * Turns a Mass entity config into an actor-less SmokinWheelsPhx vehicle: adds the vehicle
+ * fragment, a transform fragment and the shared tuning. Physics registration happens in
+ * USWPMassVehicleInitializer when entities are created.
+ */
+UCLASS(meta = (DisplayName = "SmokinWheelsPhx Vehicle"))
+class SMOKINWHEELSPHX_API USWPMassVehicleTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx")
+	FSWPMassVehicleParamsFragment Params;
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
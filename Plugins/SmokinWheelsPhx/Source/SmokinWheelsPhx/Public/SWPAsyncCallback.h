@@ -2,8 +2,24 @@
 
 #pragma once
 
-#include "Configs/SWPVehicleConfig.h"
+#include "Configs/SWPAutopilotCommand.h"
+#include "Configs/SWPPredictionRequest.h"
+#include "Configs/SWPPresetUpload.h"
+#include "Configs/SWPSurfaceScale.h"
+#include "Configs/SWPSuspensionCorrection.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Configs/SWPVehicleRestore.h"
+#include "Outs/SWPPredictionOut.h"
+#include "Outs/SWPSensorRangesOut.h"
 #include "Outs/SWPVehicleOut.h"
+#include "Registry/SWPControlChannel.h"
+#include "Registry/SWPFleetSnapshot.h"
+#include "Registry/SWPRoadGraphData.h"
+#include "Registry/SWPSpatialHash.h"
+#include "Registry/SWPStateHistory.h"
+#include "States/SWPPowertrainBatch.h"
+#include "States/SWPSensorScan.h"
+#include "States/SWPTireBatch.h"
 #include "States/SWPVehicleState.h"
 
 struct SMOKINWHEELSPHX_API FSWPAsyncCallbackInput : public Chaos::FSimCallbackInput
@@ -11,29 +27,97 @@ struct SMOKINWHEELSPHX_API FSWPAsyncCallbackInput : public Chaos::FSimCallbackIn
 	int32 Timestamp = INDEX_NONE;
 	TWeakObjectPtr<UWorld> CurrentWorld;
 	
-	TArray<FSWPVehicleConfig> VehicleConfigs;
-	TArray<FGuid> VehiclesToAdd;	
-	TArray<FGuid> VehiclesToRemove;	
+	// Wire format (POD only, memcpy'd from the GT mirror). Wheels are indexed by FirstWheel.
+	TArray<FSWPVehiclePacket> Vehicles;
+	TArray<FSWPWheelPacket> Wheels;
+
+	// Preset table entries registered (or reused) on GT since the previous input, by index.
+	TArray<TSWPPresetUpload<FSWPSuspensionTuning>> PresetsToUpload;
+	TArray<TSWPPresetUpload<FSWPPowertrainTuning>> PowertrainPresetsToUpload;
+	TArray<TSWPPresetUpload<FSWPSensorRig>> SensorRigsToUpload;
+	// Full surface table (SurfaceType_Max rows) when it changed on GT, empty otherwise.
+	TArray<FSWPSurfaceScale> SurfaceScales;
+	// New road graph when it changed on GT (shared, immutable), null otherwise.
+	TSharedPtr<const FSWPRoadGraphData, ESPMode::ThreadSafe> RoadGraph;
+	// Autopilot destination changes since the previous input.
+	TArray<FSWPAutopilotCommand> AutopilotCommands;
+	// Forward predictions requested since the previous input, and the world gravity they integrate (cm/s²).
+	TArray<FSWPPredictionRequest> PredictionRequests;
+	float GravityZ = -980.0f;
+	// Physics steps of PT state history kept for rewind/resim (0 = off, see EnableRewindHistory()).
+	int32 RewindHistoryFrames = 0;
+	// Quantize every vehicle's replication state into the output (fleet replicator installed or hibernation on).
+	bool bNetStates = false;
+	// Authoritative compression ratios to overwrite (replicated state on clients), sliced by FSWPSuspensionCorrection.
+	TArray<FSWPSuspensionCorrection> SuspensionCorrections;
+	TArray<float> CorrectedCompressions;
+	// Capture a fleet snapshot into this step's output (see FSWPFleetSnapshot).
+	bool bCaptureSnapshot = false;
+	// Snapshot states to load onto registered vehicles, compressions sliced by FSWPVehicleRestore.
+	TArray<FSWPVehicleRestore> VehicleRestores;
+	TArray<float> RestoredCompressions;
+
+	TArray<FSWPVehicleSlot> VehiclesToAdd;	
+	TArray<FSWPVehicleSlot> VehiclesToRemove;
+	TArray<FSWPVehicleSlot> VehiclesToReset;		// Recycled (pooled) vehicles: wipe PT state in place.
 	
 	void Reset()
 	{
 		CurrentWorld.Reset();
-		VehicleConfigs.Reset();
+		Vehicles.Reset();
+		Wheels.Reset();
+		PresetsToUpload.Reset();
+		PowertrainPresetsToUpload.Reset();
+		SensorRigsToUpload.Reset();
+		SurfaceScales.Reset();
+		RoadGraph.Reset();
+		AutopilotCommands.Reset();
+		PredictionRequests.Reset();
+		SuspensionCorrections.Reset();
+		CorrectedCompressions.Reset();
+		VehicleRestores.Reset();
+		RestoredCompressions.Reset();
 
 		VehiclesToAdd.Reset();
 		VehiclesToRemove.Reset();
+		VehiclesToReset.Reset();
 	}
 };
 
 struct SMOKINWHEELSPHX_API FSWPAsyncCallbackOutput : public Chaos::FSimCallbackOutput
 {
 	int32 Timestamp = INDEX_NONE;
+	// PT step that produced this output (local count), the solver physics step it ran as (same on every peer, reused by
+	// resimulated steps) and the checksum of every vehicle's state in it (swp.Deterministic, 0 when off).
+	uint32 Step = 0;
+	int32 PhysicsStep = INDEX_NONE;
+	uint32 StateChecksum = 0;
 
 	TArray<FSWPVehicleOut> VehicleOuts;
+	// Sensors scanned this step (the others kept their ranges), values sliced by FSWPSensorRangesOut::FirstValue/NumRanges.
+	TArray<FSWPSensorRangesOut> SensorUpdates;
+	TArray<uint16> SensorRanges;
+	// Forward predictions completed this step, poses sliced by FSWPPredictionOut::FirstPose/NumPoses.
+	TArray<FSWPPredictionOut> Predictions;
+	TArray<FTransform> PredictedPoses;
+	// Fleet snapshot captured at the start of this step (when requested): wheels and compressions sliced by each packet's FirstWheel.
+	bool bSnapshot = false;
+	TArray<FSWPSnapshotVehicle> SnapshotVehicles;
+	TArray<FSWPWheelPacket> SnapshotWheels;
+	TArray<float> SnapshotCompressions;
 	
 	void Reset()
 	{
+		StateChecksum = 0;
+		bSnapshot = false;
+		SnapshotVehicles.Reset();
+		SnapshotWheels.Reset();
+		SnapshotCompressions.Reset();
 		VehicleOuts.Reset();
+		SensorUpdates.Reset();
+		SensorRanges.Reset();
+		Predictions.Reset();
+		PredictedPoses.Reset();
 	}
 };
 
@@ -41,6 +125,10 @@ struct SMOKINWHEELSPHX_API FSWPVehiclePhysicsData
 {
 	FSWPVehicleState SimState;
 
+	// Slot ownership: packets from another generation (stale/reused slot) are ignored.
+	uint32 Generation = 0;
+	bool bAdmitted = false;
+
 	Chaos::FUniqueIdx PhysicsIdx;
 	Chaos::FPBDRigidParticleHandle* PhysicsHandle = nullptr;
 };
@@ -50,9 +138,31 @@ struct SMOKINWHEELSPHX_API FSWPVehiclePhysicsData
  * 
  * Chaos TSimCallbackObject implementation that runs on the Physics Thread (PT).
  * Responsibilities:
- *  - Consume per-step input produced on GT (FSimCallbackInput).
- *  - Maintain per-vehicle PT state (PhysicsDataVehicles).
- *  - Run per-vehicle simulation (suspension compute + force application).
+ *  - Consume per-step input produced on GT (FSimCallbackInput), and driver inputs from the
+ *    control channel (lock-free ring, only vehicles whose inputs changed).
+ *  - Drive vehicles with an engaged autopilot (AI traffic) from the uploaded road graph, as a
+ *    batched stage ahead of the vehicle step: the GT only sends destination changes.
+ *  - Trace the rays of the sensors due this step (own sub-rate per sensor) as a flat, chunked
+ *    query stage after the vehicle step, reporting compact ranges in the output.
+ *  - Optionally run in deterministic (lockstep) mode: snapped ground queries, a fixed-point
+ *    suspension force path, and a per-step checksum of all vehicle states (per-vehicle hashes of
+ *    the raw state bits, summed so the local vehicle order does not matter).
+ *  - Roll "what-if" forward predictions of single vehicles (given controls, frozen ground) on a
+ *    scratch copy of their state, many in parallel, without touching the live Chaos particles.
+ *  - With rewind enabled, save the PT-only vehicle state after every physics step in a ring
+ *    keyed by step, and restore it when Chaos resimulates (see FSWPRewindCallback).
+ *  - Capture the whole fleet into a flat snapshot on request (parallel, state as of the step
+ *    start), and load snapshot states in one pass: restored vehicles skip the admission budget,
+ *    their bodies are bound together and their chassis and state are overwritten in place.
+ *  - With a fleet replicator, quantize each vehicle's replicated state and flag the fields that
+ *    changed since the previous step, so the GT only delta-codes what moved.
+ *  - Rebuild a spatial hash of the chassis positions every step (neighbour queries for the
+ *    other stages, optionally published per vehicle to GT).
+ *  - Maintain per-vehicle PT state (PhysicsDataVehicles), admitting new vehicles under a
+ *    per-step budget so bulk spawns are spread over several steps.
+ *  - Run per-vehicle simulation (suspension compute + force application), with the
+ *    powertrain/aero and tire models as batched stages over the whole fleet between the
+ *    suspension step and the apply.
  *  - Produce per-step output for GT (FSimCallbackOutput).
  *
  * Threading contract:
@@ -60,10 +170,91 @@ struct SMOKINWHEELSPHX_API FSWPVehiclePhysicsData
  *  - Only consume POD/config/handles prepared by GT; only write to PT-owned state
  *    and to the output packet that GT will read in ScenePostTick().
  */
-class SMOKINWHEELSPHX_API FSWPAsyncCallback : public Chaos::TSimCallbackObject<FSWPAsyncCallbackInput, FSWPAsyncCallbackOutput>
+class SMOKINWHEELSPHX_API FSWPAsyncCallback : public Chaos::TSimCallbackObject<FSWPAsyncCallbackInput, FSWPAsyncCallbackOutput,
+	Chaos::ESimCallbackOptions::Presimulate | Chaos::ESimCallbackOptions::Rewind>
 {
-	TMap<FGuid, FSWPVehiclePhysicsData> PhysicsDataVehicles;
+public:
+	// GT: driver inputs go through this ring, not through the per-step input snapshot.
+	FORCEINLINE FSWPControlChannel& GetControlChannel() { return ControlChannel; }
+	// Number of PT steps started so far (readable from any thread, used to measure input latency).
+	FORCEINLINE uint32 GetNumSteps() const { return NumSteps.load(std::memory_order_relaxed); }
+
+	// PT, from FSWPRewindCallback: physics step about to run, and resimulated steps after a rewind.
+	FORCEINLINE void SetPhysicsStep_Internal(const int32 InPhysicsStep) { PhysicsStep = InPhysicsStep; }
+	void PreResimStep_Internal(const int32 InPhysicsStep, const bool bFirstStep)
+	{
+		PhysicsStep = InPhysicsStep;
+		bResimStep = true;
+		bRestorePending |= bFirstStep;
+	}
+	FORCEINLINE void PostResimStep_Internal(const int32) { bResimStep = false; }
+
+private:
+	// Indexed by slot (GT allocates slots densely, so this stays compact).
+	TArray<FSWPVehiclePhysicsData> PhysicsDataVehicles;
 	TArray<FSWPVehiclePhysicsData*> PhysicsSortedDataVehicles;
+	TArray<const FSWPVehiclePacket*> PhysicsSortedPackets;
+	TArray<int32> PhysicsSortedWheelBases;		// First tire batch index of each sorted vehicle.
+	TArray<int32> PhysicsSortedAutopilots;		// Sorted indices of the vehicles with an engaged autopilot.
+	TArray<int32> PhysicsSortedIndices;			// Sorted index by slot (INDEX_NONE: not simulated), built for prediction lookups.
+
+	// Fleet-wide tire/powertrain buffers, rebuilt in place every step (swp.TireModel, swp.Powertrain).
+	FSWPTireBatch Tires;
+	FSWPPowertrainBatch Powertrain;
+
+	// Chassis positions of the step, indexed like PhysicsSortedDataVehicles (swp.SpatialHash).
+	FSWPSpatialHash SpatialHash;
+
+	// Shared suspension presets, mirrored from FSWPPresetRegistry (wheel packets index into it).
+	TArray<FSWPSuspensionTuning> Presets;
+	TArray<FSWPPowertrainTuning> PowertrainPresets;
+	TArray<FSWPSensorRig> SensorRigs;
+
+	// Sensors due this step (flat ray list for the sensor stage).
+	TArray<FSWPSensorScan> SensorScans;
+
+	// Per-surface multipliers (indexed by surface ID) and the hit -> surface ID cache.
+	TArray<FSWPSurfaceScale> SurfaceScales;
+	FSWPSurfaceCache SurfaceCache;
+
+	// Autopilot road graph (read-only while stepping) and commands waiting for their vehicle's admission.
+	TSharedPtr<const FSWPRoadGraphData, ESPMode::ThreadSafe> RoadGraph;
+	TArray<FSWPAutopilotCommand> PendingAutopilotCommands;
+	// Vehicles planned this step (swp.MaxReplansPerStep) and one A* scratch per concurrent plan, kept across steps.
+	TArray<int32> AutopilotReplans;
+	TArray<FSWPRouteScratch> RouteScratch;
+	// Newest control sample per slot not admitted yet (applied by Admit_Internal when the generation matches).
+	TMap<int32, FSWPControlSample> PendingControls;
+
+	// Prediction requests not run yet (FIFO, drained by swp.MaxPredictionsPerStep) and the step index of each one run this step.
+	TArray<FSWPPredictionRequest> PendingPredictions;
+	TArray<int32> PredictionVehicles;
+
+	// Rewind support: state after each recent physics step (INDEX_NONE while no rewind callback reports steps).
+	FSWPStateHistory History;
+	int32 PhysicsStep = INDEX_NONE;
+	bool bResimStep = false;
+	bool bRestorePending = false;
+
+	// Per-vehicle state hashes of the step (swp.Deterministic), indexed like PhysicsSortedDataVehicles.
+	TArray<uint32> VehicleChecksums;
+
+	FSWPControlChannel ControlChannel;
+	std::atomic<uint32> NumSteps { 0 };
+
+	// Vehicles added on GT but not simulated yet (FIFO, drained by swp.MaxAdmissionsPerStep).
+	TArray<FSWPVehicleSlot> PendingAdmissions;
+	// Vehicles without a rigid handle this step, by particle index (scratch of the single binding pass).
+	TMap<int32, FSWPVehiclePhysicsData*> UnboundVehicles;
+
+	// Snapshot states waiting for their vehicle's body to be bound, compressions sliced by FSWPVehicleRestore.
+	TArray<FSWPVehicleRestore> PendingRestores;
+	TArray<float> PendingRestoredCompressions;
 	
 	virtual void OnPreSimulate_Internal() override;
+	void ConsumeInput_Internal(const FSWPAsyncCallbackInput& AsyncInput, uint32 Step);
+	void Admit_Internal(const FSWPVehicleSlot& Slot);
+	void LoadRestores_Internal();
+	void RestoreHistory_Internal();
+	void PublishEmptyStep_Internal(const FSWPAsyncCallbackInput& AsyncInput, uint32 Step, bool bFleetSettled);
 };
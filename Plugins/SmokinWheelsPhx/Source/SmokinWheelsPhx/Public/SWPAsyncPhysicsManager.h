@@ -2,11 +2,21 @@
 
 #pragma once
 
-#include "Configs/SWPSuspensionConfig.h"
+#include "RewindData.h"
+#include "SWPAsyncCallback.h"
+#include "Registry/SWPPresetRegistry.h"
+#include "Registry/SWPSlotAllocator.h"
+#include "Registry/SWPVehicleMirror.h"
+#include "Registry/SWPVehicleRegistry.h"
+#include "Tasks/Task.h"
 
-class FSWPAsyncCallback;
-class USWPSuspension;
+struct FSWPWheelDefinition;
 class ASWPVehicle;
+class ASWPFleetReplicator;
+class ASWPFleetVisualizer;
+class USWPPowertrainPreset;
+class USWPRoadGraph;
+class USWPSurfaceTable;
 
 /**
  * FSWPAsyncPhysicsManager
@@ -14,14 +24,38 @@ class ASWPVehicle;
  * Game-Thread (GT) manager that owns:
  *  - Per-physics-scene lifecycle (register/unregister of Chaos callbacks)
  *  - The GT<->PT data exchange (Producer input / Consumer output buffers)
- *  - A per-vehicle registry (WeakObjectPtrs on GT; simulation state lives on PT)
+ *  - A per-vehicle registry (WeakObjectPtrs on GT, O(1) add/remove via stable slots stored on
+ *    the vehicle; simulation state lives on PT)
  *
  * Design notes:
  *  - One manager per FPhysScene (no global singleton). See SceneToPhysicsManagerMap.
  *  - GT writes Input buffers; PT writes Output buffers. No UObject deref on PT.
  *  - Vehicles are referenced on GT via TWeakObjectPtr (lifecycle-safe). PT uses
- *    POD/handles only (FGuid / Chaos::FUniqueIdx / rigid handles).
+ *    POD/handles only: slot indices (+ generation) instead of FGuids, particle indices,
+ *    actor unique IDs for trace filtering, rigid handles. See Configs/SWPVehiclePacket.h.
  *  - Debug drawing happens on GT in ScenePostTick(), consuming PT outputs.
+ *  - Input packets are pipelined: vehicles live in a mirror already in wire format (updated
+ *    through queued edits), a background task memcpy's it into the next packet while the game
+ *    frame runs, and ScenePreTick() only publishes the ready packet. Changes therefore reach
+ *    the PT one pre-tick after they were made.
+ *  - Suspension tunings are interned in a preset table uploaded to the PT once; wheel packets
+ *    only carry an index into it (shared presets, copy-on-write for per-wheel edits).
+ *    Powertrain presets and sensor rigs use the same scheme, indexed from the vehicle packet.
+ *  - AI traffic is driven on the PT (autopilot stage) over a road graph uploaded once; the GT
+ *    only publishes destination changes (SetAutopilotDestination()).
+ *  - Rewind/resim (EnableRewindHistory()) is handled on the PT: the callback keeps a per-step
+ *    history of its own state and restores it when Chaos resimulates, without GT involvement.
+ *  - Trajectory previews are asynchronous: RequestPrediction() now, TryGetPrediction() once a
+ *    later PT output carried the result.
+ *  - Fleet snapshots: RequestSnapshot()/TryGetSnapshot() save the whole simulated fleet as one
+ *    flat blob (FSWPFleetSnapshot); RestoreSnapshot()/AddSnapshotVehicles() load it back in one
+ *    bulk PT pass instead of a warm-up simulation.
+ *  - Streaming: vehicles unloaded with their World Partition cell are hibernated into a few bytes
+ *    each (USWPHibernationSubsystem) and rehydrated in budgeted batches when the cell reloads.
+ *  - Networking: with an ASWPFleetReplicator on the server, actor vehicles are replicated over a
+ *    quantized, delta-compressed channel fed by the PT output (not by actor replication).
+ *  - Non-actor owners (e.g., Mass entities) register through AddExternalVehicle() with
+ *    a particle UniqueIdx + wheel definitions, and read results via FindLatestVehicleOut().
  */
 class SMOKINWHEELSPHX_API FSWPAsyncPhysicsManager
 {
@@ -44,10 +78,147 @@ public:
 
 	FGuid AddVehicle(TWeakObjectPtr<ASWPVehicle> Vehicle);
 	void RemoveVehicle(TWeakObjectPtr<ASWPVehicle> Vehicle);
+	/** Queue an in-place PT state reset (used when a pooled vehicle is reused). */
+	void ResetVehicleState(const FGuid& Guid);
+	/** Moves a registered vehicle to a new GUID, keeping its PT slot (pooled vehicle reused). False if OldGuid is unknown. */
+	bool RekeyVehicle(const FGuid& OldGuid, const FGuid& NewGuid);
+	/** Re-sample the vehicle's PT config (after wheel edits or body recreation). */
+	void UpdateVehicle(const ASWPVehicle* Vehicle);
+	/** Include/exclude the vehicle from the PT step without unregistering it (pooling). */
+	void SetVehicleActive(const FGuid& Guid, bool bActive);
+
+	/**
+	 * Driver inputs (GT). Pushed on the lock-free control channel and applied from the PT step
+	 * that consumes the current frame's input; only call when the inputs change. Samples sent before
+	 * the vehicle is admitted are held on the PT (newest per vehicle) and applied on admission.
+	 * False when nothing was sent (no PT callback, or the vehicle is not registered).
+	 */
+	bool PushControls(const FGuid& Guid, const FSWPVehicleControls& Controls);
+
+	/**
+	 * Hand the vehicle to the PT autopilot: it plans a route on the road graph to DestinationNode
+	 * and drives it at up to CruiseSpeedKmh, overriding driver inputs. INDEX_NONE disengages.
+	 */
+	void SetAutopilotDestination(const FGuid& Guid, int32 DestinationNode, float CruiseSpeedKmh = 50.0f);
+
+	/**
+	 * "What-if" trajectory: roll the vehicle NumSteps physics steps forward on the PT under fixed
+	 * Controls (frozen ground, no other bodies), one pose every SampleEvery steps. The live vehicle
+	 * is not affected. Returns the request ID to poll with TryGetPrediction(), INDEX_NONE if unknown.
+	 */
+	int32 RequestPrediction(const FGuid& Guid, const FSWPVehicleControls& Controls, int32 NumSteps, int32 SampleEvery = 1);
+	/**
+	 * Claims a completed prediction (actor poses, oldest first). False while it is in flight; true with
+	 * no poses when the vehicle was not simulated or swp.Prediction is off. Unclaimed results are dropped after MaxUnclaimedPredictions newer ones.
+	 */
+	bool TryGetPrediction(int32 RequestId, TArray<FTransform>& OutPoses);
+
+	FGuid AddExternalVehicle(Chaos::FUniqueIdx PhysicsIdx, const TArray<FSWPWheelDefinition>& Wheels,
+							 ESWPContactMode ContactMode = ESWPContactMode::Ray,
+							 const USWPPowertrainPreset* Powertrain = nullptr,
+							 const TArray<FSWPSensorDefinition>& Sensors = TArray<FSWPSensorDefinition>());
+	void RemoveExternalVehicle(const FGuid& Guid);
+
+	/** Latest PT output for a vehicle (valid until the next ScenePostTick), or nullptr. */
+	const FSWPVehicleOut* FindLatestVehicleOut(const FGuid& Guid) const;
+	/**
+	 * Nearest vehicles of the latest PT output, nearest first (needs swp.PublishNeighbors > 0).
+	 * Vehicles unregistered since then are skipped. False when the vehicle has no output.
+	 */
+	bool FindLatestNeighbors(const FGuid& Guid, TArray<FGuid>& OutNeighbors) const;
+	/**
+	 * Latest sensor ranges of a vehicle (whole cm, FSWPSensorRig::NoHit = no hit), all sensors back
+	 * to back in declaration order (NoHit until a sensor's first scan). Valid until the next
+	 * ScenePostTick; empty before the vehicle's first scan.
+	 */
+	TConstArrayView<uint16> FindLatestSensorRanges(const FGuid& Guid) const;
+
+	/**
+	 * Lockstep/replay desync check: checksum of every vehicle's PT state in solver physics step
+	 * PhysicsStep (swp.Deterministic, 0 when off). Peers fed the same inputs report the same value;
+	 * a resimulated step replaces the checksum of its original run. False when that step is not
+	 * among the last ChecksumHistorySize outputs.
+	 */
+	bool FindStepChecksum(int32 PhysicsStep, uint32& OutChecksum) const;
+	/** Newest solver physics step whose output reached the GT (INDEX_NONE before the first one). */
+	FORCEINLINE int32 GetLatestStep() const { return LatestStep; }
+
+	/**
+	 * Networked physics: enables Chaos rewind capture for NumFrames steps and keeps the same number
+	 * of steps of PT-only vehicle state (suspension compression, gear, controls, autopilot), restored
+	 * when Chaos resimulates after a correction. The game's own rewind callback (deciding when to
+	 * rewind) is wrapped and still receives every call. NumFrames 0 stops recording the vehicle state and
+	 * removes the wrapper, installing GameRewindCallback (when passed) on the solver as is; the solver's own
+	 * capture stays on, as Chaos has no call to disable it once enabled.
+	 */
+	void EnableRewindHistory(int32 NumFrames, TUniquePtr<Chaos::IRewindCallback>&& GameRewindCallback = TUniquePtr<Chaos::IRewindCallback>());
+
+	/**
+	 * Fleet snapshot (save): the PT captures every simulated vehicle (chassis pose/velocities, carried-over
+	 * state, configs) at its next step (an empty fleet gives an empty snapshot). Registered vehicles that are
+	 * still waiting for admission or for their physics body to bind have no PT state yet, so the capture is
+	 * deferred until none is left (a body that never binds keeps the request pending). TryGetSnapshot() then
+	 * hands out the blob (see FSWPFleetSnapshot) and the GUID of each of its vehicles in snapshot order, for
+	 * the game to record what to respawn.
+	 */
+	void RequestSnapshot();
+	bool TryGetSnapshot(TArray<uint8>& OutSnapshot, TArray<FGuid>& OutGuids);
+	/**
+	 * Fleet snapshot (load); Snapshot may be a memory-mapped file (16-byte aligned). Snapshot vehicle i is
+	 * loaded onto Guids[i] (registered vehicles, e.g. respawned actors; unknown GUIDs are skipped): the PT
+	 * admits them at once, binds their bodies in one pass and overwrites chassis and state in place.
+	 * Returns the number of vehicles queued, INDEX_NONE for an invalid or incompatible blob.
+	 */
+	int32 RestoreSnapshot(TConstArrayView<uint8> Snapshot, TConstArrayView<FGuid> Guids);
+	/**
+	 * Registers actor-less vehicles straight from a snapshot onto the given bodies (PhysicsIdxs[i] for
+	 * snapshot vehicle i; configs and presets from the blob, no wheel definitions needed) and restores
+	 * them. OutGuids follows the snapshot order (invalid for vehicles without a body). False for an invalid blob.
+	 */
+	bool AddSnapshotVehicles(TConstArrayView<uint8> Snapshot, TConstArrayView<Chaos::FUniqueIdx> PhysicsIdxs, TArray<FGuid>& OutGuids);
+	/**
+	 * Loads one vehicle's carried-over state (chassis, gear, controls, autopilot; Slot/Generation/FirstCompression
+	 * are filled in here) plus one compression per wheel, like a snapshot restore: no admission budget, applied
+	 * once the body is bound. Used to rehydrate streamed-in vehicles.
+	 */
+	void RestoreVehicle(const FGuid& Guid, const FSWPVehicleRestore& State, TConstArrayView<float> Compressions);
+
+	/**
+	 * Streaming hibernation (USWPHibernationSubsystem): while enabled, the PT quantizes each vehicle's state
+	 * into its output (as for replication), so a vehicle unloaded with its cell leaves a record behind.
+	 */
+	FORCEINLINE void SetHibernationEnabled(const bool bEnabled) { bHibernation = bEnabled; }
+
+	/**
+	 * Server: fleet replication channel fed from ScenePostTick with every drained output (nullptr to
+	 * disable). While set, the PT quantizes each vehicle's replicated state and flags its changes.
+	 */
+	void SetFleetReplicator(ASWPFleetReplicator* InFleetReplicator);
+	/** Client: authoritative compression ratios (one per wheel) written into the PT state at the next step. */
+	void SetSuspensionCompressions(const FGuid& Guid, TConstArrayView<float> Compressions);
+
+	/** Optional instanced visual backend fed from ScenePostTick (nullptr to disable). */
+	void SetVisualBackend(ASWPFleetVisualizer* InVisualBackend);
+	bool ShouldHideVehicleMeshes() const;
+
+	/** Per-surface suspension multipliers, uploaded to the PT at the next pre-tick (nullptr = all 1.0). */
+	void SetSurfaceTable(const USWPSurfaceTable* SurfaceTable);
+
+	/** Road graph for the autopilot, flattened and uploaded to the PT at the next pre-tick (nullptr = none). */
+	void SetRoadGraph(const USWPRoadGraph* InRoadGraph);
 
 	static Chaos::FUniqueIdx GetChaosUniqueIdx(const FBodyInstance* BI);
-	static FSWPSuspensionConfig BuildSuspensionCfg(const USWPSuspension* Suspension);
 	
+private:
+	bool BuildVehiclePacket(const ASWPVehicle& Vehicle, const FSWPVehicleSlot& Slot, FSWPVehicleMirrorEdit& OutEdit);
+	bool InternTunings(const USWPPowertrainPreset* Powertrain, const TArray<FSWPSensorDefinition>& Sensors,
+					   const TArray<FSWPWheelDefinition>& Wheels, FSWPVehicleMirrorEdit& OutEdit);
+	void ReleaseTunings(const FSWPVehiclePacket& Vehicle, TConstArrayView<FSWPWheelPacket> Wheels);
+	FSWPVehicleMirrorEdit& QueueMirrorEdit(ESWPVehicleMirrorOp Op, int32 Slot, bool bActive);
+	void LaunchInputBuild();
+	int32 QueueRestores(const FSWPFleetSnapshot& View, TConstArrayView<FGuid> Guids);
+	void FlushControlBacklog();
+
 private:
 	static bool bInitialized;
 	static TMap<FPhysScene*, FSWPAsyncPhysicsManager*> SceneToPhysicsManagerMap;
@@ -62,7 +233,89 @@ private:
 
 	FSWPAsyncCallback* AsyncObject;
 
-	TArray<TWeakObjectPtr<ASWPVehicle>> Vehicles;
-	TArray<FGuid> VehiclesToAdd;	
-	TArray<FGuid> VehiclesToRemove;	
+	FSWPVehicleRegistry Vehicles;
+	FSWPSlotAllocator Slots;
+	TArray<FSWPVehicleSlot> VehiclesToAdd;	
+	TArray<FSWPVehicleSlot> VehiclesToRemove;
+	TArray<FSWPVehicleSlot> VehiclesToReset;
+
+	// Frame counter stamped on every input packet and control sample.
+	int32 Timestamp = 0;
+	// Control samples that did not fit in the ring (retried in order at the next pre-tick).
+	TArray<FSWPControlSample> ControlBacklog;
+
+	// Shared suspension tunings (flyweight), referenced by index from every wheel packet.
+	FSWPPresetRegistry Presets;
+	// Same scheme for powertrains, referenced by index from the vehicle packet.
+	FSWPPowertrainRegistry Powertrains;
+	FSWPSensorRigRegistry SensorRigs;
+
+	// Flattened surface table (SurfaceType_Max rows), re-sent to the PT only when it changes.
+	TArray<FSWPSurfaceScale> SurfaceScales;
+	bool bSurfaceScalesDirty = false;
+
+	// Flattened road graph (shared with the PT once sent) and destination changes for the next input.
+	TSharedPtr<const FSWPRoadGraphData, ESPMode::ThreadSafe> RoadGraph;
+	bool bRoadGraphDirty = false;
+	TArray<FSWPAutopilotCommand> AutopilotCommands;
+
+	// Prediction requests for the next input, and completed results waiting to be claimed (by request ID).
+	static constexpr int32 MaxUnclaimedPredictions = 256;
+	int32 NextPredictionId = 0;
+	TArray<FSWPPredictionRequest> PredictionRequests;
+	TMap<int32, TArray<FTransform>> Predictions;
+
+	// PT state history length sent with every input (0 = off), and whether our rewind callback is on the solver.
+	int32 RewindHistoryFrames = 0;
+	bool bRewindCallbackInstalled = false;
+
+	// Replicated compression ratios for the next input (client side of fleet replication).
+	TArray<FSWPSuspensionCorrection> SuspensionCorrections;
+	TArray<float> CorrectedCompressions;
+
+	// Snapshot capture in flight (re-requested every input until an output carries it) and the last unclaimed result.
+	bool bSnapshotRequested = false;
+	bool bSnapshotReady = false;
+	TArray<uint8> CompletedSnapshot;
+	TArray<FGuid> CompletedSnapshotGuids;
+	// Snapshot states for the next input.
+	TArray<FSWPVehicleRestore> VehicleRestores;
+	TArray<float> RestoredCompressions;
+
+	// Actor-less vehicles (packet lives in the mirror, built once at registration).
+	TSet<FGuid> ExternalVehicles;
+
+	// Pipelined input build: edits are applied to the mirror at pre-tick, then BuildTask copies
+	// the active packets into Staged*, which the next pre-tick swaps into the input.
+	FSWPVehicleMirror Mirror;
+	TArray<FSWPVehicleMirrorEdit> PendingMirrorEdits;
+	TArray<FSWPVehiclePacket> StagedVehicles;
+	TArray<FSWPWheelPacket> StagedWheels;
+	UE::Tasks::FTask BuildTask;
+
+	// Most recent PT output kept alive for GT consumers (Mass processors, visuals).
+	Chaos::TSimCallbackOutputHandle<FSWPAsyncCallbackOutput> LatestOutput;
+	TMap<FGuid, int32> LatestOutIndices;
+
+	// Latest sensor ranges by slot: outputs only carry the sensors scanned in their step, merged here.
+	struct FSensorRanges
+	{
+		uint32 Generation = 0;
+		TArray<uint16> Ranges;
+	};
+	TArray<FSensorRanges> SensorRanges;
+
+	// State checksums of the recent solver physics steps, indexed by PhysicsStep % ChecksumHistorySize.
+	struct FStepChecksum
+	{
+		int32 PhysicsStep = INDEX_NONE;
+		uint32 Checksum = 0;
+	};
+	static constexpr int32 ChecksumHistorySize = 256;
+	TArray<FStepChecksum> StepChecksums;
+	int32 LatestStep = INDEX_NONE;
+
+	TWeakObjectPtr<ASWPFleetVisualizer> VisualBackend;
+	TWeakObjectPtr<ASWPFleetReplicator> FleetReplicator;
+	bool bHibernation = false;
 };
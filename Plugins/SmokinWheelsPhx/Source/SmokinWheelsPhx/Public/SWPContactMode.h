@@ -0,0 +1,24 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SWPContactMode.generated.h"
+
+/**
+ * How a vehicle's wheels query the ground (per vehicle, cheapest first).
+ * Cost per step is reported per mode in 'stat SmokinWheelsPhx'.
+ */
+UENUM(BlueprintType)
+enum class ESWPContactMode : uint8
+{
+	/** One ray per wheel along the suspension axis. Cheapest; misses curbs/potholes smaller than the wheel. */
+	Ray,
+	/**
+	 * Fixed fan of 5 rays over the contact patch (along the rolling direction), reduced to the highest
+	 * contact. Each ray is its own scene query: about five times the cost of Ray per wheel.
+	 */
+	RayFan,
+	/** Sphere sweep of the wheel radius along the suspension travel. Highest fidelity, most expensive. */
+	Sweep,
+};
@@ -0,0 +1,96 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Outs/SWPNetVehicleState.h"
+#include "SWPFleetNetComponent.generated.h"
+
+class ASWPFleetReplicator;
+
+/**
+ * USWPFleetNetComponent
+ *
+ * One client's end of the fleet replication channel, added by ASWPFleetReplicator to the
+ * client's player controller on the server (so RPCs have an owning connection).
+ *
+ * Server: keeps, per vehicle, the last state this client acknowledged and its priority, and the
+ * vehicles of the last BaselineWindow packets until their ack arrives. A vehicle is sent while
+ * a field changed after the acknowledged state (delta against it), or in full when there is no
+ * usable baseline.
+ * Client: keeps the states of the last BaselineWindow packets per vehicle as delta baselines,
+ * applies the newest state of each vehicle and acks every decoded packet.
+ *
+ * Packet: sequence, vehicle count, then per vehicle its network ID, baseline age in packets
+ * (0: full state) and the fields encoded by FSWPFleetNetCodec.
+ */
+UCLASS(ClassGroup = (SmokinWheelsPhx))
+class SMOKINWHEELSPHX_API USWPFleetNetComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 BaselineWindow = 32;
+
+	USWPFleetNetComponent();
+
+	/** Server: builds and sends this client's next packet (DeltaTime since the previous one, for the priorities). */
+	void SendPacket(const ASWPFleetReplicator& Replicator, const FVector& ViewLocation, float DeltaTime);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	UPROPERTY(Replicated)
+	TObjectPtr<ASWPFleetReplicator> Replicator;
+
+protected:
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveFleetPacket(const TArray<uint8>& Packet);
+
+	UFUNCTION(Server, Unreliable)
+	void ServerAckFleetPacket(uint32 Sequence);
+
+private:
+	// Server: what this client holds of one vehicle.
+	struct FClientVehicle
+	{
+		uint32 Generation = 0;
+		uint32 AckedSequence = 0;		// 0: nothing acknowledged yet.
+		uint32 AckedStep = 0;
+		uint32 LastSentSequence = 0;
+		FSWPNetVehicleState AckedState;
+		float Priority = 0.0f;
+	};
+
+	// Server: one vehicle of a packet waiting for its ack.
+	struct FSentVehicle
+	{
+		int32 NetId = INDEX_NONE;
+		uint32 Generation = 0;
+		uint32 Step = 0;
+		FSWPNetVehicleState State;
+	};
+
+	struct FSentPacket
+	{
+		uint32 Sequence = 0;			// 0: free or already acknowledged.
+		TArray<FSentVehicle> Vehicles;
+	};
+
+	// Client: one received state, kept as a delta baseline.
+	struct FBaseline
+	{
+		uint32 Sequence = 0;
+		FSWPNetVehicleState State;
+	};
+
+	// Server side.
+	TArray<FClientVehicle> ClientVehicles;		// By network ID.
+	TArray<FSentPacket> SentPackets;			// By Sequence % BaselineWindow.
+	TArray<TPair<int32, uint8>> Candidates;		// Network ID, pending fields (scratch).
+	uint32 NextSequence = 1;
+
+	// Client side.
+	TArray<FBaseline> Baselines;				// [NetId * BaselineWindow + Sequence % BaselineWindow]
+	TArray<uint32> AppliedSequences;			// By network ID.
+};
@@ -0,0 +1,96 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Configs/SWPVehiclePacket.h"
+#include "Outs/SWPNetVehicleState.h"
+#include "SWPFleetReplicator.generated.h"
+
+class ASWPVehicle;
+struct FSWPVehicleOut;
+
+// Server-side entry of one replicated vehicle, indexed by its network ID.
+struct FSWPFleetNetVehicle
+{
+	FSWPVehicleSlot Slot;				// PT slot (INDEX_NONE: free network ID).
+	uint32 Generation = 0;				// Bumped on every reuse of the network ID: client baselines of the previous vehicle are dropped.
+	uint32 Step = 0;					// PT step of State.
+	uint32 ChangedSteps[FSWPNetVehicleState::NumFields] = {};	// Last PT step each field changed (PT dirty bits).
+	FSWPNetVehicleState State;
+};
+
+/**
+ * ASWPFleetReplicator
+ *
+ * Fleet replication channel. When present in a level, the server's physics manager registers
+ * every ASWPVehicle with it and hands it each PT output: the PT already quantizes the chassis
+ * pose/velocities and wheel compressions (FSWPNetVehicleState) and flags which fields changed,
+ * so the GT only tracks the step each field last changed.
+ *
+ * Every client gets a USWPFleetNetComponent on its player controller, which sends it unreliable
+ * packets at NetUpdateRate: changed vehicles only, delta-coded against the last state that
+ * client acknowledged, most relevant (closest, longest waiting) first up to MaxBytesPerPacket.
+ * Clients apply the decoded states to their own vehicles (body pose/velocities teleported,
+ * compressions handed to their PT).
+ *
+ * The vehicle list (actor references, by network ID) uses regular property replication; the
+ * standard movement replication of the registered vehicles is turned off.
+ *
+ * Threading: GT only.
+ */
+UCLASS(Blueprintable)
+class SMOKINWHEELSPHX_API ASWPFleetReplicator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Packets per second sent to each client. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Replication", meta = (ClampMin = "1.0"))
+	float NetUpdateRate = 30.0f;
+
+	/** Byte budget of one client packet; vehicles that do not fit keep their priority for the next one. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Replication", meta = (ClampMin = "64"))
+	int32 MaxBytesPerPacket = 1000;
+
+	/** Distance (cm) from a client's view point at which a vehicle's priority grows half as fast. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Replication", meta = (ClampMin = "1.0"))
+	float RelevanceDistance = 10000.0f;
+
+	/** Vehicles farther than this (cm) from a client's view point are not sent to it (0 = no limit). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Replication", meta = (ClampMin = "0.0"))
+	float CullDistance = 0.0f;
+
+public:
+	ASWPFleetReplicator();
+
+	/** Server, from the physics manager: (un)registration and every consumed PT output. */
+	void AddVehicle(ASWPVehicle* Vehicle, const FSWPVehicleSlot& Slot);
+	void RemoveVehicle(int32 SlotIndex);
+	void ConsumeVehicleOuts(const TArray<FSWPVehicleOut>& VehicleOuts, uint32 Step);
+
+	FORCEINLINE const TArray<FSWPFleetNetVehicle>& GetNetVehicles() const { return NetVehicles; }
+
+	/** Client, from USWPFleetNetComponent: newest decoded state of a vehicle. */
+	void ApplyNetState(int32 NetId, const FSWPNetVehicleState& State) const;
+
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Registered vehicles by network ID (null: free), resolved on clients as their actors arrive.
+	UPROPERTY(Replicated)
+	TArray<TObjectPtr<ASWPVehicle>> Vehicles;
+
+	// Server only: entries by network ID, PT slot -> network ID, and IDs to reuse.
+	TArray<FSWPFleetNetVehicle> NetVehicles;
+	TArray<int32> SlotToNetId;
+	TArray<int32> FreeNetIds;
+
+	float TimeToNextPacket = 0.0f;
+};
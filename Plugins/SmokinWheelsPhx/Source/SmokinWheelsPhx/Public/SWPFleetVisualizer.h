@@ -0,0 +1,79 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SWPFleetVisualizer.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+struct FSWPVehicleOut;
+
+/** One rendered mesh part of the fleet (becomes one instanced static mesh component). */
+USTRUCT(BlueprintType)
+struct SMOKINWHEELSPHX_API FSWPFleetVisualPart
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	TObjectPtr<UStaticMesh> Mesh = nullptr;
+
+	/** Optional material overrides (by slot index). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	TArray<TObjectPtr<UMaterialInterface>> OverrideMaterials;
+
+	/** If true, one instance per wheel (placed at the wheel hub); otherwise one instance per chassis. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	bool bPerWheel = false;
+
+	/** Mesh offset relative to the chassis (or wheel hub when bPerWheel). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	FTransform RelativeTransform = FTransform::Identity;
+};
+
+/**
+ * ASWPFleetVisualizer
+ *
+ * Optional visual backend. When present in a level, FSWPAsyncPhysicsManager::ScenePostTick()
+ * hands it the latest PT output and every chassis/wheel transform is written into a few
+ * UInstancedStaticMeshComponents (one per mesh part) with one batched update per part per frame.
+ * Per-vehicle meshes are hidden (collision/physics untouched), so GT and render-thread cost no
+ * longer scale with one proxy update per vehicle body.
+ *
+ * Threading: GT only.
+ */
+UCLASS(Blueprintable)
+class SMOKINWHEELSPHX_API ASWPFleetVisualizer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/** Mesh parts rendered for every simulated vehicle. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	TArray<FSWPFleetVisualPart> Parts;
+
+	/** Hide per-actor vehicle meshes while this backend is active. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Visual")
+	bool bHideVehicleMeshes = true;
+
+public:
+	ASWPFleetVisualizer();
+
+	/** Called by the physics manager with the newest consumed output (GT). */
+	void ApplyVehicleOuts(const TArray<FSWPVehicleOut>& VehicleOuts);
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> PartComponents;
+
+	// Scratch buffers reused every frame (no per-frame allocation once warmed up).
+	TArray<FTransform> InstanceTransforms;
+	TArray<FTransform> AddedTransforms;
+	TArray<int32> RemovedInstances;
+};
@@ -0,0 +1,75 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SWPHibernationSubsystem.generated.h"
+
+class ASWPVehicle;
+
+/**
+ * USWPHibernationSubsystem
+ *
+ * Streaming-aware vehicle hibernation. When a World Partition cell (or any streamed level) unloads,
+ * its vehicles leave a compact record behind (chassis pose/velocities and one byte per wheel of
+ * suspension compression, varint-coded as on the replication wire, plus the gear, controls and
+ * autopilot destination/cruise speed) and their body and PT slot are released with the actor.
+ * When the cell streams back in, the respawned actors stay parked (no simulation, no collision)
+ * until their batch (swp.MaxRehydrationsPerFrame per frame), then re-enter the simulation with the
+ * recorded state loaded onto the PT, instead of dropping in and settling from scratch.
+ *
+ * Records are keyed by level package and actor name (stable across reloads). Actor vehicles on the
+ * server or in standalone games only; clients receive the state from the fleet replicator.
+ * Off by default (swp.Hibernation): while enabled, the PT quantizes the fleet's state every step.
+ */
+UCLASS()
+class SMOKINWHEELSPHX_API USWPHibernationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Vehicle unloaded with its level: records its latest PT state. False when it has none (it respawns from scratch). */
+	bool HibernateVehicle(const ASWPVehicle* Vehicle);
+	/** Vehicle streamed back in: true when a record is waiting for it; it then stays parked until rehydrated. */
+	bool QueueRehydration(ASWPVehicle* Vehicle);
+
+	FORCEINLINE int32 GetNumHibernated() const { return NumHibernated; }
+	/** Memory held by the records of every unloaded level, in bytes. */
+	SIZE_T GetHibernatedBytes() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FHibernatedVehicle
+	{
+		int32 Offset = 0;		// Record bytes in the cell's buffer.
+		uint16 NumBytes = 0;
+		int8 Gear = 0;
+		FVector3f Controls = FVector3f::ZeroVector;		// Throttle, steering, brake.
+		int32 Destination = INDEX_NONE;					// Autopilot road graph node (INDEX_NONE: off).
+		float CruiseSpeed = 0.0f;						// m/s
+	};
+
+	struct FHibernatedCell
+	{
+		TArray<uint8> Records;
+		TMap<FName, FHibernatedVehicle> Vehicles;
+	};
+
+	void RehydrateVehicle(ASWPVehicle* Vehicle);
+
+	static void RemoveRecord(FHibernatedCell& Cell, const FHibernatedVehicle& Record);
+	static FName GetCellName(const AActor* Actor);
+
+	bool bEnabled = false;
+	int32 NumHibernated = 0;
+	TMap<FName, FHibernatedCell> Cells;
+	TArray<TWeakObjectPtr<ASWPVehicle>> PendingRehydrations;
+};
@@ -2,14 +2,25 @@
 
 #pragma once
 
+#include "PhysicsInterfaceDeclaresCore.h"
+
 class SMOKINWHEELSPHX_API FSWPPhysicsUtility
 {
 public:
 	/**
-	 * Apply a world-space force at a world-space location on a rigid body.
-	 * - RigidHandle: Chaos rigid handle (PT-side, never dereference UObjects here).
-	 * - Location:    world-space point where the force is applied (e.g., contact/suspension mount).
-	 * - Force:       world-space force vector to apply.
+	 * Apply an already accumulated world-space force and torque (about the CoM) on a rigid body.
+	 * Used when several contributions (e.g., all wheels of a vehicle) are summed before applying.
 	 */
-	static void AddForceAtLocation(Chaos::FPBDRigidParticleHandle* RigidHandle, const FVector Location, const FVector Force);
+	static void AddForceAndTorque(Chaos::FPBDRigidParticleHandle* RigidHandle, const FVector Force, const FVector Torque);
+
+	/**
+	 * GT only. Create a dynamic box particle directly in the physics scene (no actor/component).
+	 * The box only takes part in simulation (query disabled) so wheel traces never hit it.
+	 * Returns nullptr on failure.
+	 */
+	static FPhysicsActorHandle CreateChassisParticle(FPhysScene* PhysScene, const FTransform& Transform,
+		const FVector& HalfExtents, float MassKg);
+
+	/** GT only. Remove and free a particle created with CreateChassisParticle(); resets Handle. */
+	static void ReleaseChassisParticle(FPhysScene* PhysScene, FPhysicsActorHandle& Handle);
 };
@@ -0,0 +1,67 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SWPPowertrainPreset.generated.h"
+
+class UCurveFloat;
+
+/**
+ * USWPPowertrainPreset
+ *
+ * Engine, gearbox, brakes and aero of a vehicle type (one asset per setup, shared by the
+ * whole fleet). Interned and uploaded to the PT once like suspension presets; the torque
+ * curve is baked into a fixed-size table, so the PT never touches the UCurveFloat.
+ * Drive torque goes to the wheels flagged bDriven (open differential: equal split).
+ */
+UCLASS(BlueprintType)
+class SMOKINWHEELSPHX_API USWPPowertrainPreset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Peak engine torque (Nm). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Engine", meta = (ClampMin = "0.0"))
+	float MaxTorque = 400.0f;
+	/** Optional torque curve. X: engine RPM [0, RedlineRPM], Y: fraction of MaxTorque (flat 1 when unset). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Engine")
+	TObjectPtr<UCurveFloat> TorqueCurve = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Engine", meta = (ClampMin = "0.0"))
+	float IdleRPM = 900.0f;
+	/** No drive torque above this RPM (rev limiter). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Engine", meta = (ClampMin = "1000.0"))
+	float RedlineRPM = 6500.0f;
+	/** Engine braking torque (Nm) off throttle at redline, scaling down linearly with RPM. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Engine", meta = (ClampMin = "0.0"))
+	float EngineBrakeTorque = 60.0f;
+
+	/** Forward gear ratios, first gear first (up to 8). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission")
+	TArray<float> GearRatios = { 3.6f, 2.2f, 1.5f, 1.1f, 0.9f };
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission", meta = (ClampMin = "0.0"))
+	float ReverseRatio = 3.3f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission", meta = (ClampMin = "0.0"))
+	float FinalDriveRatio = 3.7f;
+	/** Fraction of the engine torque reaching the wheels. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Efficiency = 0.9f;
+	/** Automatic gearbox thresholds (engine RPM). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission", meta = (ClampMin = "0.0"))
+	float UpshiftRPM = 5800.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Transmission", meta = (ClampMin = "0.0"))
+	float DownshiftRPM = 2500.0f;
+
+	/** Total brake force (N) at full brake, split evenly over all wheels. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Brakes", meta = (ClampMin = "0.0"))
+	float MaxBrakeForce = 15000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Aero", meta = (ClampMin = "0.0"))
+	float DragCoefficient = 0.32f;
+	/** Positive values push the chassis down (scales with forward speed squared). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Aero")
+	float DownforceCoefficient = 0.1f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Aero", meta = (ClampMin = "0.0"))
+	float FrontalAreaM2 = 2.2f;
+};
@@ -0,0 +1,65 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SWPRoadGraph.generated.h"
+
+class USplineComponent;
+
+/** One waypoint of the road graph, with the directed lanes leaving it. */
+USTRUCT(BlueprintType)
+struct SMOKINWHEELSPHX_API FSWPRoadNode
+{
+	GENERATED_BODY()
+
+	/** World location (cm). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Autopilot")
+	FVector Location = FVector::ZeroVector;
+
+	/** Speed limit (km/h) on the way to this node (0 = none). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Autopilot", meta = (ClampMin = "0.0"))
+	float SpeedLimitKmh = 0.0f;
+
+	/** Nodes reachable from this one (directed: add both ways for two-way roads). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Autopilot")
+	TArray<int32> Links;
+};
+
+/**
+ * USWPRoadGraph
+ *
+ * Waypoint graph driven by the PT autopilot (AI traffic). Uploaded once per physics scene
+ * (InstallInWorld() or FSWPAsyncPhysicsManager::SetRoadGraph()) as flat arrays; routes are
+ * planned and followed on the PT, so the GT only publishes destination changes. Splines are
+ * supported by sampling them into chains of nodes (AppendSpline).
+ */
+UCLASS(BlueprintType)
+class SMOKINWHEELSPHX_API USWPRoadGraph : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Autopilot")
+	TArray<FSWPRoadNode> Nodes;
+
+	/**
+	 * Sample Spline every SpacingCm into a chain of linked nodes (both ways unless bOneWay;
+	 * closed splines loop). Returns the index of the first node. Re-install to upload the change.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Autopilot")
+	int32 AppendSpline(const USplineComponent* Spline, float SpacingCm = 1000.0f, float SpeedLimitKmh = 0.0f, bool bOneWay = false);
+
+	/** Link two existing nodes (From -> To, and back unless bOneWay). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Autopilot")
+	void LinkNodes(int32 From, int32 To, bool bOneWay = false);
+
+	/** Closest node to Location (INDEX_NONE when the graph is empty). */
+	UFUNCTION(BlueprintPure, Category = "SmokinWheelsPhx|Autopilot")
+	int32 FindNearestNode(const FVector& Location) const;
+
+	/** Make this the road graph of World's physics scene (GT). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Autopilot")
+	void InstallInWorld(UWorld* World) const;
+};
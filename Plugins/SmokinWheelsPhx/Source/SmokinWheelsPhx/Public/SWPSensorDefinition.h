@@ -0,0 +1,61 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SWPSensorDefinition.generated.h"
+
+/**
+ * FSWPSensorDefinition
+ *
+ * Raycast sensor mounted on the chassis (range finder, lidar-like fan). Rays start at
+ * AttachLocal and fan out around its +X axis: NumRays across FieldOfView (yaw), times
+ * NumLayers across VerticalFieldOfView (pitch). Traced on the PT in a batched stage; the
+ * ranges come back in the vehicle's PT output (ASWPVehicle::GetSensorRanges()).
+ */
+USTRUCT(BlueprintType)
+struct SMOKINWHEELSPHX_API FSWPSensorDefinition
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxRaysPerLayer = 4096;
+	static constexpr int32 MaxLayers = 64;
+
+	/** Display name (e.g., "Front Radar"). Used by UI and debug only. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor")
+	FName Name = NAME_None;
+
+	/** Mount relative to the chassis; rays fan out around its +X axis. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor")
+	FTransform AttachLocal = FTransform::Identity;
+
+	/** Rays per layer, spread evenly across FieldOfView. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "1", ClampMax = "4096"))
+	int32 NumRays = 1;
+
+	/** Horizontal fan (degrees); 360 covers a full turn without duplicating the first ray. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "0.0", ClampMax = "360.0"))
+	float FieldOfView = 0.0f;
+
+	/** Stacked fans (lidar channels), spread evenly across VerticalFieldOfView. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 NumLayers = 1;
+
+	/** Vertical spread of the layers (degrees). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float VerticalFieldOfView = 0.0f;
+
+	/** Max ray length (cm). Ranges are reported in whole centimeters. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "1.0", ClampMax = "65000.0"))
+	float RangeCm = 10000.0f;
+
+	/** Scans per second (0 = every physics step). Sensors of a fleet are phase-shifted to spread the load. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Sensor", meta = (ClampMin = "0.0"))
+	float RateHz = 10.0f;
+
+	/** Number of ranges this sensor reports (rays per layer x layers). */
+	FORCEINLINE int32 GetNumRanges() const
+	{
+		return FMath::Clamp(NumRays, 1, MaxRaysPerLayer) * FMath::Clamp(NumLayers, 1, MaxLayers);
+	}
+};
@@ -0,0 +1,51 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "Engine/DataAsset.h"
+#include "SWPSurfaceTable.generated.h"
+
+/** Suspension/tire response on one surface type (multipliers on the wheel's tuning). */
+USTRUCT(BlueprintType)
+struct SMOKINWHEELSPHX_API FSWPSurfaceResponse
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Surface")
+	TEnumAsByte<EPhysicalSurface> Surface = SurfaceType_Default;
+
+	/** Scales the spring force (e.g., < 1 on loose gravel/sand). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Surface", meta = (ClampMin = "0.0"))
+	float StiffnessScale = 1.0f;
+
+	/** Scales bump and rebound damping. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Surface", meta = (ClampMin = "0.0"))
+	float DampingScale = 1.0f;
+
+	/** Scales tire friction (e.g., ~0.5 on wet grass, ~0.1 on ice). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Surface", meta = (ClampMin = "0.0"))
+	float FrictionScale = 1.0f;
+};
+
+/**
+ * USWPSurfaceTable
+ *
+ * Per-surface suspension multipliers, keyed by the project's physical surface types.
+ * Surfaces not listed keep 1.0. Installed per physics scene (InstallInWorld() or
+ * FSWPAsyncPhysicsManager::SetSurfaceTable()); the PT reads it as a flat array indexed by surface ID.
+ */
+UCLASS(BlueprintType)
+class SMOKINWHEELSPHX_API USWPSurfaceTable : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Surface", meta = (TitleProperty = "Surface"))
+	TArray<FSWPSurfaceResponse> Surfaces;
+
+	/** Make this the active surface table of World's physics scene (GT). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Surface")
+	void InstallInWorld(UWorld* World) const;
+};
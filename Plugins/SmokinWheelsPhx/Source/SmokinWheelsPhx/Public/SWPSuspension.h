@@ -6,41 +6,33 @@
 #include "Components/SceneComponent.h"
 #include "SWPSuspension.generated.h"
 
-UCLASS(ClassGroup = (SmokinWheelPhx))
+/**
+ * USWPSuspension (legacy)
+ *
+ * Per-wheel suspension component of vehicles saved before FSWPWheelDefinition. Only created in the
+ * editor, so Blueprints and levels holding the old FrontLeftSuspension..RearRightSuspension
+ * subobjects still load their placement and tuning; ASWPVehicle::PostLoad converts them into
+ * Wheels entries. Not used at runtime.
+ */
+UCLASS(ClassGroup = (SmokinWheelPhx), NotBlueprintable, HideDropdown)
 class SMOKINWHEELSPHX_API USWPSuspension : public USceneComponent
 {
 	GENERATED_BODY()
 
 public:
-	/** Max distance (cm) for the downward line trace from the TopLink. */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float TravelCm;
-	/** Spring constant (stiffness) for Hooke's law. */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float SpringStiffness;
-	/** Damping coefficient when the spring is compressing (bump). */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float ShockBump;
-	/** Damping coefficient when the spring is extending (rebound). */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float ShockRebound;
-	/** Absolute cap on the force produced by this suspension (safety against spikes). */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float MaxForce;
-
-	/**
-	 * Visual/physical wheel radius (cm).
-	 * Added to TravelCm to build the trace length so wheel visuals remain decoupled
-	 * from suspension travel.
-	 */
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	UPROPERTY()
 	float WheelRadiusCm;
 
 public:
 	USWPSuspension();
-	// Tick unused here. All physics happens in PT.
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
-							   FActorComponentTickFunction* ThisTickFunction) override;
-protected:
-	virtual void BeginPlay() override;
 };
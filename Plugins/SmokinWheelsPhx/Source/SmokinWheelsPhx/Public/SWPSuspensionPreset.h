@@ -0,0 +1,69 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SWPSuspensionPreset.generated.h"
+
+class UCurveFloat;
+
+/**
+ * USWPSuspensionPreset
+ *
+ * Shared suspension tuning (one asset per setup, e.g., "Sedan Soft", "Truck Heavy").
+ * Wheels referencing a preset are sent to the PT as an index into a preset table uploaded
+ * once, instead of carrying their own copy of every tuning value. Curves are baked into
+ * fixed-size lookup tables at that point (the PT never touches the UCurveFloat assets).
+ */
+UCLASS(BlueprintType)
+class SMOKINWHEELSPHX_API USWPSuspensionPreset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Max distance (cm) for the downward line trace from the TopLink. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float TravelCm = 80.0f;
+	/** Spring constant (stiffness) for Hooke's law. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float SpringStiffness = 35000.0f;
+	/** Damping coefficient when the spring is compressing (bump). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float ShockBump = 4300.0f;
+	/** Damping coefficient when the spring is extending (rebound). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float ShockRebound = 3000.0f;
+	/** Absolute cap on the force produced by this suspension (safety against spikes). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float MaxForce = 7500.0f;
+	/** Visual/physical wheel radius (cm), added to TravelCm to build the trace length. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension")
+	float WheelRadiusCm = 30.0f;
+
+	/**
+	 * Optional progressive spring rate. X: compression ratio [0,1], Y: force as a fraction of
+	 * SpringStiffness (linear when unset: Y = X). Author bump stops as a steep rise near X = 1.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> SpringCurve = nullptr;
+	/** Optional bump damper curve. X: compression speed (ratio/s), Y: value multiplied by ShockBump (linear when unset). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> BumpCurve = nullptr;
+	/** Optional rebound damper curve. X: extension speed (ratio/s), Y: value multiplied by ShockRebound (linear when unset). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> ReboundCurve = nullptr;
+	/** Damper curves are sampled over [0, DamperCurveMaxSpeed]; faster motion extrapolates the last segment. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Suspension|Curves", meta = (ClampMin = "0.1"))
+	float DamperCurveMaxSpeed = 10.0f;
+
+	/** Tire/road friction coefficient (peak force = TireFriction * load, before the surface multiplier). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireFriction = 1.0f;
+	/** Cornering stiffness per unit load (1/rad): lateral force slope at small slip angles. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireCorneringStiffness = 12.0f;
+	/** Rolling resistance coefficient (fraction of the load opposing the rolling direction). */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireRollingResistance = 0.015f;
+};
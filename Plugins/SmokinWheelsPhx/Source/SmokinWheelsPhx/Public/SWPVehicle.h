@@ -4,8 +4,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "SWPContactMode.h"
+#include "SWPPowertrainPreset.h"
+#include "SWPSensorDefinition.h"
+#include "SWPWheelDefinition.h"
 #include "SWPVehicle.generated.h"
 
+class FSWPAsyncPhysicsManager;
 class USWPSuspension;
 
 UCLASS(Blueprintable)
@@ -15,7 +20,6 @@ class SMOKINWHEELSPHX_API ASWPVehicle : public APawn
 
 public:
 	ASWPVehicle();
-	virtual void Tick(float DeltaTime) override;
 
 	FORCEINLINE FGuid GetGuid() const { return Guid; }
 	FORCEINLINE const FBodyInstance* GetBodyInstance() const
@@ -25,20 +29,106 @@ public:
 		else
 			return  nullptr;
 	}
-		
-	FORCEINLINE USWPSuspension* GetFrontLeftSuspension() const { return FrontLeftSuspension; }
-	FORCEINLINE USWPSuspension* GetFrontRightSuspension() const { return FrontRightSuspension; }
-	FORCEINLINE USWPSuspension* GetRearLeftSuspension() const { return RearLeftSuspension; }
-	FORCEINLINE USWPSuspension* GetRearRightSuspension() const { return RearRightSuspension; }
+
+	FORCEINLINE int32 GetNumWheels() const { return Wheels.Num(); }
+	FORCEINLINE const TArray<FSWPWheelDefinition>& GetWheels() const { return Wheels; }
+	FORCEINLINE FSWPWheelDefinition* GetMutableWheel(int32 Index)
+	{
+		return Wheels.IsValidIndex(Index) ? &Wheels[Index] : nullptr;
+	}
+	/** Call after editing wheels (GetMutableWheel) so the PT config is re-sampled. */
+	void NotifyWheelsChanged();
+	/**
+	 * Switch wheels to a shared tuning preset at runtime (WheelIndex INDEX_NONE = every wheel).
+	 * Passing nullptr keeps the wheel's current values as a private copy.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Wheels")
+	void SetWheelPreset(int32 WheelIndex, USWPSuspensionPreset* Preset);
+
+	FORCEINLINE ESWPContactMode GetContactMode() const { return ContactMode; }
+	/** Change the ground query fidelity at runtime (e.g., Sweep for the player, Ray for traffic). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Wheels")
+	void SetContactMode(ESWPContactMode InContactMode);
+
+	FORCEINLINE const USWPPowertrainPreset* GetPowertrain() const { return Powertrain; }
+	/** Swap engine/gearbox/aero at runtime (nullptr: no drive, no aero). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Powertrain")
+	void SetPowertrain(USWPPowertrainPreset* InPowertrain);
+
+	FORCEINLINE const TArray<FSWPSensorDefinition>& GetSensors() const { return Sensors; }
+	/** Replace the raycast sensors at runtime (empty: none). */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Sensors")
+	void SetSensors(const TArray<FSWPSensorDefinition>& InSensors);
+	/**
+	 * Latest ranges (cm) of one sensor from the PT output, layer by layer, -1 where a ray hit
+	 * nothing. False when the sensor or its output is not available (yet).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Sensors")
+	bool GetSensorRanges(int32 SensorIndex, TArray<float>& OutRangesCm) const;
+
+	/**
+	 * Driver inputs: Throttle [-1, 1] (negative reverses when stopped, brakes otherwise),
+	 * Steering [-1, 1] (positive right), Brake [0, 1]. Sent to the PT only when they change.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Controls")
+	void SetControls(float Throttle, float Steering, float Brake);
+
+	/**
+	 * AI driving on the PT: route to DestinationNode of the installed USWPRoadGraph at up to
+	 * CruiseSpeedKmh. Overrides SetControls() while engaged; INDEX_NONE hands control back.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Controls")
+	void SetAutopilotDestination(int32 DestinationNode, float CruiseSpeedKmh = 50.0f);
+
+	/**
+	 * Trajectory preview: where this vehicle would be after NumSteps physics steps under the given
+	 * inputs (frozen ground, no other bodies), one pose every SampleEvery steps. The live vehicle is
+	 * not affected. Returns the ID to poll with GetPrediction(), INDEX_NONE when not registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Prediction")
+	int32 RequestPrediction(float Throttle, float Steering, float Brake, int32 NumSteps = 60, int32 SampleEvery = 6);
+	/** Claims a finished prediction (chassis poses, oldest first). False while it is still in flight. */
+	UFUNCTION(BlueprintCallable, Category = "SmokinWheelsPhx|Prediction")
+	bool GetPrediction(int32 RequestId, TArray<FTransform>& OutPoses);
+
+	/**
+	 * Pooling (GT). A pooled vehicle stays registered (PT slot kept) but is parked:
+	 * physics and collision off, hidden, and skipped by the PT step.
+	 */
+	void DeactivateToPool(const FVector& ParkLocation);
+	/** Un-park at Transform under a fresh GUID; PT state is reset in place (no object/body/slot churn). */
+	void ActivateFromPool(const FTransform& Transform);
+	FORCEINLINE bool IsPooled() const { return bPooled; }
+
+	/**
+	 * Streaming (see USWPHibernationSubsystem). A vehicle streamed back in with a hibernation record is
+	 * parked (unregistered, no physics/collision, hidden) until the subsystem wakes it at its recorded pose
+	 * (Controls: the recorded ones, restored on the PT with the rest of the record).
+	 */
+	void WakeFromHibernation(const FTransform& Transform, const FVector& LinearVelocity, const FVector& AngularVelocity, const FVector3f& Controls);
+	FORCEINLINE bool IsHibernated() const { return bHibernated; }
+
+	/** Slot in the physics manager's registry (INDEX_NONE when unregistered). Set by the manager. */
+	FORCEINLINE int32 GetRegistryIndex() const { return RegistryIndex; }
+	FORCEINLINE void SetRegistryIndex(const int32 InRegistryIndex) { RegistryIndex = InRegistryIndex; }
 	
 	// virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	FGuid Guid;
+	int32 RegistryIndex = INDEX_NONE;
+
+	bool bPooled = false;
+	bool bHibernated = false;
+	FVector3f LastControls = FVector3f::ZeroVector;		// Throttle, steering, brake last sent.
+	ECollisionEnabled::Type PooledCollisionEnabled = ECollisionEnabled::QueryAndPhysics;		// Restored when un-parked (pool or hibernation).
 
 	UPROPERTY(EditDefaultsOnly, Category = "SmokinWheelsPhx|Chassis")
 	float VehicleMass;
@@ -47,16 +137,36 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "SmokinWheelsPhx|Components")
 	TObjectPtr<UStaticMeshComponent> BodyMeshComponent;	
 	
-	/** Front-left suspension component. */
-	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "SmokinWheelsPhx|Components")
-	TObjectPtr<USWPSuspension> FrontLeftSuspension;
-	/** Front-right suspension component. */
-	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "SmokinWheelsPhx|Components")
-	TObjectPtr<USWPSuspension> FrontRightSuspension;
-	/** Rear-left suspension component. */
-	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "SmokinWheelsPhx|Components")
-	TObjectPtr<USWPSuspension> RearLeftSuspension;
-	/** Rear-right suspension component. */
-	UPROPERTY(VisibleAnywhere, AdvancedDisplay, Category = "SmokinWheelsPhx|Components")
-	TObjectPtr<USWPSuspension> RearRightSuspension;
+	/**
+	 * Wheel/suspension definitions (one entry per wheel, any count).
+	 * Order is preserved GT → PT; keep left/right pairs adjacent per axle for readable UI.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "SmokinWheelsPhx|Wheels", meta = (TitleProperty = "Name"))
+	TArray<FSWPWheelDefinition> Wheels;
+
+	/** How the wheels query the ground (cost/fidelity trade-off, see ESWPContactMode). */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Wheels")
+	ESWPContactMode ContactMode = ESWPContactMode::Ray;
+
+	/** Engine, gearbox, brakes and aero. Drive torque goes to the wheels flagged bDriven. */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Powertrain")
+	TObjectPtr<USWPPowertrainPreset> Powertrain = nullptr;
+
+	/** Raycast sensors (range finders, lidar fans) traced on the PT at their own rate. */
+	UPROPERTY(EditAnywhere, Category = "SmokinWheelsPhx|Sensors", meta = (TitleProperty = "Name"))
+	TArray<FSWPSensorDefinition> Sensors;
+
+#if WITH_EDITORONLY_DATA
+	/** Pre-FSWPWheelDefinition suspension components (FL, FR, RL, RR), loaded only to be converted into Wheels. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USWPSuspension>> LegacySuspensions;
+#endif
+
+private:
+	FSWPAsyncPhysicsManager* GetPhysicsManager() const;
+	void EnterSimulation();
+
+	/** A recreated body is a new Chaos particle: re-send the packet so the PT binds the new index. */
+	UFUNCTION()
+	void OnBodyPhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
 };
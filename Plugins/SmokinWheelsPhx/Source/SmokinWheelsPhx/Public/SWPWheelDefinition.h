@@ -0,0 +1,137 @@
+// Copyright (c) [2025] [Federico Grenoville]
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SWPSuspensionPreset.h"
+#include "SWPWheelDefinition.generated.h"
+
+class UCurveFloat;
+
+/**
+ * FSWPWheelDefinition
+ *
+ * Plain data description of one wheel/suspension corner. Vehicles own an array of these
+ * (one entry per wheel) instead of one scene component per wheel, so adding axles only
+ * grows a contiguous array and never creates extra UObjects.
+ *
+ * Tuning comes from Preset when set (shared by every wheel using it), otherwise from the
+ * inline values below. Runtime edits go through DetachPreset() first (copy-on-write).
+ */
+USTRUCT(BlueprintType)
+struct SMOKINWHEELSPHX_API FSWPWheelDefinition
+{
+	GENERATED_BODY()
+
+	/** Display name (e.g., "Front Left"). Used by UI and debug only. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Wheel")
+	FName Name = NAME_None;
+
+	/** Suspension mount (TopLink) relative to the chassis. The trace runs along its -Z axis. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Wheel")
+	FTransform AttachLocal = FTransform::Identity;
+
+	/** Receives drive torque from the vehicle's powertrain (split evenly over the driven wheels). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Wheel")
+	bool bDriven = false;
+
+	/**
+	 * Steering angle (degrees) at full steering input; 0 for a fixed wheel, negative for counter-steering rear wheels.
+	 * Whole degrees: the wheel packet stores it in one byte, fractions are rounded (and reported).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Wheel", meta = (ClampMin = "-90.0", ClampMax = "90.0", Delta = "1.0"))
+	float MaxSteerAngle = 0.0f;
+
+	/** Shared tuning. When set, the inline suspension values below are ignored. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	TObjectPtr<USWPSuspensionPreset> Preset = nullptr;
+
+	/** Max distance (cm) for the downward line trace from the TopLink. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float TravelCm = 80.0f;
+	/** Spring constant (stiffness) for Hooke's law. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float SpringStiffness = 35000.0f;
+	/** Damping coefficient when the spring is compressing (bump). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float ShockBump = 4300.0f;
+	/** Damping coefficient when the spring is extending (rebound). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float ShockRebound = 3000.0f;
+	/** Absolute cap on the force produced by this suspension (safety against spikes). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float MaxForce = 7500.0f;
+
+	/**
+	 * Visual/physical wheel radius (cm).
+	 * Added to TravelCm to build the trace length so wheel visuals remain decoupled
+	 * from suspension travel.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension")
+	float WheelRadiusCm = 30.0f;
+
+	/**
+	 * Optional progressive spring rate. X: compression ratio [0,1], Y: force as a fraction of
+	 * SpringStiffness (linear when unset: Y = X). Author bump stops as a steep rise near X = 1.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> SpringCurve = nullptr;
+	/** Optional bump damper curve. X: compression speed (ratio/s), Y: value multiplied by ShockBump (linear when unset). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> BumpCurve = nullptr;
+	/** Optional rebound damper curve. X: extension speed (ratio/s), Y: value multiplied by ShockRebound (linear when unset). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension|Curves")
+	TObjectPtr<UCurveFloat> ReboundCurve = nullptr;
+	/** Damper curves are sampled over [0, DamperCurveMaxSpeed]; faster motion extrapolates the last segment. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Suspension|Curves", meta = (ClampMin = "0.1"))
+	float DamperCurveMaxSpeed = 10.0f;
+
+	/** Tire/road friction coefficient (peak force = TireFriction * load, before the surface multiplier). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireFriction = 1.0f;
+	/** Cornering stiffness per unit load (1/rad): lateral force slope at small slip angles. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireCorneringStiffness = 12.0f;
+	/** Rolling resistance coefficient (fraction of the load opposing the rolling direction). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmokinWheelsPhx|Tire", meta = (ClampMin = "0.0"))
+	float TireRollingResistance = 0.015f;
+
+	FSWPWheelDefinition() = default;
+	FSWPWheelDefinition(const FName InName, const FVector& InLocation)
+		: Name(InName), AttachLocal(FTransform(InLocation))
+	{
+	}
+
+	/** Copy with the preset's values baked into the inline fields (Preset cleared). */
+	FSWPWheelDefinition Resolve() const
+	{
+		FSWPWheelDefinition Resolved = *this;
+		if (Preset)
+		{
+			Resolved.TravelCm = Preset->TravelCm;
+			Resolved.SpringStiffness = Preset->SpringStiffness;
+			Resolved.ShockBump = Preset->ShockBump;
+			Resolved.ShockRebound = Preset->ShockRebound;
+			Resolved.MaxForce = Preset->MaxForce;
+			Resolved.WheelRadiusCm = Preset->WheelRadiusCm;
+			Resolved.SpringCurve = Preset->SpringCurve;
+			Resolved.BumpCurve = Preset->BumpCurve;
+			Resolved.ReboundCurve = Preset->ReboundCurve;
+			Resolved.DamperCurveMaxSpeed = Preset->DamperCurveMaxSpeed;
+			Resolved.TireFriction = Preset->TireFriction;
+			Resolved.TireCorneringStiffness = Preset->TireCorneringStiffness;
+			Resolved.TireRollingResistance = Preset->TireRollingResistance;
+			Resolved.Preset = nullptr;
+		}
+		return Resolved;
+	}
+
+	/** Copy-on-write: take a private copy of the preset values before editing this wheel. */
+	void DetachPreset()
+	{
+		if (Preset)
+		{
+			*this = Resolve();
+		}
+	}
+};
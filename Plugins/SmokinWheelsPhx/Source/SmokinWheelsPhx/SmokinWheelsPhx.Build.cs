@@ -26,6 +26,9 @@ public class SmokinWheelsPhx : ModuleRules
 			new string[]
 			{
 				"Core",
+				// Mass types appear in the public Mass/ headers (fragments, trait, processors).
+				"MassEntity",
+				"MassSpawner",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -36,11 +39,13 @@ public class SmokinWheelsPhx : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"PhysicsCore",
 				"Slate",
 				"SlateCore",
 				"Chaos",
 				"ChaosCore",
 				"ChaosSolverEngine",
+				"MassCommon",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
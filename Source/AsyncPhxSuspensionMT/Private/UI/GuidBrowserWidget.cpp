@@ -19,6 +19,8 @@ void UGuidBrowserWidget::NativeConstruct()
 	{
 		VehicleManager->OnVehicleSpawned.AddDynamic(this, &UGuidBrowserWidget::HandleVehicleSpawned);
 		VehicleManager->OnVehicleRemoved.AddDynamic(this, &UGuidBrowserWidget::HandleVehicleRemoved);
+		VehicleManager->OnVehiclesSpawned.AddDynamic(this, &UGuidBrowserWidget::HandleVehiclesSpawned);
+		VehicleManager->OnVehiclesRemoved.AddDynamic(this, &UGuidBrowserWidget::HandleVehiclesRemoved);
 	}
 	
 	if (GuidList)
@@ -34,6 +36,8 @@ void UGuidBrowserWidget::NativeDestruct()
 	{
 		VehicleManager->OnVehicleSpawned.RemoveAll(this);
 		VehicleManager->OnVehicleRemoved.RemoveAll(this);
+		VehicleManager->OnVehiclesSpawned.RemoveAll(this);
+		VehicleManager->OnVehiclesRemoved.RemoveAll(this);
 	}
 	
 	if (GuidList)
@@ -68,6 +72,24 @@ void UGuidBrowserWidget::HandleVehicleRemoved(const FGuid VehicleId)
 	}
 }
 
+// Batched variants: the list view refreshes once (deferred) for the whole batch.
+void UGuidBrowserWidget::HandleVehiclesSpawned(const TArray<FGuid>& VehicleIds)
+{
+	ItemsById.Reserve(ItemsById.Num() + VehicleIds.Num());
+	for (const FGuid& VehicleId : VehicleIds)
+	{
+		HandleVehicleSpawned(VehicleId);
+	}
+}
+
+void UGuidBrowserWidget::HandleVehiclesRemoved(const TArray<FGuid>& VehicleIds)
+{
+	for (const FGuid& VehicleId : VehicleIds)
+	{
+		HandleVehicleRemoved(VehicleId);
+	}
+}
+
 void UGuidBrowserWidget::HandleEntryGenerated(UUserWidget& EntryWidget)
 {
 	if (auto* Row = Cast<UGuidItemWidget>(&EntryWidget))
@@ -1,7 +1,7 @@
 // Copyright (c) [2025] [Federico Grenoville]
 
 #include "UI/SuspensionWidget.h"
-#include "SWPSuspension.h"
+#include "SWPVehicle.h"
 #include "Components/TextBlock.h"
 
 void USuspensionWidget::SetWidgetName(FText Label)
@@ -9,36 +9,70 @@ void USuspensionWidget::SetWidgetName(FText Label)
 	if (WidgetName) WidgetName->SetText(Label);
 }
 
-void USuspensionWidget::ReconfigureWidget(USWPSuspension* NewSuspension)
+void USuspensionWidget::ReconfigureWidget(ASWPVehicle* NewVehicle, int32 NewWheelIndex)
 {
-	Suspension = NewSuspension;
+	// Edits of the previous wheel are not lost when the widget is rebound mid-drag.
+	CommitWheelEdit();
+	bDragging = false;
+
+	Vehicle = NewVehicle;
+	WheelIndex = NewWheelIndex;
 	
 	if (!IsValid(TravelSlider) || !IsValid(SpringStiffnessSlider) || !IsValid(ShockBumpSlider) || !IsValid(ShockReboundSlider)
 	|| !IsValid(MaxForceSlider) || !IsValid(WheelRadiusSlider))
 		return;
 	
-	if (Suspension.IsValid())
+	if (const FSWPWheelDefinition* EditedWheel = GetWheel())
 	{
+		// Show the effective values (preset ones when the wheel still shares a preset).
+		const FSWPWheelDefinition Resolved = EditedWheel->Resolve();
+		const FSWPWheelDefinition* Wheel = &Resolved;
+
 		bUpdatingFromCode = true;
 		
-		InitSlider(TravelSlider, TravelCmMin, TravelCmMax, TravelCmStep, Suspension->TravelCm);
-		InitSlider(SpringStiffnessSlider, SpringStiffnessMin, SpringStiffnessMax, SpringStiffnessStep, Suspension->SpringStiffness);
-		InitSlider(ShockBumpSlider, ShockBumpMin, ShockBumpMax,	ShockBumpStep, Suspension->ShockBump);
-		InitSlider(ShockReboundSlider, ShockReboundMin, ShockReboundMax, ShockReboundStep, Suspension->ShockRebound);
-		InitSlider(MaxForceSlider, MaxForceMin, MaxForceMax, MaxForceStep, Suspension->MaxForce);
-		InitSlider(WheelRadiusSlider, WheelRadiusCmMin, WheelRadiusCmMax, WheelRadiusCmStep, Suspension->WheelRadiusCm);
-
-		UpdateText(TravelValue, Suspension->TravelCm);
-		UpdateText(SpringStiffnessValue, Suspension->SpringStiffness);
-		UpdateText(ShockBumpValue, Suspension->ShockBump);
-		UpdateText(ShockReboundValue, Suspension->ShockRebound);
-		UpdateText(MaxForceValue, Suspension->MaxForce);
-		UpdateText(WheelRadiusValue, Suspension->WheelRadiusCm);
+		InitSlider(TravelSlider, TravelCmMin, TravelCmMax, TravelCmStep, Wheel->TravelCm);
+		InitSlider(SpringStiffnessSlider, SpringStiffnessMin, SpringStiffnessMax, SpringStiffnessStep, Wheel->SpringStiffness);
+		InitSlider(ShockBumpSlider, ShockBumpMin, ShockBumpMax,	ShockBumpStep, Wheel->ShockBump);
+		InitSlider(ShockReboundSlider, ShockReboundMin, ShockReboundMax, ShockReboundStep, Wheel->ShockRebound);
+		InitSlider(MaxForceSlider, MaxForceMin, MaxForceMax, MaxForceStep, Wheel->MaxForce);
+		InitSlider(WheelRadiusSlider, WheelRadiusCmMin, WheelRadiusCmMax, WheelRadiusCmStep, Wheel->WheelRadiusCm);
+
+		UpdateText(TravelValue, Wheel->TravelCm);
+		UpdateText(SpringStiffnessValue, Wheel->SpringStiffness);
+		UpdateText(ShockBumpValue, Wheel->ShockBump);
+		UpdateText(ShockReboundValue, Wheel->ShockRebound);
+		UpdateText(MaxForceValue, Wheel->MaxForce);
+		UpdateText(WheelRadiusValue, Wheel->WheelRadiusCm);
 
 		bUpdatingFromCode = false;
 	}
 }
 
+FSWPWheelDefinition* USuspensionWidget::GetWheel() const
+{
+	return Vehicle.IsValid() ? Vehicle->GetMutableWheel(WheelIndex) : nullptr;
+}
+
+void USuspensionWidget::CommitWheelEdit()
+{
+	if (!bPendingCommit) return;
+	bPendingCommit = false;
+
+	if (Vehicle.IsValid())
+		Vehicle->NotifyWheelsChanged();
+}
+
+void USuspensionWidget::OnSliderCaptureBegin()
+{
+	bDragging = true;
+}
+
+void USuspensionWidget::OnSliderCaptureEnd()
+{
+	bDragging = false;
+	CommitWheelEdit();
+}
+
 void USuspensionWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
@@ -49,10 +83,31 @@ void USuspensionWidget::NativeConstruct()
 	ShockReboundSlider->OnValueChanged.AddDynamic(this, &USuspensionWidget::OnShockReboundValueChanged);
 	MaxForceSlider->OnValueChanged.AddDynamic(this, &USuspensionWidget::OnMaxForceValueChanged);
 	WheelRadiusSlider->OnValueChanged.AddDynamic(this, &USuspensionWidget::OnWheelRadiusValueChanged);
+
+	for (USlider* Slider : { TravelSlider, SpringStiffnessSlider, ShockBumpSlider, ShockReboundSlider, MaxForceSlider, WheelRadiusSlider })
+	{
+		Slider->OnMouseCaptureBegin.AddDynamic(this, &USuspensionWidget::OnSliderCaptureBegin);
+		Slider->OnControllerCaptureBegin.AddDynamic(this, &USuspensionWidget::OnSliderCaptureBegin);
+		Slider->OnMouseCaptureEnd.AddDynamic(this, &USuspensionWidget::OnSliderCaptureEnd);
+		Slider->OnControllerCaptureEnd.AddDynamic(this, &USuspensionWidget::OnSliderCaptureEnd);
+	}
 }
 
 void USuspensionWidget::NativeDestruct()
 {
+	CommitWheelEdit();
+
+	for (USlider* Slider : { TravelSlider, SpringStiffnessSlider, ShockBumpSlider, ShockReboundSlider, MaxForceSlider, WheelRadiusSlider })
+	{
+		if (IsValid(Slider))
+		{
+			Slider->OnMouseCaptureBegin.RemoveAll(this);
+			Slider->OnControllerCaptureBegin.RemoveAll(this);
+			Slider->OnMouseCaptureEnd.RemoveAll(this);
+			Slider->OnControllerCaptureEnd.RemoveAll(this);
+		}
+	}
+
 	if (IsValid(TravelSlider)) 
 		TravelSlider->OnValueChanged.RemoveAll(this);
 
@@ -97,53 +152,53 @@ void USuspensionWidget::UpdateText(UTextBlock* Text, float Value, int32 Decimals
 void USuspensionWidget::OnTravelValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 	
-	ApplySliderChange(Suspension, &USWPSuspension::TravelCm,
+	ApplySliderChange(&FSWPWheelDefinition::TravelCm,
 					  TravelSlider, TravelValue, NewValue, TravelCmMin, TravelCmMax, TravelCmStep, 0);
 }
 
 void USuspensionWidget::OnSpringStiffnessValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 
-	ApplySliderChange(Suspension, &USWPSuspension::SpringStiffness, SpringStiffnessSlider, SpringStiffnessValue,
+	ApplySliderChange(&FSWPWheelDefinition::SpringStiffness, SpringStiffnessSlider, SpringStiffnessValue,
 					  NewValue, SpringStiffnessMin, SpringStiffnessMax, SpringStiffnessStep, 0);
 }
 
 void USuspensionWidget::OnShockBumpValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 
-	ApplySliderChange(Suspension, &USWPSuspension::ShockBump, ShockBumpSlider, ShockBumpValue,
+	ApplySliderChange(&FSWPWheelDefinition::ShockBump, ShockBumpSlider, ShockBumpValue,
 					  NewValue, ShockBumpMin, ShockBumpMax, ShockBumpStep, 0);
 }
 
 void USuspensionWidget::OnShockReboundValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 
-	ApplySliderChange(Suspension, &USWPSuspension::ShockRebound, ShockReboundSlider, ShockReboundValue,
+	ApplySliderChange(&FSWPWheelDefinition::ShockRebound, ShockReboundSlider, ShockReboundValue,
 					  NewValue, ShockReboundMin, ShockReboundMax, ShockReboundStep, 0);
 }
 
 void USuspensionWidget::OnMaxForceValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 
-	ApplySliderChange(Suspension, &USWPSuspension::MaxForce, MaxForceSlider, MaxForceValue,
+	ApplySliderChange(&FSWPWheelDefinition::MaxForce, MaxForceSlider, MaxForceValue,
 					  NewValue, MaxForceMin, MaxForceMax, MaxForceStep, 0);
 }
 
 void USuspensionWidget::OnWheelRadiusValueChanged(float NewValue)
 {
 	if (bUpdatingFromCode) return;
-	if (!Suspension.IsValid()) return;
+	if (!Vehicle.IsValid()) return;
 
-	ApplySliderChange(Suspension, &USWPSuspension::WheelRadiusCm, WheelRadiusSlider, WheelRadiusValue,
+	ApplySliderChange(&FSWPWheelDefinition::WheelRadiusCm, WheelRadiusSlider, WheelRadiusValue,
 					  NewValue, WheelRadiusCmMin, WheelRadiusCmMax, WheelRadiusCmStep, 0);
 }
@@ -24,14 +24,13 @@ void UVehicleSettingsWidget::NativeConstruct()
 
 	if (!Grid) return;
 	Grid->ClearChildren();
-	
-	FrontLeftSuspensionWidget = AddWidget(FText::FromString(TEXT("Front Left Suspension")), 0, 0);
-	FrontRightSuspensionWidget = AddWidget(FText::FromString(TEXT("Front Right Suspension")), 0, 1);
-	RearLeftSuspensionWidget = AddWidget(FText::FromString(TEXT("Rear Left Suspension")), 1, 0);
-	RearRightSuspensionWidget = AddWidget(FText::FromString(TEXT("Rear Right Suspension")), 1, 1);
+	SuspensionWidgets.Reset();
 
 	if (VehicleManager.IsValid())
+	{
 		VehicleManager->OnVehicleRemoved.AddDynamic(this, &ThisClass::HandleVehicleRemoved);
+		VehicleManager->OnVehiclesRemoved.AddDynamic(this, &ThisClass::HandleVehiclesRemoved);
+	}
 	
 	if (PlayerController.IsValid())
 		PlayerController->OnSelectedVehicleChanged.AddUniqueDynamic(this, &ThisClass::HandleSelectedVehicle);
@@ -42,7 +41,10 @@ void UVehicleSettingsWidget::NativeConstruct()
 void UVehicleSettingsWidget::NativeDestruct()
 {
 	if (VehicleManager.IsValid())
+	{
 		VehicleManager->OnVehicleRemoved.RemoveAll(this);
+		VehicleManager->OnVehiclesRemoved.RemoveAll(this);
+	}
 	
 	
 	if (PlayerController.IsValid())
@@ -70,6 +72,21 @@ USuspensionWidget* UVehicleSettingsWidget::AddWidget(const FText& Label, int32 R
 	return Widget;
 }
 
+// Lays out one suspension widget per wheel, two per row (left/right of each axle).
+void UVehicleSettingsWidget::RebuildSuspensionWidgets(int32 NumWheels)
+{
+	if (!Grid) return;
+	if (SuspensionWidgets.Num() == NumWheels) return;
+
+	Grid->ClearChildren();
+	SuspensionWidgets.Reset(NumWheels);
+
+	for (int32 i = 0; i < NumWheels; ++i)
+	{
+		SuspensionWidgets.Add(AddWidget(FText::GetEmpty(), i / 2, i % 2));
+	}
+}
+
 void UVehicleSettingsWidget::HandleSelectedVehicle(ASWPVehicle* NewVehicle)
 {
 	if (IsValid(NewVehicle))
@@ -77,10 +94,17 @@ void UVehicleSettingsWidget::HandleSelectedVehicle(ASWPVehicle* NewVehicle)
 		SelectedVehicle = NewVehicle;
 		SelectedVehicleId = SelectedVehicle->GetGuid();
 		
-		FrontLeftSuspensionWidget->ReconfigureWidget(SelectedVehicle->GetFrontLeftSuspension());
-		FrontRightSuspensionWidget->ReconfigureWidget(SelectedVehicle->GetFrontRightSuspension());
-		RearLeftSuspensionWidget->ReconfigureWidget(SelectedVehicle->GetRearLeftSuspension());
-		RearRightSuspensionWidget->ReconfigureWidget(SelectedVehicle->GetRearRightSuspension());
+		const TArray<FSWPWheelDefinition>& Wheels = SelectedVehicle->GetWheels();
+		RebuildSuspensionWidgets(Wheels.Num());
+
+		for (int32 i = 0; i < SuspensionWidgets.Num(); ++i)
+		{
+			if (USuspensionWidget* Widget = SuspensionWidgets[i])
+			{
+				Widget->SetWidgetName(FText::FromName(Wheels[i].Name));
+				Widget->ReconfigureWidget(SelectedVehicle.Get(), i);
+			}
+		}
 
 		Grid->SetVisibility(ESlateVisibility::Visible);
 	}
@@ -98,3 +122,11 @@ void UVehicleSettingsWidget::HandleVehicleRemoved(const FGuid VehicleId)
 		Grid->SetVisibility(ESlateVisibility::Collapsed);
 	}
 }
+
+void UVehicleSettingsWidget::HandleVehiclesRemoved(const TArray<FGuid>& VehicleIds)
+{
+	if (VehicleIds.Contains(SelectedVehicleId))
+	{
+		HandleVehicleRemoved(SelectedVehicleId);
+	}
+}
@@ -4,12 +4,15 @@
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
 #include "NiagaraFunctionLibrary.h"
+#include "SWPSurfaceTable.h"
 #include "SWPVehicle.h"
 #include "Kismet/GameplayStatics.h"
 
 AVehicleManager::AVehicleManager()
 {
-	PrimaryActorTick.bCanEverTick = false;		// Manager does not need per-frame Tick by default.
+	// Tick only runs while removal FX are queued (see QueueRemovalFX).
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Grid spawn defaults
 	SpawnNumMaxRows = 5;
@@ -20,6 +23,14 @@ AVehicleManager::AVehicleManager()
 
 	VehicleDeathFX = nullptr;
 	ScaleFactorFX = FVector::OneVector;
+	MaxRemovalFXPerFrame = 4;
+	RemovalFXMergeCellSize = 1500.0f;
+
+	// Pool defaults
+	VehiclePoolPrewarmCount = 16;
+	VehiclePoolParkLocation = FVector(0.0f, 0.0f, -100000.0f);
+
+	SurfaceTable = nullptr;
 }
 
 void AVehicleManager::BeginPlay()
@@ -31,32 +42,42 @@ void AVehicleManager::BeginPlay()
 
 	// Pre-warm a small Niagara pool so the first death FX does not hitch on allocation.
 	PrimeNiagaraPool(VehicleDeathFX, 4);
+
+	// Same idea for vehicles: pay actor/body construction up front, reuse afterward.
+	PrimeVehiclePool(VehiclePoolPrewarmCount);
+
+	// Surface-dependent suspension response (PT reads it as a flat table).
+	if (SurfaceTable)
+		SurfaceTable->InstallInWorld(GetWorld());
 }
 
 void AVehicleManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Note: tick is unused here.
+	// Drain queued removal FX under the per-frame budget. An emitted cell takes new removals again.
+	const int32 NumToPlay = FMath::Min(PendingRemovalFX.Num(), FMath::Max(MaxRemovalFXPerFrame, 1));
+	for (int32 i = 0; i < NumToPlay; ++i)
+	{
+		PlayRemovalFX(PendingRemovalFX[i].Value);
+		PendingRemovalFXCells.Remove(PendingRemovalFX[i].Key);
+	}
+	PendingRemovalFX.RemoveAt(0, NumToPlay, EAllowShrinking::No);
+
+	if (PendingRemovalFX.IsEmpty())
+	{
+		SetActorTickEnabled(false);
+	}
 }
 
 // Spawns a vehicle at a specific transform. Optionally possesses it with PlayerController 0.
 // Returns the vehicle's FGuid (gameplay identifier) or an invalid FGuid on failure.
 FGuid AVehicleManager::SpawnVehicleAtTransform(const FTransform& SpawnTransform, const bool bPossess)
 {
-	if (!CurrentWorld.IsValid()) return FGuid();
-	if (!IsValid(SWPVehicleClass)) return FGuid();
-
-	FActorSpawnParameters SpawnParameters;
-	// Try to place, but never fail to spawn (useful for dense grids).
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-	ASWPVehicle* NewVehicle = CurrentWorld->SpawnActor<ASWPVehicle>(SWPVehicleClass, SpawnTransform, SpawnParameters);
+	ASWPVehicle* NewVehicle = SpawnVehicleInternal(SpawnTransform);
 	if (!NewVehicle) return FGuid();
 
-	// Register bookkeeping with FGuid (the vehicle owns/knows its own GUID).
 	const FGuid NewVehicleGuid = NewVehicle->GetGuid();
-	SpawnedVehicles.Add(NewVehicleGuid, NewVehicle);
 	OnVehicleSpawned.Broadcast(NewVehicleGuid);
 
 	// Optional immediate possession.
@@ -67,9 +88,6 @@ FGuid AVehicleManager::SpawnVehicleAtTransform(const FTransform& SpawnTransform,
 			PC->Possess(NewVehicle);
 		}
 	}	
-
-	// Keep the map coherent even if someone calls Destroy() externally.
-	NewVehicle->OnDestroyed.AddUniqueDynamic(this, &AVehicleManager::OnVehicleDestroyed);
 	
 	return NewVehicleGuid;
 }
@@ -86,23 +104,102 @@ FGuid AVehicleManager::SpawnVehicle(const bool bPossess)
 	return SpawnVehicleAtTransform(SpawnSpot, bPossess);
 }
 
-// Removes a vehicle by its GUID. This triggers the normal Actor destruction path,
-// which will in turn fire OnDestroyed and clean bookkeeping + FX.
+// Bulk spawn: Transforms[i] is used when present, otherwise the next grid slot.
+// Listeners get a single OnVehiclesSpawned with every new GUID (no per-vehicle broadcast).
+TArray<FGuid> AVehicleManager::SpawnVehicles(const int32 Count, const TArray<FTransform>& Transforms)
+{
+	TArray<FGuid> NewVehicleGuids;
+	if (Count <= 0) return NewVehicleGuids;
+
+	NewVehicleGuids.Reserve(Count);
+	SpawnedVehicles.Reserve(SpawnedVehicles.Num() + Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FTransform SpawnTransform = Transforms.IsValidIndex(i)
+			? Transforms[i]
+			: GetNewSpawnLocation(SpawnIndex++, SpawnNumMaxRows, SpawnForwardSpacing, SpawnRightSpacing, SpawnStartingAt);
+
+		if (const ASWPVehicle* NewVehicle = SpawnVehicleInternal(SpawnTransform))
+		{
+			NewVehicleGuids.Add(NewVehicle->GetGuid());
+		}
+	}
+
+	if (NewVehicleGuids.Num() > 0)
+	{
+		OnVehiclesSpawned.Broadcast(NewVehicleGuids);
+	}
+
+	return NewVehicleGuids;
+}
+
+// Removes a vehicle by its GUID. The actor is not destroyed: bookkeeping + FX run here
+// and the vehicle goes back to the pool (parked) for later reuse.
 void AVehicleManager::RemoveVehicleById(const FGuid VehicleId)
+{
+	if (RemoveVehicleInternal(VehicleId))
+	{
+		OnVehicleRemoved.Broadcast(VehicleId);
+	}
+}
+
+// Bulk removal: one OnVehiclesRemoved for the whole batch; FX are merged/budgeted by the queue.
+void AVehicleManager::RemoveVehicles(const TArray<FGuid>& VehicleIds)
+{
+	TArray<FGuid> RemovedVehicleGuids;
+	RemovedVehicleGuids.Reserve(VehicleIds.Num());
+
+	for (const FGuid& VehicleId : VehicleIds)
+	{
+		if (RemoveVehicleInternal(VehicleId))
+		{
+			RemovedVehicleGuids.Add(VehicleId);
+		}
+	}
+
+	if (RemovedVehicleGuids.Num() > 0)
+	{
+		OnVehiclesRemoved.Broadcast(RemovedVehicleGuids);
+	}
+}
+
+// Acquires a vehicle and registers it in the GUID map (no broadcast).
+ASWPVehicle* AVehicleManager::SpawnVehicleInternal(const FTransform& SpawnTransform)
+{
+	if (!CurrentWorld.IsValid()) return nullptr;
+	if (!IsValid(SWPVehicleClass)) return nullptr;
+
+	// Reuse a parked vehicle when possible (no actor/component/body construction).
+	ASWPVehicle* NewVehicle = AcquireVehicle(SpawnTransform);
+	if (!NewVehicle) return nullptr;
+
+	// Register bookkeeping with FGuid (the vehicle owns/knows its own GUID, fresh for every pooled life).
+	SpawnedVehicles.Add(NewVehicle->GetGuid(), NewVehicle);
+
+	return NewVehicle;
+}
+
+// Unpossesses, unregisters, queues FX and parks the vehicle (no broadcast).
+bool AVehicleManager::RemoveVehicleInternal(const FGuid VehicleId)
 {
 	const TWeakObjectPtr<ASWPVehicle>* VehiclePtr = SpawnedVehicles.Find(VehicleId);
-	if (!VehiclePtr) return;
+	if (!VehiclePtr) return false;
 
 	ASWPVehicle* Vehicle = VehiclePtr->Get();
-	if (!Vehicle) return;
+	if (!Vehicle) return false;
 
 	// Cleanly release player control if any.
 	if (AController* Controller = Vehicle->GetController())
 	{
 		Controller->UnPossess();
 	}
-	
-	Vehicle->Destroy();
+
+	SpawnedVehicles.Remove(VehicleId);
+
+	QueueRemovalFX(Vehicle->GetActorLocation());
+	ReleaseVehicle(Vehicle);
+	return true;
 }
 
 // Computes a grid-based spawn transform.
@@ -142,43 +239,122 @@ void AVehicleManager::PrimeNiagaraPool(UNiagaraSystem* System, const int32 Count
 	}
 }
 
-// Called when a spawned vehicle gets destroyed (either via RemoveVehicleById or externally).
-// Keeps the GUID map in sync and plays an optional "death" Niagara FX aligned to the ground.
+// Pre-creates parked vehicles so the first spawns of the session are allocation-free.
+void AVehicleManager::PrimeVehiclePool(const int32 Count)
+{
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (ASWPVehicle* Vehicle = CreateVehicle(FTransform(VehiclePoolParkLocation)))
+		{
+			ReleaseVehicle(Vehicle);
+		}
+	}
+}
+
+// Spawns a brand new vehicle actor (pool miss or pre-warm).
+ASWPVehicle* AVehicleManager::CreateVehicle(const FTransform& SpawnTransform)
+{
+	if (!CurrentWorld.IsValid()) return nullptr;
+	if (!IsValid(SWPVehicleClass)) return nullptr;
+
+	FActorSpawnParameters SpawnParameters;
+	// Try to place, but never fail to spawn (useful for dense grids).
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	ASWPVehicle* NewVehicle = CurrentWorld->SpawnActor<ASWPVehicle>(SWPVehicleClass, SpawnTransform, SpawnParameters);
+	if (!NewVehicle) return nullptr;
+
+	// Keep the map/pool coherent even if someone calls Destroy() externally.
+	NewVehicle->OnDestroyed.AddUniqueDynamic(this, &AVehicleManager::OnVehicleDestroyed);
+
+	return NewVehicle;
+}
+
+// Pops a parked vehicle and un-parks it at SpawnTransform; grows the pool on a miss.
+ASWPVehicle* AVehicleManager::AcquireVehicle(const FTransform& SpawnTransform)
+{
+	while (VehiclePool.Num() > 0)
+	{
+		ASWPVehicle* Vehicle = VehiclePool.Pop();
+		if (!IsValid(Vehicle)) continue;
+
+		Vehicle->ActivateFromPool(SpawnTransform);
+		return Vehicle;
+	}
+
+	return CreateVehicle(SpawnTransform);
+}
+
+// Parks a vehicle and returns it to the free list.
+void AVehicleManager::ReleaseVehicle(ASWPVehicle* Vehicle)
+{
+	if (!IsValid(Vehicle)) return;
+
+	Vehicle->DeactivateToPool(VehiclePoolParkLocation);
+	VehiclePool.Add(Vehicle);
+}
+
+// Queues a removal FX. Removals landing in an already queued cell are merged into it,
+// so a mass despawn produces one FX per area rather than one per vehicle.
+void AVehicleManager::QueueRemovalFX(const FVector& Location)
+{
+	if (!VehicleDeathFX || !VehicleDeathFX->IsValid()) return;
+
+	const float CellSize = FMath::Max(RemovalFXMergeCellSize, 1.0f);
+	const FIntVector Cell(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), 0);
+
+	bool bAlreadyQueued = false;
+	PendingRemovalFXCells.Add(Cell, &bAlreadyQueued);
+	if (bAlreadyQueued) return;
+
+	PendingRemovalFX.Emplace(Cell, Location);
+	SetActorTickEnabled(true);
+}
+
+// Plays the "death" Niagara FX aligned to the ground under Location.
+void AVehicleManager::PlayRemovalFX(const FVector& Location) const
+{
+	if (!CurrentWorld.IsValid()) return;
+
+	// Spawn the VFX at the impact/ground location with the normal-aligned rotation.
+	FVector  Loc = Location;
+	FRotator Rot = FRotator::ZeroRotator;
+
+	FHitResult Hit;
+	const FVector Start = Loc + FVector(0,0,50.0f);
+	const FVector End   = Loc - FVector(0,0,2000.0f);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(DeathFXTrace), false);
+	if (CurrentWorld->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params))
+	{
+		Loc = Hit.Location;
+		Rot = FRotationMatrix::MakeFromZ(Hit.Normal).Rotator();
+	}
+
+	UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+		CurrentWorld.Get(),
+		VehicleDeathFX,
+		Loc,
+		Rot,
+		ScaleFactorFX,
+		false,
+		true, ENCPoolMethod::AutoRelease	// fire-and-forget; Niagara pool manages lifetime.
+	);
+}
+
+// Called when a vehicle actor gets destroyed externally (active or parked).
+// Keeps the GUID map and the pool in sync; FX only for vehicles that were in play.
 void AVehicleManager::OnVehicleDestroyed(AActor* DestroyedActor)
 {
 	if (!DestroyedActor) return;
 
-	const ASWPVehicle* Vehicle = Cast<ASWPVehicle>(DestroyedActor);
+	ASWPVehicle* Vehicle = Cast<ASWPVehicle>(DestroyedActor);
 	if (!Vehicle) return;
 
-	// Notify listeners and drop weak reference from the map.
-	OnVehicleRemoved.Broadcast(Vehicle->GetGuid());
-	SpawnedVehicles.Remove(Vehicle->GetGuid());
+	VehiclePool.RemoveSwap(Vehicle);
 
-	// Optionally spawn a VFX at the impact/ground location with the normal-aligned rotation.
-	if (VehicleDeathFX->IsValid() && CurrentWorld.IsValid())
+	if (SpawnedVehicles.Remove(Vehicle->GetGuid()) > 0)
 	{
-		FVector  Loc = Vehicle->GetActorLocation();
-		FRotator Rot = Vehicle->GetActorRotation();
-
-		FHitResult Hit;
-		const FVector Start = Loc + FVector(0,0,50.0f);
-		const FVector End   = Loc - FVector(0,0,2000.0f);
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(DeathFXTrace), false, const_cast<ASWPVehicle*>(Vehicle));
-		if (CurrentWorld->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params))
-		{
-			Loc = Hit.Location;
-			Rot = FRotationMatrix::MakeFromZ(Hit.Normal).Rotator();
-		}
-
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-			CurrentWorld.Get(),
-			VehicleDeathFX,
-			Loc,
-			Rot,
-			ScaleFactorFX,
-			false,
-			true, ENCPoolMethod::AutoRelease	// fire-and-forget; Niagara pool manages lifetime.
-		);
+		OnVehicleRemoved.Broadcast(Vehicle->GetGuid());
+		QueueRemovalFX(Vehicle->GetActorLocation());
 	}
 }
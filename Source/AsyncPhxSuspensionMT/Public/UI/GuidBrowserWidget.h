@@ -38,6 +38,10 @@ private:
 	void HandleVehicleSpawned(const FGuid VehicleId);
 	UFUNCTION()
 	void HandleVehicleRemoved(const FGuid VehicleId);
+	UFUNCTION()
+	void HandleVehiclesSpawned(const TArray<FGuid>& VehicleIds);
+	UFUNCTION()
+	void HandleVehiclesRemoved(const TArray<FGuid>& VehicleIds);
 
 	void HandleEntryGenerated(UUserWidget& EntryWidget);
 	void HandleEntryReleased(UUserWidget& EntryWidget);
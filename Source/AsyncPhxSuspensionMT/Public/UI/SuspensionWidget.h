@@ -5,9 +5,10 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/Slider.h"
+#include "SWPWheelDefinition.h"
 #include "SuspensionWidget.generated.h"
 
-class USWPSuspension;
+class ASWPVehicle;
 class USlider;
 class UTextBlock;
 
@@ -61,7 +62,7 @@ public:
 	
 public:
 	void SetWidgetName(FText Label);
-	void ReconfigureWidget(USWPSuspension* NewSuspension);
+	void ReconfigureWidget(ASWPVehicle* NewVehicle, int32 NewWheelIndex);
 	
 protected:
 	/** Suspension name label (e.g., "Front Left"). */
@@ -104,29 +105,45 @@ protected:
 	virtual void NativeDestruct() override;
 	
 private:
-	/** The suspension component bound to this widget (weak ref to avoid lifetime issues). */
+	/** The vehicle bound to this widget (weak ref to avoid lifetime issues). */
 	UPROPERTY()
-	TWeakObjectPtr<USWPSuspension> Suspension;
+	TWeakObjectPtr<ASWPVehicle> Vehicle;
+	/** Index of the edited entry in the vehicle's wheel definitions. */
+	int32 WheelIndex = INDEX_NONE;
 
 	bool bUpdatingFromCode = false;
+	// A slider is being dragged: edits stay local until it is released.
+	bool bDragging = false;
+	// Local edits not pushed to the physics side yet.
+	bool bPendingCommit = false;
 	
 private:
 	void InitSlider(USlider* Slider, float Min, float Max, float Step, float StartValue);
 	
 	void UpdateText(UTextBlock* Text, float Value, int32 Decimals = 0) const;
+
+	FSWPWheelDefinition* GetWheel() const;
+	// Pushes the edited wheel to the physics side (re-samples the vehicle's PT config, interning its tuning).
+	void CommitWheelEdit();
 	
 	template<typename MemberPtr>
-	void ApplySliderChange(TWeakObjectPtr<USWPSuspension> S,
-						   MemberPtr Field,
+	void ApplySliderChange(MemberPtr Field,
 						   USlider* Slider, UTextBlock* Text,
 						   float NewValue, float Min, float Max, float Step, int32 Decimals = 0)
 	{
-		if (!S.IsValid() || !Slider || !Text) return;
+		FSWPWheelDefinition* Wheel = GetWheel();
+		if (!Wheel || !Slider || !Text) return;
 
 		const float Clamped = FMath::Clamp(NewValue, Min, Max);
 		const float Snapped = (Step > 0.f) ? FMath::RoundToFloat(Clamped / Step) * Step : Clamped;
 
-		S.Get()->*Field = Snapped;
+		// Copy-on-write: the shared preset is never modified, this wheel gets its own values.
+		// While dragging only the wheel changes; the PT sees the value the slider is released at.
+		Wheel->DetachPreset();
+		Wheel->*Field = Snapped;
+		bPendingCommit = true;
+		if (!bDragging)
+			CommitWheelEdit();
 
 		if (!FMath::IsNearlyEqual(Slider->GetValue(), Snapped))
 			Slider->SetValue(Snapped);
@@ -134,6 +151,12 @@ private:
 		UpdateText(Text, Snapped, Decimals);
 	}
 
+	// --- Drag begin/end (shared by every slider) ---
+	UFUNCTION()
+	void OnSliderCaptureBegin();
+	UFUNCTION()
+	void OnSliderCaptureEnd();
+
 	// --- Individual slider callbacks ---
 	UFUNCTION()
 	void OnTravelValueChanged(float NewValue);
@@ -9,7 +9,6 @@
 class AVehicleManager;
 class USuspensionWidget;
 class ASWPVehicle;
-class USWPSuspension;
 class AAsyncPhxSuspensionPlayerController;
 class UTextBlock;
 class USlider;
@@ -31,7 +30,7 @@ public:
 	void SetPlayerController(AAsyncPhxSuspensionPlayerController* InPC);
 
 protected:
-	/** Uniform grid container that holds the four child suspension widgets. */
+	/** Uniform grid container that holds one child suspension widget per wheel (two per row). */
 	UPROPERTY(meta = (BindWidget))
 	class UUniformGridPanel* Grid;
 	
@@ -50,20 +49,18 @@ private:
 	UPROPERTY()
 	FGuid SelectedVehicleId;
 	
+	/** One widget per wheel of the selected vehicle (rebuilt only when the wheel count changes). */
 	UPROPERTY()
-	TObjectPtr<USuspensionWidget> FrontLeftSuspensionWidget = nullptr;
-	UPROPERTY()
-	TObjectPtr<USuspensionWidget> FrontRightSuspensionWidget = nullptr;
-	UPROPERTY()
-	TObjectPtr<USuspensionWidget> RearLeftSuspensionWidget = nullptr;
-	UPROPERTY()
-	TObjectPtr<USuspensionWidget> RearRightSuspensionWidget = nullptr;
+	TArray<TObjectPtr<USuspensionWidget>> SuspensionWidgets;
 	
 private:
 	USuspensionWidget* AddWidget(const FText& Label, int32 Row, int32 Col);
+	void RebuildSuspensionWidgets(int32 NumWheels);
 	
 	UFUNCTION()
 	void HandleSelectedVehicle(ASWPVehicle* NewVehicle);
 	UFUNCTION()
 	void HandleVehicleRemoved(const FGuid VehicleId);
+	UFUNCTION()
+	void HandleVehiclesRemoved(const TArray<FGuid>& VehicleIds);
 };
@@ -8,6 +8,7 @@
 
 class UNiagaraSystem;
 class ASWPVehicle;
+class USWPSurfaceTable;
 
 /**
  * AVehicleManager
@@ -20,6 +21,14 @@ class ASWPVehicle;
  * - All methods here are GT-only (spawn, possession, delegates, Niagara). Do not call from PT.
  * - Vehicles are tracked via TWeakObjectPtr to avoid keeping destroyed actors alive.
  * - Destruction path: we listen to ASWPVehicle::OnDestroyed to keep the map in sync and to play FX.
+ * - Pooling: vehicles are recycled instead of spawned/destroyed. RemoveVehicleById() parks the
+ *   vehicle (physics/collision off, hidden, PT step skipped) and SpawnVehicle*() reuses a parked
+ *   one under a fresh FGuid (a removed ID never comes back), resetting its PT state in place.
+ *   The pool is pre-warmed at BeginPlay.
+ * - Bulk: SpawnVehicles()/RemoveVehicles() fire a single batched event (OnVehiclesSpawned /
+ *   OnVehiclesRemoved) instead of one per vehicle. The PT admits new vehicles under
+ *   swp.MaxAdmissionsPerStep, and removal FX are merged per area and drained under
+ *   MaxRemovalFXPerFrame, so fleet changes are spread over several frames.
  */
 UCLASS()
 class ASYNCPHXSUSPENSIONMT_API AVehicleManager : public AActor
@@ -29,11 +38,18 @@ class ASYNCPHXSUSPENSIONMT_API AVehicleManager : public AActor
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVehicleSpawned, const FGuid, VehicleId);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVehicleRemoved, const FGuid, VehicleId);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVehiclesSpawned, const TArray<FGuid>&, VehicleIds);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnVehiclesRemoved, const TArray<FGuid>&, VehicleIds);
 
 	UPROPERTY(BlueprintAssignable)
 	FOnVehicleSpawned OnVehicleSpawned;
 	UPROPERTY(BlueprintAssignable)
 	FOnVehicleRemoved OnVehicleRemoved;
+	// Batched counterparts, fired once per SpawnVehicles()/RemoveVehicles() call.
+	UPROPERTY(BlueprintAssignable)
+	FOnVehiclesSpawned OnVehiclesSpawned;
+	UPROPERTY(BlueprintAssignable)
+	FOnVehiclesRemoved OnVehiclesRemoved;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Refs")
 	TSubclassOf<ASWPVehicle> SWPVehicleClass;
@@ -43,6 +59,12 @@ public:
 	UNiagaraSystem* VehicleDeathFX;
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="AsyncPhxSuspensionMT|VFX")
 	FVector ScaleFactorFX;
+	// Removal FX spawned per frame at most; the rest waits in a queue (drained in Tick).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="AsyncPhxSuspensionMT|VFX")
+	int32 MaxRemovalFXPerFrame;
+	// cm. Queued removals falling in the same cell of this size share one FX.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="AsyncPhxSuspensionMT|VFX")
+	float RemovalFXMergeCellSize;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Spawn Config")
 	int32 SpawnNumMaxRows;
@@ -55,6 +77,17 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Spawn Config")
 	FTransform SpawnStartingAt;
 
+	// Vehicles pre-created (parked) at BeginPlay so early spawns never construct actors.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Pool")
+	int32 VehiclePoolPrewarmCount;
+	// Where parked vehicles wait (far from gameplay; collision is disabled anyway).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Pool")
+	FVector VehiclePoolParkLocation;
+
+	// Per-surface suspension multipliers installed on the scene's physics manager at BeginPlay (optional).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AsyncPhxSuspensionMT|Physics")
+	TObjectPtr<USWPSurfaceTable> SurfaceTable;
+
 public:
 	AVehicleManager();
 	virtual void Tick(float DeltaTime) override;
@@ -63,9 +96,14 @@ public:
 	FGuid SpawnVehicleAtTransform(const FTransform& SpawnTransform, const bool bPossess = false);
 	UFUNCTION(BlueprintCallable, Category = "AsyncPhxSuspensionMT")
 	FGuid SpawnVehicle(const bool bPossess = false);
+	// Spawns Count vehicles: Transforms[i] when provided, next grid slot otherwise.
+	UFUNCTION(BlueprintCallable, Category = "AsyncPhxSuspensionMT")
+	TArray<FGuid> SpawnVehicles(const int32 Count, const TArray<FTransform>& Transforms);
 
 	UFUNCTION(BlueprintCallable, Category = "AsyncPhxSuspensionMT")
 	void RemoveVehicleById(const FGuid VehicleId);
+	UFUNCTION(BlueprintCallable, Category = "AsyncPhxSuspensionMT")
+	void RemoveVehicles(const TArray<FGuid>& VehicleIds);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AsyncPhxSuspensionMT")
 	void GetAllVehicleIds(TArray<FGuid>& OutKeys) const
@@ -83,13 +121,32 @@ private:
 	UPROPERTY()
 	TMap<FGuid, TWeakObjectPtr<ASWPVehicle>> SpawnedVehicles;
 
+	// Parked vehicles ready for reuse (free list, LIFO).
+	UPROPERTY()
+	TArray<TObjectPtr<ASWPVehicle>> VehiclePool;
+
 	int32 SpawnIndex;
+
+	// Removal FX waiting for budget (one entry per merged cell: cell, location) + the cells still queued.
+	TArray<TPair<FIntVector, FVector>> PendingRemovalFX;
+	TSet<FIntVector> PendingRemovalFXCells;
 	
 private:
 	FTransform GetNewSpawnLocation(int32 Index, int32 NumMaxRows, float ForwardSpacing, float RightSpacing,
 		const FTransform& Origin);
 
 	void PrimeNiagaraPool(UNiagaraSystem* System, const int32 Count) const;
+	void PrimeVehiclePool(const int32 Count);
+
+	ASWPVehicle* CreateVehicle(const FTransform& SpawnTransform);
+	ASWPVehicle* AcquireVehicle(const FTransform& SpawnTransform);
+	void ReleaseVehicle(ASWPVehicle* Vehicle);
+
+	ASWPVehicle* SpawnVehicleInternal(const FTransform& SpawnTransform);
+	bool RemoveVehicleInternal(const FGuid VehicleId);
+
+	void QueueRemovalFX(const FVector& Location);
+	void PlayRemovalFX(const FVector& Location) const;
 	
 	UFUNCTION()
 	void OnVehicleDestroyed(AActor* DestroyedActor);